@@ -31,9 +31,11 @@ echo "Log file: logs/benchmark_direct_${TIMESTAMP1}.log"
 nohup ./build/rocksdb_bench_app \
     --strategy direct_version \
     --total-keys 1000000000 \
+    --derived-keys \
     --batch-size-blocks 10000 \
     --max-batch-size-bytes 322122547200 \
     --clean-data \
+    --result-file logs/result_direct_${TIMESTAMP1}.json \
     > logs/benchmark_direct_${TIMESTAMP1}.log 2>&1
 
 # 检查第一个策略是否成功完成
@@ -61,9 +63,11 @@ echo "Log file: logs/benchmark_dual_${TIMESTAMP2}.log"
 nohup ./build/rocksdb_bench_app \
     --strategy dual_rocksdb_adaptive \
     --total-keys 1000000000 \
+    --derived-keys \
     --batch-size-blocks 10000 \
     --max-batch-size-bytes 322122547200 \
     --clean-data \
+    --result-file logs/result_dual_${TIMESTAMP2}.json \
     > logs/benchmark_dual_${TIMESTAMP2}.log 2>&1
 
 # 检查第二个策略是否成功完成
@@ -85,5 +89,10 @@ echo "Direct log: logs/benchmark_direct_${TIMESTAMP1}.log"
 echo "Dual log: logs/benchmark_dual_${TIMESTAMP2}.log"
 echo "=========================================="
 
+# 以direct为基线对比两个策略的结果（bootstrap置信区间）
+./build/rocksdb_bench_compare \
+    logs/result_direct_${TIMESTAMP1}.json \
+    logs/result_dual_${TIMESTAMP2}.json || true
+
 # 可选：发送完成通知（如果配置了邮件）
 # echo "RocksDB benchmarks completed" | mail -s "Benchmark Complete" your-email@example.com
\ No newline at end of file
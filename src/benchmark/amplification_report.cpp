@@ -0,0 +1,144 @@
+#include "amplification_report.hpp"
+#include "../utils/logger.hpp"
+#include <algorithm>
+
+namespace {
+
+double ratio(uint64_t numerator, uint64_t denominator) {
+    return denominator > 0 ? static_cast<double>(numerator) / denominator : 0.0;
+}
+
+double mb(uint64_t bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+}  // namespace
+
+double AmplificationReport::DBAmplification::write_amplification() const {
+    return ratio(physical_write_bytes(), ingested_bytes);
+}
+
+double AmplificationReport::DBAmplification::space_amplification() const {
+    return ratio(stored_bytes(), ingested_bytes);
+}
+
+AmplificationReport::AmplificationReport(const std::vector<StrategyDBManager::DBRuntimeSample>& current,
+                                         const std::vector<StrategyDBManager::DBRuntimeSample>& read_baseline,
+                                         uint64_t logical_bytes, uint64_t queries)
+    : logical_bytes_(logical_bytes), queries_(queries) {
+    for (const auto& sample : current) {
+        // 策略不使用的DB（例如dual的主DB）既没有写入也没有数据，不进入报告
+        if (sample.bytes_written == 0 && sample.live_sst_bytes == 0 && sample.live_blob_bytes == 0) {
+            continue;
+        }
+        DBAmplification db;
+        db.name = sample.name;
+        db.ingested_bytes = sample.bytes_written;
+        db.wal_bytes = sample.wal_bytes;
+        db.flush_bytes = sample.flush_write_bytes;
+        db.compaction_bytes = sample.compact_write_bytes;
+        db.live_sst_bytes = sample.live_sst_bytes;
+        db.live_blob_bytes = sample.live_blob_bytes;
+        db.estimate_live_data_bytes = sample.estimate_live_data_bytes;
+        db.logical_read_bytes = sample.logical_read_bytes;
+        db.file_read_bytes = sample.file_read_bytes;
+        for (const auto& before : read_baseline) {
+            if (before.name == sample.name) {
+                db.logical_read_bytes -= std::min(db.logical_read_bytes, before.logical_read_bytes);
+                db.file_read_bytes -= std::min(db.file_read_bytes, before.file_read_bytes);
+                break;
+            }
+        }
+        dbs_.push_back(std::move(db));
+    }
+}
+
+double AmplificationReport::write_amplification() const {
+    uint64_t physical = 0;
+    for (const auto& db : dbs_) {
+        physical += db.physical_write_bytes();
+    }
+    return ratio(physical, logical_bytes_);
+}
+
+double AmplificationReport::space_amplification() const {
+    uint64_t stored = 0;
+    for (const auto& db : dbs_) {
+        stored += db.stored_bytes();
+    }
+    return ratio(stored, logical_bytes_);
+}
+
+double AmplificationReport::file_read_bytes_per_query() const {
+    uint64_t bytes = 0;
+    for (const auto& db : dbs_) {
+        bytes += db.file_read_bytes;
+    }
+    return ratio(bytes, queries_);
+}
+
+double AmplificationReport::logical_read_bytes_per_query() const {
+    uint64_t bytes = 0;
+    for (const auto& db : dbs_) {
+        bytes += db.logical_read_bytes;
+    }
+    return ratio(bytes, queries_);
+}
+
+void AmplificationReport::print(const std::string& phase) const {
+    utils::log_info("=== Amplification ({}) ===", phase);
+    utils::log_info("Logical data written: {:.1f} MB, write amp {:.2f}x, space amp {:.2f}x",
+                   mb(logical_bytes_), write_amplification(), space_amplification());
+    for (const auto& db : dbs_) {
+        utils::log_info("  {:<16} ingested {:.1f} MB | WAL {:.1f} MB, flush {:.1f} MB, compaction {:.1f} MB -> write amp {:.2f}x",
+                       db.name, mb(db.ingested_bytes), mb(db.wal_bytes), mb(db.flush_bytes),
+                       mb(db.compaction_bytes), db.write_amplification());
+        utils::log_info("  {:<16} SST {:.1f} MB, blob {:.1f} MB, estimated live data {:.1f} MB -> space amp {:.2f}x",
+                       "", mb(db.live_sst_bytes), mb(db.live_blob_bytes), mb(db.estimate_live_data_bytes),
+                       db.space_amplification());
+        if (queries_ > 0) {
+            utils::log_info("  {:<16} read per query: file {:.1f} KB, returned {:.1f} KB",
+                           "", ratio(db.file_read_bytes, queries_) / 1024.0,
+                           ratio(db.logical_read_bytes, queries_) / 1024.0);
+        }
+    }
+    if (queries_ > 0) {
+        utils::log_info("Read amp: {:.1f} KB read from files per query ({} queries), {:.1f} KB returned",
+                       file_read_bytes_per_query() / 1024.0, queries_, logical_read_bytes_per_query() / 1024.0);
+        if (sampled_io_bytes_per_query_) {
+            utils::log_info("  iostats on sampled queries: {:.1f} KB per query", *sampled_io_bytes_per_query_ / 1024.0);
+        }
+    }
+}
+
+nlohmann::ordered_json AmplificationReport::to_json() const {
+    nlohmann::ordered_json dbs = nlohmann::ordered_json::object();
+    for (const auto& db : dbs_) {
+        dbs[db.name] = {
+            {"ingested_bytes", db.ingested_bytes},
+            {"wal_bytes", db.wal_bytes},
+            {"flush_bytes", db.flush_bytes},
+            {"compaction_bytes", db.compaction_bytes},
+            {"write_amplification", db.write_amplification()},
+            {"live_sst_bytes", db.live_sst_bytes},
+            {"live_blob_bytes", db.live_blob_bytes},
+            {"estimate_live_data_bytes", db.estimate_live_data_bytes},
+            {"space_amplification", db.space_amplification()},
+            {"file_read_bytes", db.file_read_bytes},
+            {"logical_read_bytes", db.logical_read_bytes},
+        };
+    }
+    nlohmann::ordered_json j = {
+        {"logical_bytes", logical_bytes_},
+        {"write_amplification", write_amplification()},
+        {"space_amplification", space_amplification()},
+        {"queries", queries_},
+        {"file_read_bytes_per_query", file_read_bytes_per_query()},
+        {"logical_read_bytes_per_query", logical_read_bytes_per_query()},
+    };
+    if (sampled_io_bytes_per_query_) {
+        j["sampled_io_bytes_per_query"] = *sampled_io_bytes_per_query_;
+    }
+    j["dbs"] = std::move(dbs);
+    return j;
+}
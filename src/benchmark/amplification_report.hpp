@@ -0,0 +1,59 @@
+#pragma once
+#include "../core/strategy_db_manager.hpp"
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+// 写/空间/读放大 - 由各DB的ticker和property计算，dual策略按range_index / data_storage分别给出。
+// 写放大和空间放大使用打开DB以来的累计值；读放大使用相对测试开始快照的增量
+class AmplificationReport {
+public:
+    struct DBAmplification {
+        std::string name;
+        uint64_t ingested_bytes = 0;        // BYTES_WRITTEN：写入该DB的WriteBatch字节
+        uint64_t wal_bytes = 0;
+        uint64_t flush_bytes = 0;
+        uint64_t compaction_bytes = 0;
+        uint64_t live_sst_bytes = 0;
+        uint64_t live_blob_bytes = 0;
+        uint64_t estimate_live_data_bytes = 0;
+        uint64_t logical_read_bytes = 0;    // 区间内
+        uint64_t file_read_bytes = 0;       // 区间内
+
+        uint64_t physical_write_bytes() const { return wal_bytes + flush_bytes + compaction_bytes; }
+        uint64_t stored_bytes() const { return live_sst_bytes + live_blob_bytes; }
+        // (WAL + flush + compaction) / 写入字节
+        double write_amplification() const;
+        // (SST + blob) / 写入字节；历史版本全部保留，写入字节即逻辑数据量
+        double space_amplification() const;
+    };
+
+    // logical_bytes为应用层写入的addr_slot+value字节，是跨DB汇总放大的分母；
+    // read_baseline为空时读取量按累计值计算
+    AmplificationReport(const std::vector<StrategyDBManager::DBRuntimeSample>& current,
+                        const std::vector<StrategyDBManager::DBRuntimeSample>& read_baseline,
+                        uint64_t logical_bytes, uint64_t queries);
+
+    // 采样查询的iostats平均每次查询读取字节（来自QueryPerfReport的采样）
+    void set_sampled_io_bytes_per_query(double bytes) { sampled_io_bytes_per_query_ = bytes; }
+
+    const std::vector<DBAmplification>& dbs() const { return dbs_; }
+    uint64_t logical_bytes() const { return logical_bytes_; }
+    uint64_t queries() const { return queries_; }
+
+    // 所有DB合计，相对应用层逻辑字节
+    double write_amplification() const;
+    double space_amplification() const;
+    double file_read_bytes_per_query() const;
+    double logical_read_bytes_per_query() const;
+
+    void print(const std::string& phase) const;
+    nlohmann::ordered_json to_json() const;
+
+private:
+    std::vector<DBAmplification> dbs_;
+    uint64_t logical_bytes_ = 0;
+    uint64_t queries_ = 0;
+    std::optional<double> sampled_io_bytes_per_query_;
+};
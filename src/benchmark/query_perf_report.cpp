@@ -0,0 +1,134 @@
+#include "query_perf_report.hpp"
+#include "../utils/logger.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// 每次查询（或每次阶段调用）的平均值
+std::string describe(const QueryPerfCounters& c, double n) {
+    if (n <= 0) {
+        return "-";
+    }
+    return fmt::format("block_reads {:.2f} ({:.1f} KB, {:.3f} ms), cache_hits {:.2f}, index/filter reads {:.2f}/{:.2f}, "
+                       "bloom {:.2f} (filtered {:.2f}), memtable {:.2f}, child_seeks {:.2f}, "
+                       "skipped keys {:.2f}, tombstones {:.2f}, io {:.1f} KB / {:.3f} ms",
+                       c.block_reads / n, c.block_read_bytes / n / 1024.0, c.block_read_nanos / n / 1e6,
+                       c.block_cache_hits / n, c.index_block_reads / n, c.filter_block_reads / n,
+                       c.bloom_checks / n, c.bloom_sst_filtered / n, c.memtable_probes / n, c.sst_seeks / n,
+                       c.internal_keys_skipped / n, c.tombstones_skipped / n,
+                       c.io_bytes_read / n / 1024.0, c.io_read_nanos / n / 1e6);
+}
+
+nlohmann::ordered_json per_query_json(const QueryPerfCounters& c, double n) {
+    nlohmann::ordered_json j;
+    if (n <= 0) {
+        return j;
+    }
+    j["block_reads"] = c.block_reads / n;
+    j["block_read_bytes"] = c.block_read_bytes / n;
+    j["block_read_ms"] = c.block_read_nanos / n / 1e6;
+    j["block_cache_hits"] = c.block_cache_hits / n;
+    j["index_block_reads"] = c.index_block_reads / n;
+    j["filter_block_reads"] = c.filter_block_reads / n;
+    j["bloom_checks"] = c.bloom_checks / n;
+    j["bloom_sst_filtered"] = c.bloom_sst_filtered / n;
+    j["memtable_probes"] = c.memtable_probes / n;
+    j["child_seeks"] = c.sst_seeks / n;
+    j["internal_keys_skipped"] = c.internal_keys_skipped / n;
+    j["tombstones_skipped"] = c.tombstones_skipped / n;
+    j["io_bytes_read"] = c.io_bytes_read / n;
+    j["io_read_ms"] = c.io_read_nanos / n / 1e6;
+    return j;
+}
+
+}  // namespace
+
+QueryPerfReport::QueryPerfReport(const LatencyHistogram& latency, const std::vector<query_perf::Sample>& samples)
+    : sample_count_(samples.size()) {
+    const std::pair<const char*, double> cuts[] = {
+        {"<p50", 50.0}, {"p50-p90", 90.0}, {"p90-p99", 99.0}, {"p99-p99.9", 99.9},
+    };
+    uint64_t lower = 0;
+    for (const auto& [label, percentile] : cuts) {
+        Band band;
+        band.label = label;
+        band.lower_ns = lower;
+        band.upper_ns = latency.value_at_percentile(percentile);
+        lower = band.upper_ns;
+        bands_.push_back(std::move(band));
+    }
+    Band tail;
+    tail.label = ">=p99.9";
+    tail.lower_ns = lower;
+    tail.upper_ns = std::numeric_limits<uint64_t>::max();
+    bands_.push_back(std::move(tail));
+
+    for (const auto& sample : samples) {
+        // 落在[lower, upper)的第一个分段；百分位相同的相邻分段取靠前的
+        Band* target = &bands_.back();
+        for (auto& band : bands_) {
+            if (sample.latency_ns < band.upper_ns) {
+                target = &band;
+                break;
+            }
+        }
+        target->samples++;
+        target->total += sample.total;
+        for (const auto& stage : sample.stages) {
+            auto it = std::find_if(target->stages.begin(), target->stages.end(),
+                                   [&stage](const query_perf::StageCounters& s) { return s.name == stage.name; });
+            if (it == target->stages.end()) {
+                target->stages.push_back(stage);
+            } else {
+                it->calls += stage.calls;
+                it->counters += stage.counters;
+            }
+        }
+    }
+}
+
+void QueryPerfReport::print(const std::string& strategy) const {
+    if (sample_count_ == 0) {
+        return;
+    }
+    utils::log_info("=== Query Internal Work by Latency Band ({}, {} sampled queries) ===", strategy, sample_count_);
+    for (const auto& band : bands_) {
+        if (band.samples == 0) {
+            continue;
+        }
+        std::string range = band.upper_ns == std::numeric_limits<uint64_t>::max()
+            ? fmt::format(">= {:.3f} ms", band.lower_ns / 1e6)
+            : fmt::format("{:.3f}-{:.3f} ms", band.lower_ns / 1e6, band.upper_ns / 1e6);
+        utils::log_info("{} [{}] n={}: {}", band.label, range, band.samples,
+                       describe(band.total, static_cast<double>(band.samples)));
+        for (const auto& stage : band.stages) {
+            utils::log_info("    {} ({:.2f} calls/query): {}", stage.name,
+                           static_cast<double>(stage.calls) / band.samples,
+                           describe(stage.counters, static_cast<double>(band.samples)));
+        }
+    }
+}
+
+nlohmann::ordered_json QueryPerfReport::to_json() const {
+    nlohmann::ordered_json bands = nlohmann::ordered_json::array();
+    for (const auto& band : bands_) {
+        nlohmann::ordered_json j;
+        j["band"] = band.label;
+        j["lower_ms"] = band.lower_ns / 1e6;
+        if (band.upper_ns != std::numeric_limits<uint64_t>::max()) {
+            j["upper_ms"] = band.upper_ns / 1e6;
+        }
+        j["samples"] = band.samples;
+        j["per_query"] = per_query_json(band.total, static_cast<double>(band.samples));
+        nlohmann::ordered_json stages = nlohmann::ordered_json::object();
+        for (const auto& stage : band.stages) {
+            auto stage_json = per_query_json(stage.counters, static_cast<double>(band.samples));
+            stage_json["calls"] = band.samples > 0 ? static_cast<double>(stage.calls) / band.samples : 0.0;
+            stages[stage.name] = std::move(stage_json);
+        }
+        j["stages"] = std::move(stages);
+        bands.push_back(std::move(j));
+    }
+    return {{"sampled_queries", sample_count_}, {"bands", std::move(bands)}};
+}
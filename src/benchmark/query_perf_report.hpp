@@ -0,0 +1,32 @@
+#pragma once
+#include "../core/query_perf_context.hpp"
+#include "../utils/latency_histogram.hpp"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+// 采样查询的内部工作量按延迟分段汇总 - 分段边界取自全部查询的延迟直方图
+// （<p50、p50-p90、p90-p99、p99-p99.9、>=p99.9），每段给出平均每次查询的工作量和各阶段分解
+class QueryPerfReport {
+public:
+    struct Band {
+        std::string label;
+        uint64_t lower_ns = 0;
+        uint64_t upper_ns = 0;
+        size_t samples = 0;
+        QueryPerfCounters total;
+        std::vector<query_perf::StageCounters> stages;
+    };
+
+    QueryPerfReport(const LatencyHistogram& latency, const std::vector<query_perf::Sample>& samples);
+
+    const std::vector<Band>& bands() const { return bands_; }
+    size_t sample_count() const { return sample_count_; }
+
+    void print(const std::string& strategy) const;
+    nlohmann::ordered_json to_json() const;
+
+private:
+    std::vector<Band> bands_;
+    size_t sample_count_ = 0;
+};
@@ -0,0 +1,167 @@
+#include "result_comparison.hpp"
+#include "result_document.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+std::vector<double> ResultComparator::bootstrap_percentile(const LatencyHistogram& histogram, double percentile) {
+    std::vector<std::pair<size_t, uint64_t>> buckets;
+    histogram.for_each_bucket([&buckets](size_t index, uint64_t count) {
+        buckets.emplace_back(index, count);
+    });
+
+    std::vector<double> results;
+    uint64_t total = histogram.count();
+    if (total == 0 || buckets.empty()) {
+        return results;
+    }
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+    target = std::clamp<uint64_t>(target, 1, total);
+
+    results.reserve(options_.iterations);
+    for (size_t iter = 0; iter < options_.iterations; ++iter) {
+        // 条件二项分解生成多项式样本：依次为每个桶抽取计数，累计达到目标秩时即得到该百分位
+        uint64_t remaining_draws = total;
+        uint64_t remaining_weight = total;
+        uint64_t seen = 0;
+        double value = histogram.max() / 1e6;
+        for (const auto& [index, count] : buckets) {
+            uint64_t drawn = remaining_draws;
+            if (count < remaining_weight) {
+                std::binomial_distribution<uint64_t> dist(remaining_draws,
+                                                          static_cast<double>(count) / remaining_weight);
+                drawn = dist(rng_);
+            }
+            remaining_draws -= drawn;
+            remaining_weight -= count;
+            seen += drawn;
+            if (seen >= target) {
+                value = std::min(LatencyHistogram::bucket_upper_bound(index), histogram.max()) / 1e6;
+                break;
+            }
+        }
+        results.push_back(value);
+    }
+    return results;
+}
+
+std::vector<double> ResultComparator::bootstrap_mean(const std::vector<double>& samples) {
+    std::vector<double> results;
+    if (samples.empty()) {
+        return results;
+    }
+    std::uniform_int_distribution<size_t> pick(0, samples.size() - 1);
+    results.reserve(options_.iterations);
+    for (size_t iter = 0; iter < options_.iterations; ++iter) {
+        double sum = 0.0;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            sum += samples[pick(rng_)];
+        }
+        results.push_back(sum / samples.size());
+    }
+    return results;
+}
+
+ResultComparator::MetricComparison ResultComparator::compare_samples(
+    const std::string& name, bool higher_is_better, double baseline, double candidate,
+    const std::vector<double>& baseline_samples, const std::vector<double>& candidate_samples) const {
+    MetricComparison result;
+    result.name = name;
+    result.higher_is_better = higher_is_better;
+    result.baseline = baseline;
+    result.candidate = candidate;
+    if (baseline == 0.0) {
+        return result;
+    }
+    result.delta_pct = (candidate - baseline) / baseline * 100.0;
+
+    size_t n = std::min(baseline_samples.size(), candidate_samples.size());
+    if (n == 0) {
+        return result;
+    }
+
+    // 两边独立重采样，逐对求相对变化，取两侧分位数作为置信区间
+    std::vector<double> deltas;
+    deltas.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        deltas.push_back((candidate_samples[i] - baseline_samples[i]) / baseline * 100.0);
+    }
+    std::sort(deltas.begin(), deltas.end());
+    double tail = (1.0 - options_.confidence) / 2.0;
+    auto quantile = [&deltas](double q) {
+        size_t index = static_cast<size_t>(q * (deltas.size() - 1) + 0.5);
+        return deltas[std::min(index, deltas.size() - 1)];
+    };
+    result.has_ci = true;
+    result.ci_low_pct = quantile(tail);
+    result.ci_high_pct = quantile(1.0 - tail);
+    result.significant = result.ci_low_pct > 0.0 || result.ci_high_pct < 0.0;
+
+    bool worse = higher_is_better ? result.delta_pct < 0.0 : result.delta_pct > 0.0;
+    bool large_enough = std::abs(result.delta_pct) >= options_.min_effect_pct;
+    result.regression = result.significant && worse && large_enough;
+    result.improvement = result.significant && !worse && large_enough;
+    return result;
+}
+
+std::vector<ResultComparator::MetricComparison> ResultComparator::compare(const nlohmann::json& baseline,
+                                                                          const nlohmann::json& candidate) {
+    std::vector<MetricComparison> comparisons;
+
+    // 延迟百分位：直方图多项式重采样
+    const std::pair<const char*, double> percentiles[] = {
+        {"p50", 50.0}, {"p90", 90.0}, {"p99", 99.0}, {"p99.9", 99.9}, {"p99.99", 99.99},
+    };
+    for (const char* kind : {"query_latency", "write_latency"}) {
+        LatencyHistogram base_hist;
+        LatencyHistogram cand_hist;
+        if (!baseline.contains("histograms") || !candidate.contains("histograms") ||
+            !result_document::histogram_from_json(baseline["histograms"].value(kind, nlohmann::json()), base_hist) ||
+            !result_document::histogram_from_json(candidate["histograms"].value(kind, nlohmann::json()), cand_hist) ||
+            base_hist.count() == 0 || cand_hist.count() == 0) {
+            continue;
+        }
+        for (const auto& [label, percentile] : percentiles) {
+            auto base_samples = bootstrap_percentile(base_hist, percentile);
+            auto cand_samples = bootstrap_percentile(cand_hist, percentile);
+            comparisons.push_back(compare_samples(std::string(kind) + "_" + label + "_ms", false,
+                                                  base_hist.percentile_ms(percentile),
+                                                  cand_hist.percentile_ms(percentile),
+                                                  base_samples, cand_samples));
+        }
+    }
+
+    // 吞吐：对区间吞吐样本的均值做重采样
+    for (const char* metric : {"query_ops_per_sec", "write_kv_per_sec"}) {
+        auto collect = [metric](const nlohmann::json& doc) {
+            std::vector<double> samples;
+            if (doc.contains("intervals")) {
+                for (const auto& interval : doc["intervals"]) {
+                    samples.push_back(interval.value(metric, 0.0));
+                }
+            }
+            return samples;
+        };
+        auto base_intervals = collect(baseline);
+        auto cand_intervals = collect(candidate);
+        double base_value = baseline.contains("summary") ? baseline["summary"].value(metric, 0.0) : 0.0;
+        double cand_value = candidate.contains("summary") ? candidate["summary"].value(metric, 0.0) : 0.0;
+        auto base_samples = bootstrap_mean(base_intervals);
+        auto cand_samples = bootstrap_mean(cand_intervals);
+        comparisons.push_back(compare_samples(metric, true, base_value, cand_value, base_samples, cand_samples));
+    }
+
+    // CPU效率：只有整次运行的点估计，没有置信区间，不会被判为显著回退
+    for (const char* metric : {"cpu_us_per_query", "cpu_us_per_write_record"}) {
+        if (!baseline.contains("cpu") || !candidate.contains("cpu")) {
+            break;
+        }
+        double base_value = baseline["cpu"].value(metric, 0.0);
+        double cand_value = candidate["cpu"].value(metric, 0.0);
+        if (base_value > 0 && cand_value > 0) {
+            comparisons.push_back(compare_samples(metric, false, base_value, cand_value, {}, {}));
+        }
+    }
+
+    return comparisons;
+}
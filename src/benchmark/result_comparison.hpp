@@ -0,0 +1,51 @@
+#pragma once
+#include "../utils/latency_histogram.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// 两次运行结果的对比 - 对延迟百分位和吞吐做bootstrap，给出相对变化的置信区间并标记显著回退
+class ResultComparator {
+public:
+    struct Options {
+        size_t iterations = 1000;        // bootstrap重采样次数
+        double confidence = 0.95;        // 置信水平
+        double min_effect_pct = 1.0;     // 小于该幅度的变化即使显著也不算回退
+        uint64_t seed = 42;
+    };
+
+    struct MetricComparison {
+        std::string name;
+        bool higher_is_better = false;
+        double baseline = 0.0;
+        double candidate = 0.0;
+        double delta_pct = 0.0;          // (candidate - baseline) / baseline
+        bool has_ci = false;             // 缺少原始样本（例如未开启采样）时只比较点估计
+        double ci_low_pct = 0.0;
+        double ci_high_pct = 0.0;
+        bool significant = false;        // 置信区间不包含0
+        bool regression = false;         // 显著且朝变差方向，并超过min_effect_pct
+        bool improvement = false;
+    };
+
+    explicit ResultComparator(const Options& options) : options_(options), rng_(options.seed) {}
+
+    std::vector<MetricComparison> compare(const nlohmann::json& baseline, const nlohmann::json& candidate);
+
+    // 从直方图代表的分布中多项式重采样（样本量与原直方图相同），返回每次重采样的百分位（毫秒）
+    std::vector<double> bootstrap_percentile(const LatencyHistogram& histogram, double percentile);
+
+    // 对一组区间吞吐做重采样，返回每次重采样的均值
+    std::vector<double> bootstrap_mean(const std::vector<double>& samples);
+
+private:
+    MetricComparison compare_samples(const std::string& name, bool higher_is_better,
+                                     double baseline, double candidate,
+                                     const std::vector<double>& baseline_samples,
+                                     const std::vector<double>& candidate_samples) const;
+
+    Options options_;
+    std::mt19937_64 rng_;
+};
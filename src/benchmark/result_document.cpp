@@ -0,0 +1,127 @@
+#include "result_document.hpp"
+#include "../core/config.hpp"
+#include "../utils/logger.hpp"
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+namespace result_document {
+
+nlohmann::ordered_json histogram_to_json(const LatencyHistogram& histogram) {
+    nlohmann::ordered_json j;
+    j["unit"] = "ns";
+    j["sub_bucket_bits"] = LatencyHistogram::kSubBucketBits;
+    j["count"] = histogram.count();
+    j["sum"] = histogram.sum();
+    j["min"] = histogram.min();
+    j["max"] = histogram.max();
+    auto buckets = nlohmann::ordered_json::array();
+    histogram.for_each_bucket([&buckets](size_t index, uint64_t count) {
+        buckets.push_back({index, count});
+    });
+    j["buckets"] = std::move(buckets);
+    return j;
+}
+
+bool histogram_from_json(const nlohmann::json& j, LatencyHistogram& histogram) {
+    histogram.reset();
+    if (!j.is_object() || j.value("sub_bucket_bits", -1) != LatencyHistogram::kSubBucketBits) {
+        return false;
+    }
+    for (const auto& bucket : j.at("buckets")) {
+        histogram.add_to_bucket(bucket.at(0).get<size_t>(), bucket.at(1).get<uint64_t>());
+    }
+    histogram.restore_summary(j.value("sum", uint64_t{0}), j.value("min", uint64_t{0}), j.value("max", uint64_t{0}));
+    return true;
+}
+
+nlohmann::ordered_json build_info_json() {
+    BuildInfo info = get_build_info();
+    nlohmann::ordered_json j;
+    j["version"] = info.version;
+    j["git_commit"] = info.git_commit;
+    j["git_branch"] = info.git_branch;
+    j["git_date"] = info.git_date;
+    j["build_time"] = info.build_time;
+    return j;
+}
+
+nlohmann::ordered_json hardware_info_json() {
+    nlohmann::ordered_json j;
+    j["cpu_cores"] = std::thread::hardware_concurrency();
+
+    // Linux下从/proc读取CPU型号和内存大小，读取失败时字段留空
+    std::string cpu_model;
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    for (std::string line; std::getline(cpuinfo, line);) {
+        if (line.rfind("model name", 0) == 0) {
+            auto colon = line.find(':');
+            if (colon != std::string::npos) {
+                cpu_model = line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+            break;
+        }
+    }
+    j["cpu_model"] = cpu_model;
+
+    uint64_t memory_kb = 0;
+    std::ifstream meminfo("/proc/meminfo");
+    for (std::string key; meminfo >> key;) {
+        if (key == "MemTotal:") {
+            meminfo >> memory_kb;
+            break;
+        }
+        meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    j["memory_bytes"] = memory_kb * 1024;
+
+    struct utsname uts;
+    if (uname(&uts) == 0) {
+        j["kernel"] = std::string(uts.sysname) + " " + uts.release;
+        j["machine"] = uts.machine;
+    }
+    char hostname[256] = {0};
+    if (gethostname(hostname, sizeof(hostname) - 1) == 0) {
+        j["hostname"] = hostname;
+    }
+    return j;
+}
+
+bool write_file(const std::string& path, const nlohmann::ordered_json& document) {
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        utils::log_error("Failed to open result file {}", path);
+        return false;
+    }
+    out << document.dump(2) << '\n';
+    return out.good();
+}
+
+bool read_file(const std::string& path, nlohmann::json& document, std::string& error) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+    try {
+        document = nlohmann::json::parse(in);
+    } catch (const nlohmann::json::exception& e) {
+        error = path + ": " + e.what();
+        return false;
+    }
+    if (document.value("schema_version", 0) != kSchemaVersion) {
+        error = path + ": unsupported schema_version";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace result_document
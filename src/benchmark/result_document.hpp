@@ -0,0 +1,22 @@
+#pragma once
+#include "../utils/latency_histogram.hpp"
+#include <nlohmann/json.hpp>
+#include <string>
+
+// 结果文件（JSON）的序列化辅助函数 - 运行结束时由StrategyScenarioRunner写出，rocksdb_bench_compare读取
+namespace result_document {
+
+constexpr int kSchemaVersion = 1;
+
+// 直方图只导出非空桶：{"unit":"ns","sub_bucket_bits":7,"count","sum","min","max","buckets":[[index,count],...]}
+nlohmann::ordered_json histogram_to_json(const LatencyHistogram& histogram);
+bool histogram_from_json(const nlohmann::json& j, LatencyHistogram& histogram);
+
+// 构建信息（git提交等）与硬件信息（CPU型号、核心数、内存、内核、主机名）
+nlohmann::ordered_json build_info_json();
+nlohmann::ordered_json hardware_info_json();
+
+bool write_file(const std::string& path, const nlohmann::ordered_json& document);
+bool read_file(const std::string& path, nlohmann::json& document, std::string& error);
+
+}  // namespace result_document
@@ -0,0 +1,352 @@
+#include "scenario.hpp"
+#include "workload_preset.hpp"
+#include "../utils/key_distribution.hpp"
+#include "../utils/version_distribution.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+struct PhaseTypeName {
+    ScenarioPhaseType type;
+    const char* name;
+};
+
+constexpr PhaseTypeName kPhaseTypes[] = {
+    {ScenarioPhaseType::kLoad, "load"},
+    {ScenarioPhaseType::kWarmUp, "warm_up"},
+    {ScenarioPhaseType::kSteady, "steady"},
+    {ScenarioPhaseType::kBurst, "burst"},
+    {ScenarioPhaseType::kCatchUp, "catch_up"},
+    {ScenarioPhaseType::kPrune, "prune"},
+    {ScenarioPhaseType::kReopen, "reopen"},
+};
+
+ScenarioPhaseType parse_phase_type(const std::string& name, const std::string& context) {
+    for (const auto& entry : kPhaseTypes) {
+        if (name == entry.name) {
+            return entry.type;
+        }
+    }
+    throw std::invalid_argument(context + ": unknown phase type '" + name +
+                                "' (expected load, warm_up, steady, burst, catch_up, prune or reopen)");
+}
+
+// 读写阶段可以设置的参数；catch_up的两个参数只用于catch_up阶段
+const std::set<std::string>& read_write_keys() {
+    static const std::set<std::string> keys = {
+        "duration_seconds", "reader_threads", "writer_threads", "block_size", "write_sleep_seconds",
+        "query_rate", "arrival_process", "write_distribution", "read_distribution", "version_distribution",
+        "read_before_write", "sample_interval_seconds", "workload", "write_result",
+        "block_rate", "baseline_seconds",
+    };
+    return keys;
+}
+
+std::string get_string(const nlohmann::json& object, const std::string& key, const std::string& context) {
+    const auto& value = object.at(key);
+    if (!value.is_string()) {
+        throw std::invalid_argument(context + ": '" + key + "' must be a string");
+    }
+    return value.get<std::string>();
+}
+
+size_t get_count(const nlohmann::json& object, const std::string& key, const std::string& context) {
+    const auto& value = object.at(key);
+    if (!value.is_number_integer() || value.get<int64_t>() < 0) {
+        throw std::invalid_argument(context + ": '" + key + "' must be a non-negative integer");
+    }
+    return value.get<size_t>();
+}
+
+double get_rate(const nlohmann::json& object, const std::string& key, const std::string& context) {
+    const auto& value = object.at(key);
+    if (!value.is_number() || value.get<double>() < 0) {
+        throw std::invalid_argument(context + ": '" + key + "' must be a non-negative number");
+    }
+    return value.get<double>();
+}
+
+bool get_bool(const nlohmann::json& object, const std::string& key, const std::string& context) {
+    const auto& value = object.at(key);
+    if (!value.is_boolean()) {
+        throw std::invalid_argument(context + ": '" + key + "' must be true or false");
+    }
+    return value.get<bool>();
+}
+
+std::string key_distribution(const nlohmann::json& object, const std::string& key, const std::string& context) {
+    std::string name = get_string(object, key, context);
+    if (!is_key_distribution_name(name)) {
+        throw std::invalid_argument(context + ": unknown " + key + " '" + name + "'");
+    }
+    return name;
+}
+
+// 阶段名出现在结果文件名中，只允许字母、数字、'-'、'_'和'.'
+bool is_valid_phase_name(const std::string& name) {
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.';
+    });
+}
+
+ScenarioPhase parse_phase(const nlohmann::json& entry, const nlohmann::json& defaults, size_t index) {
+    std::string context = "Scenario phase " + std::to_string(index + 1);
+    if (!entry.is_object() || !entry.contains("type")) {
+        throw std::invalid_argument(context + ": expected an object with a \"type\"");
+    }
+
+    ScenarioPhase phase;
+    phase.type = parse_phase_type(get_string(entry, "type", context), context);
+    context += " (" + std::string(scenario_phase_type_name(phase.type)) + ")";
+    if (entry.contains("name")) {
+        phase.name = get_string(entry, "name", context);
+        if (!is_valid_phase_name(phase.name)) {
+            throw std::invalid_argument(context + ": phase names may only contain letters, digits, '-', '_' and '.'");
+        }
+    }
+
+    if (!phase.is_read_write()) {
+        for (const auto& [key, value] : entry.items()) {
+            if (key != "type" && key != "name") {
+                throw std::invalid_argument(context + ": unknown parameter '" + key + "'");
+            }
+        }
+        return phase;
+    }
+
+    // 阶段类型的默认值 < defaults < 工作负载预设 < 阶段自己的参数
+    switch (phase.type) {
+    case ScenarioPhaseType::kWarmUp:
+        phase.duration_seconds = 60;
+        phase.write_result = false;
+        break;
+    case ScenarioPhaseType::kBurst:
+        phase.duration_seconds = 60;
+        phase.reader_threads = 20;
+        phase.write_sleep_seconds = 1;
+        break;
+    default:
+        break;
+    }
+    nlohmann::json fields = defaults;
+    for (const auto& [key, value] : entry.items()) {
+        fields[key] = value;
+    }
+    fields.erase("type");
+    fields.erase("name");
+
+    for (const auto& [key, value] : fields.items()) {
+        if (!read_write_keys().contains(key)) {
+            throw std::invalid_argument(context + ": unknown parameter '" + key + "'");
+        }
+        if ((key == "block_rate" || key == "baseline_seconds") && phase.type != ScenarioPhaseType::kCatchUp &&
+            entry.contains(key)) {
+            throw std::invalid_argument(context + ": '" + key + "' only applies to catch_up phases");
+        }
+    }
+
+    // 预设先展开，阶段内显式给出的参数覆盖预设，defaults中的同名参数不覆盖
+    if (fields.contains("workload")) {
+        for (const char* key : {"block_size", "write_sleep_seconds", "write_distribution", "read_distribution",
+                                "version_distribution", "read_before_write"}) {
+            if (!entry.contains(key)) {
+                fields.erase(key);
+            }
+        }
+        phase.workload = get_string(fields, "workload", context);
+        const WorkloadPreset* preset = find_workload_preset(phase.workload);
+        if (!preset) {
+            throw std::invalid_argument(context + ": unknown workload preset '" + phase.workload + "'");
+        }
+        phase.block_size = preset->block_size;
+        phase.write_sleep_seconds = preset->write_sleep_seconds;
+        phase.write_distribution = preset->write_distribution;
+        phase.read_distribution = preset->read_distribution;
+        phase.version_distribution = preset->version_distribution;
+        phase.read_before_write = preset->read_before_write;
+    }
+
+    if (fields.contains("duration_seconds")) {
+        phase.duration_seconds = get_count(fields, "duration_seconds", context);
+    }
+    if (fields.contains("reader_threads")) {
+        phase.reader_threads = get_count(fields, "reader_threads", context);
+    }
+    if (fields.contains("writer_threads")) {
+        phase.writer_threads = get_count(fields, "writer_threads", context);
+    }
+    if (fields.contains("block_size")) {
+        phase.block_size = get_count(fields, "block_size", context);
+    }
+    if (fields.contains("write_sleep_seconds")) {
+        phase.write_sleep_seconds = get_count(fields, "write_sleep_seconds", context);
+    }
+    if (fields.contains("query_rate")) {
+        phase.query_rate = get_rate(fields, "query_rate", context);
+    }
+    if (fields.contains("arrival_process")) {
+        phase.arrival_process = get_string(fields, "arrival_process", context);
+        if (phase.arrival_process != "fixed" && phase.arrival_process != "poisson") {
+            throw std::invalid_argument(context + ": arrival_process must be fixed or poisson");
+        }
+    }
+    if (fields.contains("write_distribution")) {
+        phase.write_distribution = key_distribution(fields, "write_distribution", context);
+    }
+    if (fields.contains("read_distribution")) {
+        phase.read_distribution = key_distribution(fields, "read_distribution", context);
+    }
+    if (fields.contains("version_distribution")) {
+        phase.version_distribution = get_string(fields, "version_distribution", context);
+        try {
+            make_version_distribution(*phase.version_distribution, VersionDistributionParams{});
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument(context + ": " + e.what());
+        }
+    }
+    if (fields.contains("read_before_write")) {
+        phase.read_before_write = get_bool(fields, "read_before_write", context);
+    }
+    if (fields.contains("sample_interval_seconds")) {
+        phase.sample_interval_seconds = get_count(fields, "sample_interval_seconds", context);
+    }
+    if (fields.contains("write_result")) {
+        phase.write_result = get_bool(fields, "write_result", context);
+    }
+    if (phase.type == ScenarioPhaseType::kCatchUp) {
+        if (fields.contains("block_rate")) {
+            phase.catch_up_block_rate = get_rate(fields, "block_rate", context);
+        }
+        if (fields.contains("baseline_seconds")) {
+            phase.catch_up_baseline_seconds = get_count(fields, "baseline_seconds", context);
+        }
+    }
+
+    if (phase.duration_seconds == 0) {
+        throw std::invalid_argument(context + ": duration_seconds must be greater than 0");
+    }
+    if (phase.reader_threads == 0 || phase.writer_threads == 0u || phase.block_size == 0) {
+        throw std::invalid_argument(context + ": reader_threads, writer_threads and block_size must be greater than 0");
+    }
+    return phase;
+}
+
+}  // namespace
+
+const char* scenario_phase_type_name(ScenarioPhaseType type) {
+    for (const auto& entry : kPhaseTypes) {
+        if (entry.type == type) {
+            return entry.name;
+        }
+    }
+    return "unknown";
+}
+
+bool ScenarioPhase::is_read_write() const {
+    return type == ScenarioPhaseType::kWarmUp || type == ScenarioPhaseType::kSteady ||
+           type == ScenarioPhaseType::kBurst || type == ScenarioPhaseType::kCatchUp;
+}
+
+bool Scenario::has_load_phase() const {
+    return !phases.empty() && phases.front().type == ScenarioPhaseType::kLoad;
+}
+
+Scenario parse_scenario(const nlohmann::json& document) {
+    if (!document.is_object()) {
+        throw std::invalid_argument("Scenario must be a JSON object");
+    }
+    const std::string context = "Scenario";
+    for (const auto& [key, value] : document.items()) {
+        if (key != "name" && key != "description" && key != "defaults" && key != "phases") {
+            throw std::invalid_argument(context + ": unknown field '" + key + "'");
+        }
+    }
+
+    Scenario scenario;
+    scenario.name = document.contains("name") ? get_string(document, "name", context) : "scenario";
+    if (document.contains("description")) {
+        scenario.description = get_string(document, "description", context);
+    }
+    nlohmann::json defaults = nlohmann::json::object();
+    if (document.contains("defaults")) {
+        defaults = document.at("defaults");
+        if (!defaults.is_object()) {
+            throw std::invalid_argument(context + ": \"defaults\" must be an object");
+        }
+        for (const auto& [key, value] : defaults.items()) {
+            if (!read_write_keys().contains(key)) {
+                throw std::invalid_argument(context + ": unknown default '" + key + "'");
+            }
+        }
+    }
+    if (!document.contains("phases") || !document.at("phases").is_array() || document.at("phases").empty()) {
+        throw std::invalid_argument(context + ": \"phases\" must be a non-empty array");
+    }
+
+    std::set<std::string> names;
+    for (const auto& entry : document.at("phases")) {
+        ScenarioPhase phase = parse_phase(entry, defaults, scenario.phases.size());
+        if (phase.type == ScenarioPhaseType::kLoad && !scenario.phases.empty()) {
+            throw std::invalid_argument("Scenario phase " + std::to_string(scenario.phases.size() + 1) +
+                                        ": the load phase must be the first phase");
+        }
+        if (phase.name.empty()) {
+            // 未命名时用类型名，重复时依次加"_2"、"_3"
+            std::string base = scenario_phase_type_name(phase.type);
+            phase.name = base;
+            for (size_t n = 2; names.contains(phase.name); ++n) {
+                phase.name = base + "_" + std::to_string(n);
+            }
+        } else if (names.contains(phase.name)) {
+            throw std::invalid_argument("Scenario phase " + std::to_string(scenario.phases.size() + 1) +
+                                        ": duplicate phase name '" + phase.name + "'");
+        }
+        names.insert(phase.name);
+        scenario.phases.push_back(std::move(phase));
+    }
+    return scenario;
+}
+
+Scenario load_scenario(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open scenario file: " + path);
+    }
+    nlohmann::json document;
+    try {
+        document = nlohmann::json::parse(file, nullptr, true, true);   // 允许注释
+    } catch (const nlohmann::json::parse_error& e) {
+        throw std::runtime_error("Cannot parse scenario file " + path + ": " + e.what());
+    }
+    return parse_scenario(document);
+}
+
+nlohmann::ordered_json example_scenario_json() {
+    nlohmann::ordered_json scenario;
+    scenario["name"] = "node-lifecycle";
+    scenario["description"] = "load, warm up, steady state, a read burst, catch-up after downtime, "
+                              "compaction and a restart with cold caches";
+    scenario["defaults"] = {
+        {"reader_threads", 10},
+        {"writer_threads", 1},
+        {"read_distribution", "scrambled_zipfian"},
+        {"version_distribution", "exponential"},
+        {"sample_interval_seconds", 10},
+    };
+    scenario["phases"] = nlohmann::ordered_json::array({
+        {{"type", "load"}},
+        {{"type", "warm_up"}, {"duration_seconds", 60}},
+        {{"type", "steady"}, {"duration_seconds", 600}},
+        {{"type", "burst"}, {"duration_seconds", 60}, {"reader_threads", 40}, {"query_rate", 50000},
+         {"arrival_process", "poisson"}},
+        {{"type", "catch_up"}, {"duration_seconds", 300}, {"block_rate", 0}, {"baseline_seconds", 10}},
+        {{"type", "prune"}},
+        {{"type", "reopen"}},
+        {{"type", "steady"}, {"name", "steady_cold"}, {"duration_seconds", 300}},
+    });
+    return scenario;
+}
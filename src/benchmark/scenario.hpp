@@ -0,0 +1,65 @@
+#pragma once
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+// 场景阶段类型
+enum class ScenarioPhaseType {
+    kLoad,      // initial load（只能作为第一个阶段）
+    kWarmUp,    // 读写负载预热，默认不写结果文件
+    kSteady,    // 稳态读写负载
+    kBurst,     // 突发负载：默认读线程加倍、写入间隔缩短
+    kCatchUp,   // 追块：写线程连续写block（见--catch-up）
+    kPrune,     // 全量手动compaction（策略没有删除旧版本的接口，用compaction的I/O高峰代替）
+    kReopen,    // 关闭并重新打开数据库，之后的阶段从冷缓存开始
+};
+
+const char* scenario_phase_type_name(ScenarioPhaseType type);
+
+// 场景中的一个阶段。读写阶段（warm_up, steady, burst, catch_up）的参数未设置时沿用命令行配置，
+// 其余阶段只有name
+struct ScenarioPhase {
+    ScenarioPhaseType type = ScenarioPhaseType::kSteady;
+    std::string name;                      // 结果文件、时间序列和汇总中的阶段标签，场景内唯一
+
+    size_t duration_seconds = 300;
+    size_t reader_threads = 10;
+    size_t block_size = 10000;
+    size_t write_sleep_seconds = 3;
+    std::optional<size_t> writer_threads;
+    std::optional<double> query_rate;                 // 0=闭环
+    std::optional<std::string> arrival_process;
+    std::optional<std::string> write_distribution;
+    std::optional<std::string> read_distribution;
+    std::optional<std::string> version_distribution;
+    std::optional<bool> read_before_write;
+    std::optional<size_t> sample_interval_seconds;    // 阶段内的指标采样窗口
+    std::string workload;                             // 工作负载预设（W-A … W-F），空=只有历史版本点查
+    double catch_up_block_rate = 0.0;                 // catch_up：目标blocks/s（0=不限速）
+    size_t catch_up_baseline_seconds = 10;            // catch_up：写线程启动前的读延迟基线
+    bool write_result = true;                         // 写出本阶段的JSON结果文件
+
+    bool is_read_write() const;
+};
+
+// 按顺序执行的多阶段场景
+struct Scenario {
+    std::string name;
+    std::string description;
+    std::vector<ScenarioPhase> phases;
+
+    bool has_load_phase() const;
+};
+
+// JSON格式：{"name", "description", "defaults": {...}, "phases": [{"type": "steady", ...}, ...]}。
+// defaults中的参数作用于所有读写阶段，阶段内的同名参数优先。
+// 未知类型/参数、取值非法或load不在第一个阶段时抛出std::invalid_argument
+Scenario parse_scenario(const nlohmann::json& document);
+
+// 文件无法读取或不是合法JSON时抛出std::runtime_error
+Scenario load_scenario(const std::string& path);
+
+// generate_config_example --scenario输出的示例场景
+nlohmann::ordered_json example_scenario_json();
@@ -1,14 +1,44 @@
 #include "strategy_scenario_runner.hpp"
 #include "../utils/logger.hpp"
+#include "../utils/bounded_queue.hpp"
+#include "../utils/block_coalescer.hpp"
+#include "../utils/tsc_clock.hpp"
+#include "../utils/cpu_time.hpp"
+#include "time_series_writer.hpp"
+#include "result_document.hpp"
+#include "workload_trace.hpp"
+#include "../core/db_event_log.hpp"
+#include <iomanip>
+#include <map>
+#include <sstream>
 #include <random>
 #include <algorithm>
 #include <chrono>
 #include <numeric>
 
-using namespace utils;
+namespace {
+
+uint64_t logical_record_bytes(const std::vector<DataRecord>& records) {
+    uint64_t bytes = 0;
+    for (const auto& record : records) {
+        bytes += record.addr_slot.size() + record.value.size();
+    }
+    return bytes;
+}
+
+// result.json -> result_W-A.json；没有扩展名时直接追加
+std::string with_suffix(const std::string& path, const std::string& suffix) {
+    size_t dot = path.rfind('.');
+    size_t slash = path.find_last_of('/');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = path.size();
+    }
+    return path.substr(0, dot) + "_" + suffix + path.substr(dot);
+}
 
-thread_local std::vector<double> StrategyScenarioRunner::thread_query_latencies_;
+}  // namespace
 
+using namespace utils;
 
 StrategyScenarioRunner::StrategyScenarioRunner(std::shared_ptr<StrategyDBManager> db_manager,
                                              std::shared_ptr<MetricsCollector> metrics,
@@ -20,19 +50,35 @@ StrategyScenarioRunner::StrategyScenarioRunner(std::shared_ptr<StrategyDBManager
     data_config.hotspot_count = static_cast<size_t>(config_.total_keys * 0.1);  // 10% hot keys
     data_config.medium_count = static_cast<size_t>(config_.total_keys * 0.2);  // 20% medium keys
     data_config.tail_count = config_.total_keys - data_config.hotspot_count - data_config.medium_count;  // 70% tail keys
+    data_config.derived_keys = config_.derived_keys;
+    data_config.key_seed = config_.key_seed;
+    data_config.contract_keys = config_.contract_keys;
+    data_config.contract_slot_alpha = config_.contract_slot_alpha;
+    data_config.contract_max_slots = config_.contract_max_slots;
+    data_config.values = config_.value_generator_params();
 
     utils::log_info("About to create DataGenerator with {} keys", data_config.total_keys);
 
     data_generator_ = std::make_unique<DataGenerator>(data_config);
+    key_table_bytes_ = data_generator_->key_table_bytes();
 
     utils::log_info("DataGenerator created successfully");
+    if (const auto* contracts = data_generator_->contract_keyspace()) {
+        utils::log_info("Contract keyspace: {} contracts, largest {} slots, {:.1f} slots on average",
+                       contracts->contract_count(), contracts->largest_contract_slots(),
+                       static_cast<double>(contracts->key_count()) / contracts->contract_count());
+    }
 
-    const auto& all_keys = data_generator_->get_all_keys();
     utils::log_info("StrategyScenarioRunner initialized with config:");
-    utils::log_info("  Total Keys: {}", all_keys.size());
+    utils::log_info("  Total Keys: {}{}", data_generator_->key_count(),
+                   data_generator_->derived_keys() ? " (derived from index, no key table)" : "");
     utils::log_info("  Test Duration: {} minutes", config_.continuous_duration_minutes);
     utils::log_info("  Hot/Medium/Tail Keys: {} / {} / {}",
                    data_config.hotspot_count, data_config.medium_count, data_config.tail_count);
+    utils::log_info("  Values: {}, ~{:.1f} bytes on average", data_generator_->value_generator().describe(),
+                   data_generator_->value_generator().estimated_mean_size());
+
+    open_trace_writer();
 
     // Set merge callback for metrics collection (for strategies that support it)
     db_manager_->set_merge_callback([this](size_t merged_values, size_t merged_value_size) {
@@ -53,12 +99,13 @@ StrategyScenarioRunner::StrategyScenarioRunner(
       current_max_block_(max_block) {
 
     utils::log_info("StrategyScenarioRunner initialized with external DataGenerator");
+    key_table_bytes_ = data_generator_->key_table_bytes();
 
-    const auto& all_keys = data_generator_->get_all_keys();
     utils::log_info("StrategyScenarioRunner initialized with config:");
-    utils::log_info("  Total Keys: {}", all_keys.size());
+    utils::log_info("  Total Keys: {}", data_generator_->key_count());
     utils::log_info("  Test Duration: {} minutes", config_.continuous_duration_minutes);
     utils::log_info("  Using external recovered keys for testing");
+    open_trace_writer();
 
     // Set merge callback for metrics collection (for strategies that support it)
     db_manager_->set_merge_callback([this](size_t merged_values, size_t merged_value_size) {
@@ -69,51 +116,198 @@ StrategyScenarioRunner::StrategyScenarioRunner(
 void StrategyScenarioRunner::run_initial_load_phase() {
     utils::log_info("=== Starting Initial Load Phase ===");
 
-    const auto& all_keys = data_generator_->get_all_keys();
     const size_t batch_size = 10000;
-    size_t total_keys = all_keys.size();
-    BlockNum current_block = 0;
+    size_t total_keys = data_generator_->key_count();
+    size_t total_blocks = (total_keys + batch_size - 1) / batch_size;
+
+    // K个生产者线程各自负责一段连续的block，生成到可复用的buffer中；
+    // 当前线程作为唯一消费者按到达顺序调用策略（策略的initial load写入本身是串行的）。
+    // initial load中每个key只出现一次，block到达顺序不影响结果。
+    struct LoadBlock {
+        BlockNum block_num = 0;
+        std::vector<DataRecord> records;
+    };
+
+    InitialLoadPhaseStats stats;
+    stats.producer_threads = resolve_load_thread_count(total_blocks);
+    stats.buffer_count = stats.producer_threads * 2;
+
+    BoundedQueue<std::unique_ptr<LoadBlock>> free_blocks(stats.buffer_count);
+    BoundedQueue<std::unique_ptr<LoadBlock>> ready_blocks(stats.buffer_count);
+    for (size_t i = 0; i < stats.buffer_count; ++i) {
+        auto block = std::make_unique<LoadBlock>();
+        block->records.reserve(batch_size);
+        free_blocks.push(std::move(block));
+    }
 
-    for (size_t i = 0; i < total_keys; i += batch_size) {
-        size_t end_idx = std::min(i + batch_size, total_keys);
-        size_t current_batch_size = end_idx - i;
+    utils::log_info("Initial load: {} keys, {} blocks, {} producer threads, {} block buffers",
+                   total_keys, total_blocks, stats.producer_threads, stats.buffer_count);
+
+    std::atomic<uint64_t> generate_ns{0};
+    std::atomic<uint64_t> producer_wait_ns{0};
+    std::atomic<size_t> remaining_producers{stats.producer_threads};
+
+    auto producer = [&](size_t first_block, size_t last_block) {
+        for (size_t block_idx = first_block; block_idx < last_block; ++block_idx) {
+            auto wait_start = std::chrono::steady_clock::now();
+            auto block = free_blocks.pop();
+            auto generate_start = std::chrono::steady_clock::now();
+            producer_wait_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                generate_start - wait_start).count();
+            if (!block.has_value()) {
+                break;  // 消费者已中止
+            }
+
+            size_t start_idx = block_idx * batch_size;
+            size_t current_batch_size = std::min(batch_size, total_keys - start_idx);
+            auto& records = (*block)->records;
+            (*block)->block_num = block_idx;
+            records.resize(current_batch_size);
+
+            uint64_t value_start = data_generator_->reserve_value_indices(current_batch_size);
+            for (size_t j = 0; j < current_batch_size; ++j) {
+                auto& record = records[j];
+                record.block_num = block_idx;
+                data_generator_->fill_key(start_idx + j, record.addr_slot);
+                data_generator_->fill_unique_random_value(value_start + j, record.value);
+            }
+
+            generate_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - generate_start).count();
+
+            if (!ready_blocks.push(std::move(*block))) {
+                break;
+            }
+        }
 
-        std::vector<DataRecord> records;
-        auto random_values = data_generator_->generate_random_values(current_batch_size);
+        // 最后一个生产者结束时关闭队列，通知消费者
+        if (--remaining_producers == 0) {
+            ready_blocks.close();
+        }
+    };
 
-        records.reserve(current_batch_size);
+    auto phase_start = std::chrono::steady_clock::now();
 
-        for (size_t j = 0; j < current_batch_size; ++j) {
-            size_t key_idx = i + j;
-            DataRecord record{
-                current_block,
-                all_keys[key_idx],
-                random_values[j]
-            };
-            records.push_back(record);
+    std::vector<std::thread> producers;
+    producers.reserve(stats.producer_threads);
+    size_t blocks_per_producer = (total_blocks + stats.producer_threads - 1) / stats.producer_threads;
+    for (size_t t = 0; t < stats.producer_threads; ++t) {
+        size_t first_block = std::min(t * blocks_per_producer, total_blocks);
+        size_t last_block = std::min(first_block + blocks_per_producer, total_blocks);
+        producers.emplace_back(producer, first_block, last_block);
+    }
+
+    size_t progress_interval = std::max<size_t>(1, total_blocks / 100);
+    bool failed = false;
+    BlockNum failed_block = 0;
+
+    while (true) {
+        auto wait_start = std::chrono::steady_clock::now();
+        auto block = ready_blocks.pop();
+        auto call_start = std::chrono::steady_clock::now();
+        stats.consumer_wait_ms += std::chrono::duration<double, std::milli>(call_start - wait_start).count();
+        if (!block.has_value()) {
+            break;
+        }
+
+        bool success = db_manager_->write_initial_load_batch((*block)->records);
+        if (success && trace_writer_ && config_.trace_initial_load) {
+            trace_writer_->record_block(TraceEventType::kInitialLoadBlock, (*block)->block_num, (*block)->records,
+                                        call_start);
         }
+        stats.strategy_call_ms += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - call_start).count();
 
-        bool success = db_manager_->write_initial_load_batch(records);
         if (!success) {
-            utils::log_error("Failed to write batch at block {}", current_block);
-            throw std::runtime_error("Initial load failed");
+            failed = true;
+            failed_block = (*block)->block_num;
+            // 中止生产者：关闭两个队列，阻塞中的push/pop立即返回
+            free_blocks.close();
+            ready_blocks.close();
+            break;
         }
 
-        current_block++;
+        stats.blocks_written++;
+        stats.records_written += (*block)->records.size();
+        logical_bytes_written_ += logical_record_bytes((*block)->records);
+        free_blocks.push(std::move(*block));
 
-        if (i % 20000 == 0) {
+        if (stats.blocks_written % progress_interval == 0) {
             utils::log_info("Initial load progress: {}/{} ({:.1f}%)",
-                           i, total_keys, (i * 100.0 / total_keys));
+                           stats.records_written, total_keys, (stats.records_written * 100.0 / total_keys));
         }
     }
 
+    for (auto& thread : producers) {
+        thread.join();
+    }
+
+    if (failed) {
+        utils::log_error("Failed to write batch at block {}", failed_block);
+        throw std::runtime_error("Initial load failed");
+    }
+
     db_manager_->flush_all_batches();
-    initial_load_end_block_ = current_block;
-    current_max_block_ = current_block - 1;
+
+    stats.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - phase_start).count();
+    stats.generate_ms = generate_ns.load() / 1e6;
+    stats.producer_wait_ms = producer_wait_ns.load() / 1e6;
+    stats.strategy_stats = db_manager_->get_initial_load_stats();
+    initial_load_stats_ = stats;
+
+    initial_load_end_block_ = total_blocks;
+    current_max_block_ = total_blocks - 1;
 
     utils::log_info("=== Initial Load Completed ===");
     utils::log_info("Total blocks written: {}, keys tracked: {}",
                    initial_load_end_block_, total_keys);
+    initial_load_stats_.print_statistics();
+    initial_load_amplification_ = build_amplification_report();
+    initial_load_amplification_->print("after initial load");
+    print_memory_usage("after initial load");
+}
+
+void StrategyScenarioRunner::open_trace_writer() {
+    if (config_.trace_record_file.empty()) {
+        return;
+    }
+    trace_writer_ = std::make_unique<TraceWriter>(config_.trace_record_file);
+    if (!trace_writer_->is_open()) {
+        trace_writer_.reset();
+        return;
+    }
+    utils::log_info("Recording workload trace to {}", config_.trace_record_file);
+}
+
+size_t StrategyScenarioRunner::resolve_load_thread_count(size_t total_blocks) const {
+    size_t thread_count = config_.load_threads;
+    if (thread_count == 0) {
+        // 自动模式：生成只占用部分核心，剩余核心留给RocksDB的flush/compaction
+        unsigned int cpu_cores = std::thread::hardware_concurrency();
+        thread_count = cpu_cores == 0 ? 4 : std::max<size_t>(1, cpu_cores / 4);
+        thread_count = std::min<size_t>(thread_count, 16);
+    }
+    return std::max<size_t>(1, std::min(thread_count, std::max<size_t>(total_blocks, 1)));
+}
+
+void StrategyScenarioRunner::InitialLoadPhaseStats::print_statistics() const {
+    utils::log_info("=== Initial Load Phase Breakdown ===");
+    utils::log_info("Producer threads: {}, block buffers: {}", producer_threads, buffer_count);
+    utils::log_info("Blocks written: {}, records written: {}", blocks_written, records_written);
+    utils::log_info("Wall time: {:.2f} s ({:.0f} records/s)", wall_seconds,
+                   wall_seconds > 0 ? records_written / wall_seconds : 0.0);
+    utils::log_info("Generate: {:.1f} ms across all producers ({:.3f} ms/block)", generate_ms,
+                   blocks_written > 0 ? generate_ms / blocks_written : 0.0);
+    utils::log_info("Producer wait for free buffer: {:.1f} ms", producer_wait_ms);
+    utils::log_info("Consumer wait for generated blocks: {:.1f} ms", consumer_wait_ms);
+    utils::log_info("Strategy calls (encode + backpressure): {:.1f} ms", strategy_call_ms);
+    if (strategy_stats.has_value()) {
+        utils::log_info("  Encode into WriteBatch: {:.1f} ms", strategy_stats->encode_ms);
+        utils::log_info("  Commit backpressure: {:.1f} ms", strategy_stats->backpressure_ms);
+        utils::log_info("  Commit (db->Write): {:.1f} ms over {} batches", strategy_stats->commit_ms,
+                       strategy_stats->batches_committed);
+    }
+    utils::log_info("====================================");
 }
 
 // ===== 新的并发读写测试实现 =====
@@ -125,35 +319,151 @@ void StrategyScenarioRunner::run_concurrent_read_write_test(const ConcurrentTest
     utils::log_info("Reader threads: {} (CPU cores x 2), Continuous queries during test",
                    test_config.reader_thread_count);
     utils::log_info("Test duration: {} seconds", test_config.test_duration_seconds);
-    utils::log_info("Write sleep: {} seconds, Block size: {} kv",
-                   test_config.write_sleep_seconds, test_config.block_size);
-    utils::log_info("=== Lock Design: Write/Read separated + Thread-local storage ===");
+    utils::log_info("Writer threads: {}, Write sleep: {} seconds per writer, Block size: {} kv",
+                   test_config.writer_thread_count, test_config.write_sleep_seconds, test_config.block_size);
+    utils::log_info("=== Lock Design: Write/Read separated + Per-thread latency histograms ===");
+    if (test_config.target_query_rate > 0) {
+        utils::log_info("Query load: open loop, {:.0f} queries/s total, {} arrivals, latency measured from intended start",
+                       test_config.target_query_rate, test_config.poisson_arrivals ? "poisson" : "fixed-interval");
+    } else {
+        utils::log_info("Query load: closed loop");
+    }
+
+    // 在启动读写线程前完成时钟校准，避免第一次计时包含校准耗时
+    utils::log_info("Latency clock: {:.3f} ticks/ns", TscClock::ticks_per_ns());
 
     // 清空之前的统计数据（分离锁操作）
     {
         utils::log_debug("CLEAR_WRITE_LOCK: Acquiring write_perf_mutex_ to clear write stats");
-        std::lock_guard<std::mutex> lock(write_perf_mutex_);
-        write_latencies_.clear();
+        std::lock_guard<InstrumentedMutex> lock(write_perf_mutex_);
+        write_latency_histogram_.reset();
+        block_read_histogram_.reset();
+        block_execution_histogram_.reset();
+        block_read_count_ = 0;
+        block_read_found_count_ = 0;
+        write_range_histogram_.reset();
+        write_data_histogram_.reset();
+        write_overlap_histogram_.reset();
         write_count_ = 0;
+        write_record_count_ = 0;
+        write_input_record_count_ = 0;
+        write_duplicate_count_ = 0;
         utils::log_debug("CLEAR_WRITE_LOCK: Released write_perf_mutex_");
     }
 
     {
         utils::log_debug("CLEAR_QUERY_LOCK: Acquiring query_merge_mutex_ to clear query stats");
-        std::lock_guard<std::mutex> lock(query_merge_mutex_);
-        query_latencies_.clear();
+        std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+        reader_histograms_.clear();
+        reader_service_histograms_.clear();
+        reader_age_histograms_.clear();
+        reader_op_histograms_.clear();
+        reader_baseline_histograms_.clear();
+        for (size_t i = 0; i < test_config.reader_thread_count; ++i) {
+            reader_histograms_.push_back(std::make_unique<LatencyHistogram>());
+            reader_baseline_histograms_.push_back(std::make_unique<LatencyHistogram>());
+            reader_service_histograms_.push_back(std::make_unique<LatencyHistogram>());
+            for (size_t bucket = 0; bucket < kVersionAgeBucketCount; ++bucket) {
+                reader_age_histograms_.push_back(std::make_unique<LatencyHistogram>());
+            }
+            for (size_t op = 0; op < kReadOperationCount; ++op) {
+                reader_op_histograms_.push_back(std::make_unique<LatencyHistogram>());
+            }
+        }
+        for (size_t op = 0; op < kReadOperationCount; ++op) {
+            op_found_count_[op] = 0;
+            op_item_count_[op] = 0;
+        }
         total_successful_queries_ = 0;
+        target_query_rate_ = test_config.target_query_rate;
+        poisson_arrivals_ = test_config.poisson_arrivals;
+        perf_sample_rate_ = test_config.perf_sample_rate;
+        perf_samples_.clear();
+        catch_up_ = test_config.catch_up;
+        writer_block_interval_ = std::chrono::nanoseconds(0);
+        if (catch_up_ && test_config.catch_up_block_rate > 0) {
+            // 目标速率在写线程间平分
+            double writers = static_cast<double>(std::max<size_t>(1, test_config.writer_thread_count));
+            writer_block_interval_ = std::chrono::nanoseconds(
+                static_cast<int64_t>(1e9 * writers / test_config.catch_up_block_rate));
+        }
+        writers_running_ = false;
         utils::log_debug("CLEAR_QUERY_LOCK: Released query_merge_mutex_");
     }
+    read_baseline_ = db_manager_->sample_runtime_metrics();
+    // 锁统计只覆盖本轮测试；此时读写线程尚未启动，没有线程持有被统计的锁
+    LockStatsRegistry::instance().reset();
+    reader_cpu_ns_ = 0;
+    writer_cpu_ns_ = 0;
+    sampler_cpu_ns_ = 0;
+    auto process_cpu_start = utils::read_process_cpu_time();
+    auto cpu_wall_start = std::chrono::steady_clock::now();
+
+    // 所有写线程从initial load之后（或上一轮测试写到的位置之后）的第一个block开始，共享同一个block计数器
+    size_t writer_thread_count = std::max<size_t>(1, test_config.writer_thread_count);
+    {
+        std::lock_guard<InstrumentedMutex> lock(state_mutex_);
+        next_publish_block_ = std::max<BlockNum>(initial_load_end_block_, next_publish_block_);
+        next_write_block_ = next_publish_block_;
+        completed_unpublished_.clear();
+    }
+    write_failed_ = false;
+    test_writer_threads_ = writer_thread_count;
+    test_reader_threads_ = test_config.reader_thread_count;
 
-    // 启动写线程
-    std::thread writer_thread(&StrategyScenarioRunner::writer_thread_function,
-                             this, test_config.test_duration_seconds,
-                             test_config.write_sleep_seconds,
-                             test_config.block_size);
+    {
+        // 合约聚集模式下分布作用于合约，合约内均匀选slot
+        const ContractKeyspace* contracts = data_generator_->contract_keyspace();
+        size_t key_count = contracts ? contracts->contract_count() : data_generator_->key_count();
+        KeyDistributionParams params;
+        params.zipf_theta = config_.zipf_theta;
+        params.hot_count = static_cast<size_t>(key_count * 0.1);      // 与DataGenerator的10%/20%/70%分段一致
+        params.medium_count = static_cast<size_t>(key_count * 0.2);
+        params.hotspot_fraction = config_.hotspot_fraction;
+        params.hotspot_probability = config_.hotspot_probability;
+        params.hotspot_period_seconds = config_.hotspot_period_seconds;
+        write_distribution_ = make_key_distribution(config_.write_distribution, key_count, params);
+        read_distribution_ = make_key_distribution(config_.read_distribution, key_count, params);
+        if (contracts) {
+            write_distribution_ = std::make_unique<ContractKeyDistribution>(std::move(write_distribution_), *contracts);
+            read_distribution_ = std::make_unique<ContractKeyDistribution>(std::move(read_distribution_), *contracts);
+        }
+        utils::log_info("Key distribution: writes {}, reads {}", write_distribution_->name(), read_distribution_->name());
+
+        VersionDistributionParams version_params;
+        version_params.recent_window = config_.version_window;
+        version_params.decay_mean_blocks = config_.version_decay_blocks;
+        version_distribution_ = make_version_distribution(config_.version_distribution, version_params);
+        utils::log_info("Query target version distribution: {}", version_distribution_->name());
+    }
+
+    // 追块模式下读线程先单独运行baseline_seconds，得到没有写入时的查询延迟基线，然后写线程再开始连续写block
+    const size_t baseline_seconds = test_config.catch_up ? test_config.catch_up_baseline_seconds : 0;
+
+    // 延迟时间线从写线程启动前开始，多留2分钟给超时的尾部
+    test_origin_ns_ = DBEventLog::now_ns();
+    query_timeline_.reset(test_origin_ns_, test_config.test_duration_seconds + baseline_seconds + 120);
+    write_timeline_.reset(test_origin_ns_, test_config.test_duration_seconds + baseline_seconds + 120);
+
+    std::vector<std::thread> writer_threads;
+    writer_threads.reserve(writer_thread_count);
+    int64_t writers_start_ns = 0;
+    auto start_writers = [&]() {
+        writers_start_ns = DBEventLog::now_ns();
+        writers_running_ = true;
+        for (size_t i = 0; i < writer_thread_count; ++i) {
+            writer_threads.emplace_back(&StrategyScenarioRunner::writer_thread_function,
+                                        this, static_cast<int>(i), test_config.test_duration_seconds,
+                                        test_config.write_sleep_seconds,
+                                        test_config.block_size);
+        }
+    };
 
-    // 等待一秒让写线程先开始
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    if (baseline_seconds == 0) {
+        // 启动写线程，等待一秒让写线程先开始
+        start_writers();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
 
     // 启动读线程 - 使用CPU核心数*2的数量
     size_t actual_reader_thread_count = test_config.reader_thread_count;
@@ -166,13 +476,43 @@ void StrategyScenarioRunner::run_concurrent_read_write_test(const ConcurrentTest
 
     test_running_ = true;
 
+    // 启动时间序列采样线程
+    std::thread sampler_thread;
+    if (test_config.sample_interval_seconds > 0) {
+        std::string output_path = test_config.timeseries_file;
+        if (output_path.empty()) {
+            auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            std::ostringstream oss;
+            oss << "logs/" << db_manager_->get_strategy_name()
+                << (scenario_phase_.empty() ? std::string() : "_" + scenario_phase_) << "_timeseries_"
+                << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".csv";
+            output_path = oss.str();
+        }
+        {
+            std::lock_guard<std::mutex> lock(sampler_mutex_);
+            sampler_stop_ = false;
+            interval_throughput_.clear();
+        }
+        sampler_thread = std::thread(&StrategyScenarioRunner::sampler_thread_function,
+                                     this, test_config.sample_interval_seconds, output_path);
+    }
+
     for (size_t i = 0; i < actual_reader_thread_count; ++i) {
         reader_threads.emplace_back(&StrategyScenarioRunner::reader_thread_function,
                                    this, static_cast<int>(i),
-                                   std::chrono::seconds(test_config.test_duration_seconds));
+                                   std::chrono::seconds(test_config.test_duration_seconds + baseline_seconds));
     }
 
-    writer_thread.join();
+    if (baseline_seconds > 0) {
+        utils::log_info("Catch-up: readers alone for {} s (latency baseline), then writers start", baseline_seconds);
+        std::this_thread::sleep_for(std::chrono::seconds(baseline_seconds));
+        start_writers();
+    }
+
+    for (auto& thread : writer_threads) {
+        thread.join();
+    }
+    int64_t writers_end_ns = DBEventLog::now_ns();
 
     test_running_ = false;
 
@@ -180,16 +520,152 @@ void StrategyScenarioRunner::run_concurrent_read_write_test(const ConcurrentTest
         thread.join();
     }
 
+    if (sampler_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(sampler_mutex_);
+            sampler_stop_ = true;
+        }
+        sampler_cv_.notify_all();
+        sampler_thread.join();
+    }
+
     auto end_time = std::chrono::steady_clock::now();
     size_t actual_duration = std::chrono::duration_cast<std::chrono::seconds>(
         end_time - start_time).count();
+    auto process_cpu_end = utils::read_process_cpu_time();
 
     utils::log_info("=== Concurrent Read-Write Test Completed ===");
     utils::log_info("Actual test duration: {} seconds", actual_duration);
 
     PerformanceStats stats = get_performance_stats();
     stats.test_duration_seconds = actual_duration;
+    stats.phase = scenario_phase_;
+    {
+        double cpu_wall_seconds = std::chrono::duration<double>(end_time - cpu_wall_start).count();
+        double sampler_seconds = sampler_cpu_ns_.load() / 1e9;
+        stats.reader_cpu_seconds = reader_cpu_ns_.load() / 1e9;
+        stats.writer_cpu_seconds = writer_cpu_ns_.load() / 1e9;
+        stats.process_cpu_seconds = (process_cpu_end.total_ns() - process_cpu_start.total_ns()) / 1e9;
+        stats.background_cpu_seconds = std::max(0.0, stats.process_cpu_seconds - stats.reader_cpu_seconds -
+                                                          stats.writer_cpu_seconds - sampler_seconds);
+        stats.cpu_us_per_query = stats.total_query_ops > 0
+                                     ? stats.reader_cpu_seconds * 1e6 / stats.total_query_ops : 0.0;
+        stats.cpu_us_per_write_record = stats.total_write_records > 0
+                                            ? stats.writer_cpu_seconds * 1e6 / stats.total_write_records : 0.0;
+        stats.background_cpu_share = stats.process_cpu_seconds > 0
+                                         ? stats.background_cpu_seconds / stats.process_cpu_seconds : 0.0;
+        stats.cores_used = cpu_wall_seconds > 0 ? stats.process_cpu_seconds / cpu_wall_seconds : 0.0;
+    }
+    if (test_config.catch_up) {
+        stats.catch_up_target_block_rate = test_config.catch_up_block_rate;
+        fill_catch_up_stats(stats, writers_start_ns, writers_end_ns, static_cast<double>(baseline_seconds));
+    }
     stats.print_statistics();
+
+    build_query_perf_report().print(db_manager_->get_strategy_name());
+    build_amplification_report().print("end of test");
+    if (LockStatsRegistry::enabled()) {
+        LockStatsRegistry::instance().print_report();
+    }
+    print_memory_usage("end of test");
+
+    int64_t end_ns = DBEventLog::now_ns();
+    report_stall_correlation(end_ns);
+    write_event_log(end_ns);
+
+    if (trace_writer_) {
+        trace_writer_->flush();
+        utils::log_info("Workload trace: {} events, {:.1f} MB in {}", trace_writer_->events_written(),
+                       trace_writer_->bytes_written() / 1048576.0, trace_writer_->path());
+    }
+
+    if (test_config.write_result_file) {
+        export_results(test_config, stats);
+    }
+    last_test_stats_ = stats;
+
+    if (stats.write_failed) {
+        throw std::runtime_error("Concurrent read-write test failed: a writer thread could not write its block");
+    }
+}
+
+std::vector<StrategyScenarioRunner::SloSweepPoint> StrategyScenarioRunner::run_slo_sweep() {
+    ConcurrentTestConfig test_config = ConcurrentTestConfig::from_benchmark_config(config_);
+    test_config.test_duration_seconds = config_.sweep_step_seconds;
+    test_config.reader_thread_count = 10;
+    test_config.queries_per_thread = 200;
+    test_config.write_sleep_seconds = 3;
+    test_config.block_size = 10000;
+    test_config.write_result_file = false;
+
+    utils::log_info("=== Starting SLO Sweep: p99 <= {:.3f} ms, {:.0f} q/s x{:.2f} per step, {} s per step ===",
+                   config_.slo_p99_ms, config_.sweep_start_rate, config_.sweep_rate_factor,
+                   config_.sweep_step_seconds);
+
+    std::vector<SloSweepPoint> curve;
+    double rate = config_.sweep_start_rate;
+    for (size_t step = 0; step < config_.sweep_max_steps; ++step) {
+        utils::log_info("--- SLO sweep step {}: offered {:.0f} queries/s ---", step + 1, rate);
+        test_config.target_query_rate = rate;
+        run_concurrent_read_write_test(test_config);
+
+        const PerformanceStats& stats = last_test_stats_;
+        SloSweepPoint point;
+        point.offered_rate = rate;
+        point.achieved_rate = stats.query_ops_per_sec;
+        point.p50_ms = stats.query_p50_ms;
+        point.p99_ms = stats.query_p99_ms;
+        point.p999_ms = stats.query_p999_ms;
+        point.service_p99_ms = stats.service_p99_ms;
+        point.write_kv_per_sec = stats.write_records_per_sec;
+        point.meets_slo = stats.total_query_ops > 0 && stats.query_p99_ms <= config_.slo_p99_ms;
+        curve.push_back(point);
+
+        // p99超过SLO，或者实际吞吐明显低于offered速率（读线程已饱和）时停止
+        if (!point.meets_slo || point.achieved_rate < rate * 0.9) {
+            break;
+        }
+        rate *= config_.sweep_rate_factor;
+    }
+
+    utils::log_info("=== SLO Sweep Result (latency measured from intended start) ===");
+    utils::log_info("{:>12} {:>12} {:>10} {:>10} {:>10} {:>12} {:>12}  {}",
+                   "offered/s", "achieved/s", "p50 ms", "p99 ms", "p99.9 ms", "svc p99 ms", "write kv/s", "SLO");
+    double max_rate_within_slo = 0.0;
+    for (const auto& point : curve) {
+        utils::log_info("{:>12.0f} {:>12.0f} {:>10.3f} {:>10.3f} {:>10.3f} {:>12.3f} {:>12.0f}  {}",
+                       point.offered_rate, point.achieved_rate, point.p50_ms, point.p99_ms, point.p999_ms,
+                       point.service_p99_ms, point.write_kv_per_sec, point.meets_slo ? "ok" : "violated");
+        if (point.meets_slo) {
+            max_rate_within_slo = std::max(max_rate_within_slo, point.achieved_rate);
+        }
+    }
+    utils::log_info("Max query throughput within SLO: {:.0f} queries/s", max_rate_within_slo);
+
+    // 曲线另存一份CSV，便于按策略画latency-vs-throughput图
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::ostringstream oss;
+    oss << "logs/" << db_manager_->get_strategy_name() << "_slo_sweep_"
+        << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".csv";
+    TimeSeriesWriter writer(oss.str());
+    if (writer.is_open()) {
+        for (const auto& point : curve) {
+            writer.append({
+                {"strategy", db_manager_->get_strategy_name()},
+                {"offered_rate", point.offered_rate},
+                {"achieved_rate", point.achieved_rate},
+                {"p50_ms", point.p50_ms},
+                {"p99_ms", point.p99_ms},
+                {"p999_ms", point.p999_ms},
+                {"service_p99_ms", point.service_p99_ms},
+                {"write_kv_per_sec", point.write_kv_per_sec},
+                {"meets_slo", static_cast<uint64_t>(point.meets_slo)},
+            });
+        }
+        utils::log_info("SLO sweep curve written to {}", oss.str());
+    }
+
+    return curve;
 }
 
 void StrategyScenarioRunner::run_continuous_update_query_loop(size_t duration_minutes) {
@@ -207,143 +683,670 @@ void StrategyScenarioRunner::run_continuous_update_query_loop(size_t duration_mi
     run_concurrent_read_write_test(test_config);
 }
 
+void StrategyScenarioRunner::run_workload_suite(const std::vector<std::string>& preset_names) {
+    utils::log_info("=== Starting Workload Suite: {} presets, {} s each ===", preset_names.size(),
+                   config_.workload_seconds);
+
+    // 预设覆盖key/版本分布、写入方式和结果文件名，结束后恢复原配置
+    const BenchmarkConfig base_config = config_;
+    std::vector<PerformanceStats> results;
+    for (const auto& name : preset_names) {
+        const WorkloadPreset* preset = find_workload_preset(name);
+        if (!preset) {
+            utils::log_error("Unknown workload preset {}, skipped", name);
+            continue;
+        }
+        utils::log_info("--- Workload {}: {} ---", preset->name, preset->description);
+        utils::log_info("Blocks of {} kv every {} s{}, keys: writes {} / reads {}, versions: {}, reads: {}",
+                       preset->block_size, preset->write_sleep_seconds,
+                       preset->read_before_write ? " (read-before-write)" : "", preset->write_distribution,
+                       preset->read_distribution, preset->version_distribution, preset->mix.describe());
+
+        config_ = base_config;
+        config_.write_distribution = preset->write_distribution;
+        config_.read_distribution = preset->read_distribution;
+        config_.version_distribution = preset->version_distribution;
+        config_.read_before_write = preset->read_before_write;
+        if (!base_config.result_file.empty()) {
+            config_.result_file = with_suffix(base_config.result_file, preset->name);
+        }
+        workload_preset_ = preset;
+
+        ConcurrentTestConfig test_config = ConcurrentTestConfig::from_benchmark_config(config_);
+        test_config.test_duration_seconds = config_.workload_seconds;
+        test_config.reader_thread_count = 10;
+        test_config.queries_per_thread = 200;
+        test_config.write_sleep_seconds = preset->write_sleep_seconds;
+        test_config.block_size = preset->block_size;
+        run_concurrent_read_write_test(test_config);
+
+        results.push_back(last_test_stats_);
+    }
+    workload_preset_ = nullptr;
+    config_ = base_config;
+
+    utils::log_info("=== Workload Suite Result ({}) ===", db_manager_->get_strategy_name());
+    utils::log_info("{:<6} {:>12} {:>10} {:>10} {:>12} {:>12}  {}",
+                   "preset", "reads/s", "p50 ms", "p99 ms", "write kv/s", "write p99", "p99 by operation");
+    for (const auto& stats : results) {
+        std::string by_operation;
+        for (const auto& row : stats.operation_latency) {
+            by_operation += fmt::format("{}{} {:.3f}", by_operation.empty() ? "" : ", ", row.operation, row.p99_ms);
+        }
+        utils::log_info("{:<6} {:>12.0f} {:>10.3f} {:>10.3f} {:>12.0f} {:>12.3f}  {}", stats.workload,
+                       stats.query_ops_per_sec, stats.query_p50_ms, stats.query_p99_ms,
+                       stats.write_records_per_sec, stats.write_p99_ms, by_operation);
+    }
+
+    // 汇总另存一份CSV，每个预设每种操作一行，便于跨策略/版本对比
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::ostringstream oss;
+    oss << "logs/" << db_manager_->get_strategy_name() << "_workload_suite_"
+        << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".csv";
+    TimeSeriesWriter writer(oss.str());
+    if (writer.is_open()) {
+        for (const auto& stats : results) {
+            for (const auto& row : stats.operation_latency) {
+                writer.append({
+                    {"strategy", db_manager_->get_strategy_name()},
+                    {"preset", stats.workload},
+                    {"operation", row.operation},
+                    {"count", row.count},
+                    {"found_rate", row.found_rate},
+                    {"avg_ms", row.avg_ms},
+                    {"p50_ms", row.p50_ms},
+                    {"p99_ms", row.p99_ms},
+                    {"reads_per_sec", stats.query_ops_per_sec},
+                    {"write_kv_per_sec", stats.write_records_per_sec},
+                    {"write_p99_ms", stats.write_p99_ms},
+                });
+            }
+        }
+        utils::log_info("Workload suite summary written to {}", oss.str());
+    }
+}
+
+StrategyScenarioRunner::ConcurrentTestConfig StrategyScenarioRunner::prepare_scenario_phase(
+    const ScenarioPhase& phase, const BenchmarkConfig& base_config) {
+    config_ = base_config;
+    if (phase.writer_threads) {
+        config_.writer_threads = *phase.writer_threads;
+    }
+    if (phase.query_rate) {
+        config_.query_rate = *phase.query_rate;
+    }
+    if (phase.arrival_process) {
+        config_.arrival_process = *phase.arrival_process;
+    }
+    if (phase.write_distribution) {
+        config_.write_distribution = *phase.write_distribution;
+    }
+    if (phase.read_distribution) {
+        config_.read_distribution = *phase.read_distribution;
+    }
+    if (phase.version_distribution) {
+        config_.version_distribution = *phase.version_distribution;
+    }
+    if (phase.read_before_write) {
+        config_.read_before_write = *phase.read_before_write;
+    }
+    if (phase.sample_interval_seconds) {
+        config_.sample_interval_seconds = *phase.sample_interval_seconds;
+    }
+    // 追块只由阶段类型决定，命令行的--catch-up不作用于其他阶段
+    config_.catch_up = phase.type == ScenarioPhaseType::kCatchUp;
+    config_.catch_up_block_rate = phase.catch_up_block_rate;
+    config_.catch_up_baseline_seconds = phase.catch_up_baseline_seconds;
+    if (!base_config.result_file.empty()) {
+        config_.result_file = with_suffix(base_config.result_file, phase.name);
+    }
+    if (!base_config.timeseries_file.empty()) {
+        config_.timeseries_file = with_suffix(base_config.timeseries_file, phase.name);
+    }
+    workload_preset_ = phase.workload.empty() ? nullptr : find_workload_preset(phase.workload);
+
+    ConcurrentTestConfig test_config = ConcurrentTestConfig::from_benchmark_config(config_);
+    test_config.test_duration_seconds = phase.duration_seconds;
+    test_config.reader_thread_count = phase.reader_threads;
+    test_config.queries_per_thread = 200;
+    test_config.write_sleep_seconds = phase.write_sleep_seconds;
+    test_config.block_size = phase.block_size;
+    test_config.write_result_file = phase.write_result;
+    return test_config;
+}
+
+std::vector<StrategyScenarioRunner::ScenarioPhaseResult> StrategyScenarioRunner::run_scenario(const Scenario& scenario) {
+    utils::log_info("=== Starting Scenario '{}': {} phases ===", scenario.name, scenario.phases.size());
+    if (!scenario.description.empty()) {
+        utils::log_info("{}", scenario.description);
+    }
+    if (!scenario.has_load_phase()) {
+        utils::log_info("Scenario has no load phase: queries target the data already in the database");
+    }
+
+    const BenchmarkConfig base_config = config_;
+    std::vector<ScenarioPhaseResult> results;
+    for (size_t i = 0; i < scenario.phases.size(); ++i) {
+        const ScenarioPhase& phase = scenario.phases[i];
+        utils::log_info("--- Scenario phase {}/{}: {} ({}) ---", i + 1, scenario.phases.size(), phase.name,
+                       scenario_phase_type_name(phase.type));
+
+        ScenarioPhaseResult result;
+        result.name = phase.name;
+        result.type = phase.type;
+        scenario_phase_ = phase.name;
+        auto phase_start = std::chrono::steady_clock::now();
+
+        switch (phase.type) {
+        case ScenarioPhaseType::kLoad:
+            run_initial_load_phase();
+            result.details = {
+                {"blocks_written", initial_load_stats_.blocks_written},
+                {"records_written", initial_load_stats_.records_written},
+                {"records_per_sec", initial_load_stats_.wall_seconds > 0
+                                        ? initial_load_stats_.records_written / initial_load_stats_.wall_seconds
+                                        : 0.0},
+            };
+            break;
+
+        case ScenarioPhaseType::kPrune: {
+            // 没有策略支持按保留窗口删除旧版本，这里用全量手动compaction模拟prune带来的后台I/O
+            auto totals = [](const std::vector<StrategyDBManager::DBRuntimeSample>& samples) {
+                std::pair<uint64_t, uint64_t> sst_and_compaction{0, 0};
+                for (const auto& sample : samples) {
+                    sst_and_compaction.first += sample.live_sst_bytes;
+                    sst_and_compaction.second += sample.compact_write_bytes;
+                }
+                return sst_and_compaction;
+            };
+            auto before = totals(db_manager_->sample_runtime_metrics());
+            result.success = db_manager_->compact_all();
+            auto after = totals(db_manager_->sample_runtime_metrics());
+            result.details = {
+                {"live_sst_bytes_before", before.first},
+                {"live_sst_bytes_after", after.first},
+                {"compaction_bytes_written", after.second - before.second},
+            };
+            utils::log_info("Manual compaction: live SST {:.1f} MB -> {:.1f} MB, {:.1f} MB written",
+                           before.first / 1048576.0, after.first / 1048576.0,
+                           (after.second - before.second) / 1048576.0);
+            break;
+        }
+
+        case ScenarioPhaseType::kReopen: {
+            auto close_start = std::chrono::steady_clock::now();
+            db_manager_->close();
+            auto open_start = std::chrono::steady_clock::now();
+            result.success = db_manager_->open(false);
+            auto open_end = std::chrono::steady_clock::now();
+            double close_seconds = std::chrono::duration<double>(open_start - close_start).count();
+            double open_seconds = std::chrono::duration<double>(open_end - open_start).count();
+            result.details = {{"close_seconds", close_seconds}, {"open_seconds", open_seconds}};
+            utils::log_info("Database reopened: close {:.2f} s, open {:.2f} s", close_seconds, open_seconds);
+            break;
+        }
+
+        default: {
+            ConcurrentTestConfig test_config = prepare_scenario_phase(phase, base_config);
+            try {
+                run_concurrent_read_write_test(test_config);
+            } catch (const std::runtime_error& e) {
+                utils::log_error("Scenario phase {}: {}", phase.name, e.what());
+                result.success = false;
+            }
+            result.stats = last_test_stats_;
+            break;
+        }
+        }
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - phase_start).count();
+        results.push_back(std::move(result));
+        if (!results.back().success) {
+            utils::log_error("Scenario phase {} failed, skipping the remaining phases", phase.name);
+            break;
+        }
+    }
+    workload_preset_ = nullptr;
+    scenario_phase_.clear();
+    config_ = base_config;
+
+    utils::log_info("=== Scenario Result: {} ({}) ===", scenario.name, db_manager_->get_strategy_name());
+    utils::log_info("{:<16} {:<9} {:>9} {:>10} {:>9} {:>9} {:>9} {:>11} {:>10}", "phase", "type", "seconds",
+                   "reads/s", "p50 ms", "p99 ms", "blocks/s", "write kv/s", "write p99");
+    for (const auto& result : results) {
+        if (result.stats) {
+            const PerformanceStats& stats = *result.stats;
+            utils::log_info("{:<16} {:<9} {:>9.1f} {:>10.0f} {:>9.3f} {:>9.3f} {:>9.2f} {:>11.0f} {:>10.3f}",
+                           result.name, scenario_phase_type_name(result.type), result.seconds,
+                           stats.query_ops_per_sec, stats.query_p50_ms, stats.query_p99_ms,
+                           stats.catch_up ? stats.catch_up_blocks_per_sec : stats.write_ops_per_sec,
+                           stats.write_records_per_sec, stats.write_p99_ms);
+        } else {
+            utils::log_info("{:<16} {:<9} {:>9.1f}  {}{}", result.name, scenario_phase_type_name(result.type),
+                           result.seconds, result.details.dump(), result.success ? "" : " FAILED");
+        }
+    }
+    write_scenario_summary(scenario, results);
+    return results;
+}
+
+void StrategyScenarioRunner::write_scenario_summary(const Scenario& scenario,
+                                                    const std::vector<ScenarioPhaseResult>& results) const {
+    std::string output_path;
+    if (!config_.result_file.empty()) {
+        output_path = with_suffix(config_.result_file, "scenario");
+    } else {
+        auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::ostringstream oss;
+        oss << "logs/" << db_manager_->get_strategy_name() << "_scenario_"
+            << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".json";
+        output_path = oss.str();
+    }
+
+    nlohmann::ordered_json document;
+    document["schema_version"] = result_document::kSchemaVersion;
+    document["tool"] = "rocksdb_bench_app";
+    document["build"] = result_document::build_info_json();
+    document["hardware"] = result_document::hardware_info_json();
+    document["config"] = config_.to_json();
+    document["strategy"] = db_manager_->get_strategy_name();
+    document["scenario"] = {{"name", scenario.name}, {"description", scenario.description}};
+
+    nlohmann::ordered_json phases = nlohmann::ordered_json::array();
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ScenarioPhaseResult& result = results[i];
+        nlohmann::ordered_json entry = {
+            {"index", i},
+            {"name", result.name},
+            {"type", scenario_phase_type_name(result.type)},
+            {"seconds", result.seconds},
+            {"success", result.success},
+        };
+        if (result.stats) {
+            const PerformanceStats& stats = *result.stats;
+            entry["metrics"] = {
+                {"reader_threads", stats.reader_thread_count},
+                {"writer_threads", stats.writer_thread_count},
+                {"query_ops", stats.total_query_ops},
+                {"query_ops_per_sec", stats.query_ops_per_sec},
+                {"query_p50_ms", stats.query_p50_ms},
+                {"query_p99_ms", stats.query_p99_ms},
+                {"query_p999_ms", stats.query_p999_ms},
+                {"query_max_ms", stats.query_max_ms},
+                {"write_blocks", stats.total_write_ops},
+                {"write_blocks_per_sec", stats.catch_up ? stats.catch_up_blocks_per_sec : stats.write_ops_per_sec},
+                {"write_kv_per_sec", stats.write_records_per_sec},
+                {"write_p50_ms", stats.write_p50_ms},
+                {"write_p99_ms", stats.write_p99_ms},
+            };
+            if (!stats.workload.empty()) {
+                entry["metrics"]["workload"] = stats.workload;
+            }
+            if (stats.catch_up) {
+                entry["metrics"]["write_stall_seconds"] = stats.write_stall_seconds;
+                entry["metrics"]["baseline_query_p99_ms"] = stats.baseline_p99_ms;
+            }
+        }
+        if (!result.details.is_null()) {
+            entry["details"] = result.details;
+        }
+        phases.push_back(std::move(entry));
+    }
+    document["phases"] = std::move(phases);
+
+    if (result_document::write_file(output_path, document)) {
+        utils::log_info("Scenario summary written to {}", output_path);
+    }
+}
+
 // 写线程函数
-void StrategyScenarioRunner::writer_thread_function(size_t duration_seconds,
+void StrategyScenarioRunner::writer_thread_function(int writer_id,
+                                                   size_t duration_seconds,
                                                    size_t sleep_seconds,
                                                    size_t block_size) {
-    utils::log_info("Writer thread started");
+    utils::log_info("Writer thread {} started", writer_id);
 
-    const auto& all_keys = data_generator_->get_all_keys();
-    size_t block_num = initial_load_end_block_;
+    const size_t key_count = data_generator_->key_count();
     auto start_time = std::chrono::steady_clock::now();
     auto end_time = start_time + std::chrono::seconds(duration_seconds);
 
+    // 每个写线程使用独立的RNG流
     std::random_device rd;
-    std::mt19937 gen(rd());
-
-    while (std::chrono::steady_clock::now() < end_time) {
-        // 准备一个block的更新数据
-        size_t actual_batch_size = std::min(block_size, config_.total_keys);
-        auto update_indices = data_generator_->generate_hotspot_update_indices(actual_batch_size);
+    std::mt19937 gen(rd() + writer_id);
+
+    size_t blocks_written = 0;
+    BlockCoalescer coalescer;
+    utils::ThreadCpuMeter cpu_meter(writer_cpu_ns_);
+    std::vector<size_t> update_indices;
+    std::vector<std::string> read_keys;
+    // 追块限速：按时间表写block，落后时不等待直接写下一个
+    auto next_block_at = start_time;
+
+    while (std::chrono::steady_clock::now() < end_time && !write_failed_) {
+        // 从共享计数器领取下一个block号
+        BlockNum block_num = next_write_block_.fetch_add(1);
+
+        // 准备一个block的更新数据；派生key、合约keyspace下采样空间是生成器的key数而不是config_.total_keys
+        size_t actual_batch_size = std::min(block_size, key_count);
+        write_distribution_->fill(actual_batch_size, gen, update_indices);
         auto random_values = data_generator_->generate_random_values(update_indices.size());
 
         std::vector<DataRecord> records;
         records.reserve(update_indices.size());
+        size_t last_written_index = 0;   // 本block最后写入的key，作为latest分布的最新位置
 
         for (size_t i = 0; i < update_indices.size(); ++i) {
             size_t idx = update_indices[i];
-            if (idx >= all_keys.size()) continue;
+            if (idx >= key_count) continue;
 
-            DataRecord record{
-                block_num,
-                all_keys[idx],
-                random_values[i]
-            };
-            records.push_back(record);
+            DataRecord record{block_num, {}, random_values[i]};
+            data_generator_->fill_key(idx, record.addr_slot);
+            records.push_back(std::move(record));
+            last_written_index = idx;
+        }
+
+        // 合并block内的重复key：同一version key只需要一次Put
+        size_t input_records = records.size();
+        size_t duplicates = config_.coalesce_writes ? coalescer.coalesce(records) : 0;
+
+        // read-before-write：模拟block执行时先SLOAD每个slot的当前值再SSTORE
+        auto issued_at = std::chrono::steady_clock::now();
+        uint64_t read_latency_ns = 0;
+        size_t latest_found = 0;
+        if (config_.read_before_write) {
+            uint64_t read_start = TscClock::now();
+            if (config_.read_batch) {
+                read_keys.clear();
+                for (const auto& record : records) {
+                    read_keys.push_back(record.addr_slot);
+                }
+                for (const auto& value : db_manager_->query_latest_values(read_keys)) {
+                    latest_found += value.has_value();
+                }
+            } else {
+                for (const auto& record : records) {
+                    latest_found += db_manager_->query_latest_value(record.addr_slot).has_value();
+                }
+            }
+            read_latency_ns = TscClock::elapsed_nanos(read_start);
         }
 
         // 执行写入并测量耗时
-        auto write_start = std::chrono::high_resolution_clock::now();
+        uint64_t write_start = TscClock::now();
         bool success = db_manager_->write_batch(records);
-        auto write_end = std::chrono::high_resolution_clock::now();
+        uint64_t write_latency_ns = TscClock::elapsed_nanos(write_start);
 
         if (!success) {
-            utils::log_error("Writer thread: Failed to write batch at block {}", block_num);
+            utils::log_error("Writer thread {}: Failed to write batch at block {}, stopping all writers",
+                            writer_id, block_num);
+            write_failed_ = true;
             break;
         }
+        if (trace_writer_) {
+            // 写完成后才记录：trace中排在后面的查询发起时该block已经可见
+            trace_writer_->record_block(TraceEventType::kWriteBlock, block_num, records, issued_at);
+        }
+        logical_bytes_written_ += logical_record_bytes(records);
+        if (!records.empty()) {
+            // latest分布的最新位置跟随写入。keyspace固定、写入只更新已有key，最大索引几乎总是最后一个key，
+            // 所以用最近写入的key而不是最大索引
+            write_distribution_->observe_write(last_written_index);
+            read_distribution_->observe_write(last_written_index);
+        }
 
-        double write_latency_ms = std::chrono::duration<double, std::milli>(write_end - write_start).count();
+        double write_latency_ms = write_latency_ns / 1e6;
+        auto stage_timing = db_manager_->get_last_write_timing();
 
         // 记录写入性能（使用专用写锁）
         {
             utils::log_debug("WRITE_LOCK: Acquiring write_perf_mutex_ for block {}", block_num);
-            std::lock_guard<std::mutex> lock(write_perf_mutex_);
-            write_latencies_.push_back(write_latency_ms);
+            std::lock_guard<InstrumentedMutex> lock(write_perf_mutex_);
+            write_latency_histogram_.record(write_latency_ns);
+            write_timeline_.record(DBEventLog::now_ns(), write_latency_ns);
+            if (stage_timing.has_value()) {
+                write_range_histogram_.record(static_cast<uint64_t>(stage_timing->range_ms * 1e6));
+                write_data_histogram_.record(static_cast<uint64_t>(stage_timing->data_ms * 1e6));
+                write_overlap_histogram_.record(static_cast<uint64_t>(stage_timing->overlap_ms() * 1e6));
+            }
             write_count_++;
+            write_record_count_ += records.size();
+            write_input_record_count_ += input_records;
+            write_duplicate_count_ += duplicates;
+            if (config_.read_before_write) {
+                block_read_histogram_.record(read_latency_ns);
+                block_execution_histogram_.record(read_latency_ns + write_latency_ns);
+                block_read_count_ += records.size();
+                block_read_found_count_ += latest_found;
+            }
             utils::log_debug("WRITE_LOCK: Released write_perf_mutex_, total writes: {}", write_count_.load());
         }
 
         // 更新当前最大block号
-        {
-            std::lock_guard<std::mutex> lock(state_mutex_);
-            current_max_block_ = block_num;
+        publish_completed_block(block_num);
+        blocks_written++;
+        cpu_meter.publish();
+
+        // 追块模式每秒可能写很多block，只每100个block输出一次
+        if (!catch_up_ || blocks_written % 100 == 0) {
+            if (stage_timing.has_value()) {
+                utils::log_info("Writer thread {}: Completed block {}, write_latency_ms={:.3f} (range={:.3f} data={:.3f} overlap={:.3f})",
+                               writer_id, block_num, write_latency_ms, stage_timing->range_ms, stage_timing->data_ms,
+                               stage_timing->overlap_ms());
+            } else {
+                utils::log_info("Writer thread {}: Completed block {}, write_latency_ms={:.3f}",
+                               writer_id, block_num, write_latency_ms);
+            }
         }
 
-        utils::log_info("Writer thread: Completed block {}, write_latency_ms={:.3f}",
-                       block_num, write_latency_ms);
+        if (!catch_up_) {
+            // 等待指定时间
+            std::this_thread::sleep_for(std::chrono::seconds(sleep_seconds));
+        } else if (writer_block_interval_.count() > 0) {
+            next_block_at += writer_block_interval_;
+            // 落后超过1秒时放弃补写欠下的block，避免存储恢复后突发写入
+            auto now = std::chrono::steady_clock::now();
+            if (next_block_at + std::chrono::seconds(1) < now) {
+                next_block_at = now;
+            }
+            std::this_thread::sleep_until(std::min(next_block_at, end_time));
+        }
+    }
+
+    utils::log_info("Writer thread {} completed {} blocks", writer_id, blocks_written);
+}
 
-        block_num++;
+void StrategyScenarioRunner::publish_completed_block(BlockNum block_num) {
+    std::lock_guard<InstrumentedMutex> lock(state_mutex_);
+    completed_unpublished_.insert(block_num);
 
-        // 等待指定时间
-        std::this_thread::sleep_for(std::chrono::seconds(sleep_seconds));
+    // 只发布连续完成的前缀；前面还有block在写入时，后完成的block先暂存
+    bool advanced = false;
+    while (!completed_unpublished_.empty() && *completed_unpublished_.begin() == next_publish_block_) {
+        completed_unpublished_.erase(completed_unpublished_.begin());
+        next_publish_block_++;
+        advanced = true;
+    }
+    if (advanced) {
+        current_max_block_ = next_publish_block_ - 1;
     }
-
-    utils::log_info("Writer thread completed {} blocks", block_num - initial_load_end_block_);
 }
 
 // 读线程函数
 void StrategyScenarioRunner::reader_thread_function(int thread_id, std::chrono::seconds test_duration) {
     utils::log_info("Reader thread {} started, duration={} seconds", thread_id, test_duration.count());
 
-    const auto& all_keys = data_generator_->get_all_keys();
-
     std::random_device rd;
     std::mt19937 gen(rd() + thread_id);  // 每个线程使用不同的种子
+    std::string key;   // 复用buffer，派生key模式下按索引现算
 
     size_t successful_queries = 0;
     size_t total_queries = 0;
     auto start_time = std::chrono::steady_clock::now();
 
-    // 清空线程本地存储（无锁操作）
-    thread_query_latencies_.clear();
-    thread_query_latencies_.reserve(10000);  // 预分配较大空间
-
-    utils::log_debug("READ_THREAD {}: Using thread-local storage, no lock needed for latencies", thread_id);
+    // 本线程专属的直方图，记录无需加锁
+    LatencyHistogram* histogram;
+    LatencyHistogram* service_histogram;
+    LatencyHistogram* baseline_histogram;
+    std::array<LatencyHistogram*, kVersionAgeBucketCount> age_histograms;
+    std::array<LatencyHistogram*, kReadOperationCount> op_histograms;
+    double thread_rate;
+    bool poisson;
+    size_t perf_sample_rate;
+    {
+        std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+        histogram = reader_histograms_.at(thread_id).get();
+        service_histogram = reader_service_histograms_.at(thread_id).get();
+        baseline_histogram = reader_baseline_histograms_.at(thread_id).get();
+        for (size_t bucket = 0; bucket < kVersionAgeBucketCount; ++bucket) {
+            age_histograms[bucket] = reader_age_histograms_.at(thread_id * kVersionAgeBucketCount + bucket).get();
+        }
+        for (size_t op = 0; op < kReadOperationCount; ++op) {
+            op_histograms[op] = reader_op_histograms_.at(thread_id * kReadOperationCount + op).get();
+        }
+        thread_rate = reader_histograms_.empty() ? 0.0 : target_query_rate_ / reader_histograms_.size();
+        poisson = poisson_arrivals_;
+        perf_sample_rate = perf_sample_rate_;
+    }
+    std::vector<query_perf::Sample> perf_samples;
+    std::array<uint64_t, kReadOperationCount> op_found{};
+    std::array<uint64_t, kReadOperationCount> op_items{};
+    const WorkloadPreset* preset = workload_preset_;
+    utils::ThreadCpuMeter cpu_meter(reader_cpu_ns_);
+    // 各线程的采样相位错开
+    size_t perf_countdown = perf_sample_rate > 0 ? 1 + static_cast<size_t>(thread_id) % perf_sample_rate : 0;
+
+    utils::log_debug("READ_THREAD {}: Using per-thread histogram, no lock needed for latencies", thread_id);
+
+    // 开环：按到达时间表发起查询。查询落后于时间表时不等待、立即发起，
+    // 延迟从计划发起时刻算起，存储卡顿期间“本该发起”的查询也会计入排队时间
+    const bool open_loop = thread_rate > 0.0;
+    const double mean_gap_ns = open_loop ? 1e9 / thread_rate : 0.0;
+    std::exponential_distribution<double> poisson_gap(1.0);
+    auto next_gap = [&]() {
+        double gap_ns = poisson ? poisson_gap(gen) * mean_gap_ns : mean_gap_ns;
+        return std::chrono::nanoseconds(static_cast<int64_t>(gap_ns));
+    };
+    // 各线程的第一个到达时刻随机错开，避免所有读线程同时发起
+    std::chrono::steady_clock::time_point next_intended = start_time;
+    if (open_loop) {
+        std::uniform_real_distribution<double> phase(0.0, mean_gap_ns);
+        next_intended += std::chrono::nanoseconds(static_cast<int64_t>(phase(gen)));
+    }
 
     // 在测试持续时间内持续执行查询
     while (test_running_) {
-        // 检查是否超过测试持续时间
-        auto elapsed = std::chrono::steady_clock::now() - start_time;
-        if (elapsed >= test_duration) {
-            break;
+        std::chrono::steady_clock::time_point intended_start;
+        if (open_loop) {
+            intended_start = next_intended;
+            next_intended += next_gap();
+            if (intended_start - start_time >= test_duration) {
+                break;
+            }
+            // 分段sleep，测试结束时不必等到下一个到达时刻
+            auto now = std::chrono::steady_clock::now();
+            while (now < intended_start && test_running_) {
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+                    intended_start - now, std::chrono::milliseconds(100)));
+                now = std::chrono::steady_clock::now();
+            }
+            if (!test_running_) {
+                break;
+            }
+        } else {
+            // 检查是否超过测试持续时间
+            auto elapsed = std::chrono::steady_clock::now() - start_time;
+            if (elapsed >= test_duration) {
+                break;
+            }
         }
         BlockNum max_block = current_max_block_;
 
-        std::uniform_int_distribution<size_t> key_dist(0, all_keys.size() - 1);
-        std::uniform_int_distribution<BlockNum> version_dist(initial_load_end_block_, max_block);
+        ReadOperation op = preset ? preset->mix.pick(gen) : ReadOperation::kHistorical;
+        size_t key_idx = read_distribution_->next(gen);
+        BlockNum target_version = version_distribution_->next(gen, VersionSpan{max_block, initial_load_end_block_});
+        data_generator_->fill_key(key_idx, key);
+        if (op == ReadOperation::kAbsent) {
+            key.push_back('~');   // 生成的key只含十六进制、数字和'#'，加'~'后必然不存在
+        }
+
+        // trace只能表示历史版本查询，最新值点查和扫描不录制
+        if (trace_writer_ && (op == ReadOperation::kHistorical || op == ReadOperation::kAbsent)) {
+            trace_writer_->record_query(key, target_version,
+                                        open_loop ? intended_start : std::chrono::steady_clock::now());
+        }
 
-        size_t key_idx = key_dist(gen);
-        BlockNum target_version = version_dist(gen);
-        const std::string& key = all_keys[key_idx];
+        bool perf_sample = perf_countdown > 0 && --perf_countdown == 0;
+        if (perf_sample) {
+            perf_countdown = perf_sample_rate;
+            query_perf::begin_sample();
+        }
+
+        QueryResult query_result;
+        switch (op) {
+        case ReadOperation::kLatest:
+            query_result = query_latest_value(key);
+            break;
+        case ReadOperation::kScan:
+            query_result = scan_version_history(
+                key, target_version > preset->scan_window_blocks ? target_version - preset->scan_window_blocks : 0,
+                target_version, preset->scan_limit);
+            break;
+        default:
+            query_result = query_historical_version(key, target_version);
+            break;
+        }
 
-        auto query_result = query_historical_version(key, target_version);
+        if (perf_sample) {
+            perf_samples.push_back(query_perf::end_sample());
+            perf_samples.back().latency_ns = query_result.latency_ns;
+        }
 
-        double latency_ms = query_result.latency_ms;
-        thread_query_latencies_.push_back(latency_ms);
+        // 追块基线阶段（写线程尚未启动）的延迟单独记录
+        LatencyHistogram* latency_histogram = writers_running_ ? histogram : baseline_histogram;
+        if (open_loop) {
+            auto response_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - intended_start).count();
+            latency_histogram->record(static_cast<uint64_t>(std::max<int64_t>(response_ns, 0)));
+            service_histogram->record(query_result.latency_ns);
+            query_timeline_.record(DBEventLog::now_ns(), static_cast<uint64_t>(std::max<int64_t>(response_ns, 0)));
+        } else {
+            latency_histogram->record(query_result.latency_ns);
+            query_timeline_.record(DBEventLog::now_ns(), query_result.latency_ns);
+        }
+        if (op == ReadOperation::kHistorical) {
+            age_histograms[version_age_bucket(max_block - target_version)]->record(query_result.latency_ns);
+        }
+        op_histograms[static_cast<size_t>(op)]->record(query_result.latency_ns);
+        op_found[static_cast<size_t>(op)] += query_result.found;
+        op_items[static_cast<size_t>(op)] += query_result.items;
         total_queries++;
 
         if (query_result.found) {
             successful_queries++;
         }
 
-        if (total_queries % 50 == 0) {
-            utils::log_info("Reader thread {}: {}/{} queries completed, success_rate={:.1f}%, local_latencies={}",
-                           thread_id, total_queries, thread_query_latencies_.size(),
-                           (successful_queries * 100.0 / total_queries), thread_query_latencies_.size());
+        if (total_queries % 256 == 0) {
+            cpu_meter.publish();
+        }
+
+        // 计算p99要遍历直方图，只在debug日志开启时计算
+        if (total_queries % 50 == 0 && utils::debug_enabled()) {
+            utils::log_debug("Reader thread {}: {} queries completed, success_rate={:.1f}%, local_p99={:.3f}ms",
+                            thread_id, total_queries,
+                            (successful_queries * 100.0 / total_queries), histogram->percentile_ms(99.0));
         }
     }
 
-    // 在线程结束时合并到全局统计（只加锁一次）
-    {
-        utils::log_debug("MERGE_LOCK: Reader thread {} acquiring query_merge_mutex_ to merge {} latencies",
-                       thread_id, thread_query_latencies_.size());
-        std::lock_guard<std::mutex> lock(query_merge_mutex_);
-        query_latencies_.insert(query_latencies_.end(),
-                              thread_query_latencies_.begin(),
-                              thread_query_latencies_.end());
-        total_successful_queries_ += successful_queries;
-        utils::log_debug("MERGE_LOCK: Reader thread {} released query_merge_mutex_, total query latencies: {}",
-                       thread_id, query_latencies_.size());
+    // 直方图在统计时合并，这里只累加成功数
+    total_successful_queries_ += successful_queries;
+    for (size_t op = 0; op < kReadOperationCount; ++op) {
+        op_found_count_[op] += op_found[op];
+        op_item_count_[op] += op_items[op];
+    }
+    if (!perf_samples.empty()) {
+        std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+        perf_samples_.insert(perf_samples_.end(), std::make_move_iterator(perf_samples.begin()),
+                             std::make_move_iterator(perf_samples.end()));
     }
 
     utils::log_info("Reader thread {} completed: {}/{} queries successful ({:.1f}%)",
@@ -351,17 +1354,221 @@ void StrategyScenarioRunner::reader_thread_function(int thread_id, std::chrono::
                    total_queries > 0 ? (successful_queries * 100.0 / total_queries) : 0.0);
 }
 
+// 采样线程函数
+void StrategyScenarioRunner::sampler_thread_function(size_t interval_seconds, std::string output_path) {
+    TimeSeriesWriter writer(output_path);
+    if (!writer.is_open()) {
+        return;
+    }
+    utils::log_info("Sampler thread started: every {} s -> {}", interval_seconds, output_path);
+    utils::ThreadCpuMeter cpu_meter(sampler_cpu_ns_);
+
+    auto test_start = std::chrono::steady_clock::now();
+    auto last_sample = test_start;
+
+    // 上一次采样时的累计值，区间指标为两次采样之差
+    LatencyHistogram previous_query;
+    LatencyHistogram previous_write;
+    LatencyHistogram current;
+    LatencyHistogram interval;
+    size_t previous_queries = 0;
+    size_t previous_blocks = 0;
+    size_t previous_records = 0;
+    uint64_t previous_process_cpu = utils::read_process_cpu_time().total_ns();
+    uint64_t previous_reader_cpu = reader_cpu_ns_.load();
+    uint64_t previous_writer_cpu = writer_cpu_ns_.load();
+    uint64_t previous_sampler_cpu = sampler_cpu_ns_.load();
+    std::map<std::string, StrategyDBManager::DBRuntimeSample> previous_db;
+    for (const auto& sample : db_manager_->sample_runtime_metrics()) {
+        previous_db[sample.name] = sample;
+    }
+
+    bool stopping = false;
+    while (!stopping) {
+        {
+            std::unique_lock<std::mutex> lock(sampler_mutex_);
+            stopping = sampler_cv_.wait_for(lock, std::chrono::seconds(interval_seconds),
+                                            [this] { return sampler_stop_; });
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        double interval_s = std::chrono::duration<double>(now - last_sample).count();
+        if (stopping && interval_s < 1.0) {
+            break;  // 结束时不足1秒的尾巴不单独输出
+        }
+        last_sample = now;
+
+        TimeSeriesWriter::Row row;
+        row.emplace_back("elapsed_s", std::chrono::duration<double>(now - test_start).count());
+        row.emplace_back("interval_s", interval_s);
+        row.emplace_back("max_block", static_cast<uint64_t>(current_max_block_.load()));
+
+        // 查询：合并各读线程的累计直方图，减去上次快照得到区间直方图
+        current.reset();
+        {
+            std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+            for (const auto& histogram : reader_histograms_) {
+                current.merge_from(*histogram);
+            }
+        }
+        interval.copy_from(current);
+        interval.subtract(previous_query);
+        previous_query.copy_from(current);
+        size_t total_queries = current.count();
+        row.emplace_back("query_ops_per_sec", (total_queries - previous_queries) / interval_s);
+        row.emplace_back("query_avg_ms", interval.mean() / 1e6);
+        row.emplace_back("query_p50_ms", interval.percentile_ms(50.0));
+        row.emplace_back("query_p90_ms", interval.percentile_ms(90.0));
+        row.emplace_back("query_p99_ms", interval.percentile_ms(99.0));
+        row.emplace_back("query_p999_ms", interval.percentile_ms(99.9));
+        row.emplace_back("query_max_ms", interval.max() / 1e6);
+
+        // 写入
+        size_t total_blocks;
+        size_t total_records;
+        {
+            std::lock_guard<InstrumentedMutex> lock(write_perf_mutex_);
+            current.copy_from(write_latency_histogram_);
+            total_blocks = write_count_.load();
+            total_records = write_record_count_.load();
+        }
+        interval.copy_from(current);
+        interval.subtract(previous_write);
+        previous_write.copy_from(current);
+        row.emplace_back("write_blocks_per_sec", (total_blocks - previous_blocks) / interval_s);
+        row.emplace_back("write_kv_per_sec", (total_records - previous_records) / interval_s);
+        row.emplace_back("write_avg_ms", interval.mean() / 1e6);
+        row.emplace_back("write_p99_ms", interval.percentile_ms(99.0));
+        row.emplace_back("write_max_ms", interval.max() / 1e6);
+        {
+            std::lock_guard<std::mutex> lock(sampler_mutex_);
+            interval_throughput_.push_back({std::chrono::duration<double>(now - test_start).count(), interval_s,
+                                            (total_queries - previous_queries) / interval_s,
+                                            (total_blocks - previous_blocks) / interval_s,
+                                            (total_records - previous_records) / interval_s});
+        }
+        size_t interval_queries = total_queries - previous_queries;
+
+        // CPU：进程合计折算为核数，读写线程折算为每次查询/每条写入的CPU微秒
+        {
+            cpu_meter.publish();
+            uint64_t process_cpu = utils::read_process_cpu_time().total_ns();
+            uint64_t reader_cpu = reader_cpu_ns_.load();
+            uint64_t writer_cpu = writer_cpu_ns_.load();
+            uint64_t sampler_cpu = sampler_cpu_ns_.load();
+            uint64_t process_delta = process_cpu - previous_process_cpu;
+            uint64_t foreground_delta = (reader_cpu - previous_reader_cpu) + (writer_cpu - previous_writer_cpu) +
+                                        (sampler_cpu - previous_sampler_cpu);
+            size_t interval_records = total_records - previous_records;
+            row.emplace_back("process_cpu_cores", process_delta / 1e9 / interval_s);
+            row.emplace_back("background_cpu_cores",
+                             process_delta > foreground_delta ? (process_delta - foreground_delta) / 1e9 / interval_s : 0.0);
+            row.emplace_back("cpu_us_per_query",
+                             interval_queries > 0 ? (reader_cpu - previous_reader_cpu) / 1e3 / interval_queries : 0.0);
+            row.emplace_back("cpu_us_per_write_record",
+                             interval_records > 0 ? (writer_cpu - previous_writer_cpu) / 1e3 / interval_records : 0.0);
+            previous_process_cpu = process_cpu;
+            previous_reader_cpu = reader_cpu;
+            previous_writer_cpu = writer_cpu;
+            previous_sampler_cpu = sampler_cpu;
+        }
+
+        previous_queries = total_queries;
+        previous_blocks = total_blocks;
+        previous_records = total_records;
+
+        // 区间内完成的flush/compaction数和写停顿时长
+        if (auto event_log = db_manager_->get_event_log()) {
+            int64_t to_ns = DBEventLog::now_ns();
+            int64_t from_ns = to_ns - static_cast<int64_t>(interval_s * 1e9);
+            uint64_t flushes = 0;
+            uint64_t compactions = 0;
+            for (const auto& event : event_log->events_between(from_ns, to_ns)) {
+                if (event.end_ns < from_ns) {
+                    continue;
+                }
+                flushes += event.type == DBEvent::Type::kFlush;
+                compactions += event.type == DBEvent::Type::kCompaction;
+            }
+            int64_t stall_ns = 0;
+            for (const auto& window : event_log->stall_windows(to_ns)) {
+                stall_ns += std::max<int64_t>(0, std::min(window.end_ns, to_ns) - std::max(window.start_ns, from_ns));
+            }
+            row.emplace_back("flushes", flushes);
+            row.emplace_back("compactions", compactions);
+            row.emplace_back("stall_ms", stall_ns / 1e6);
+        }
+
+        // 各DB的RocksDB状态：property取当前值，ticker取区间增量
+        auto db_samples = db_manager_->sample_runtime_metrics();
+        uint64_t interval_file_read = 0;
+        for (const auto& sample : db_samples) {
+            const auto& before = previous_db[sample.name];
+            auto delta = [](uint64_t now_value, uint64_t before_value) {
+                return now_value > before_value ? now_value - before_value : uint64_t{0};
+            };
+            const std::string prefix = sample.name + "_";
+            row.emplace_back(prefix + "pending_compaction_bytes", sample.pending_compaction_bytes);
+            row.emplace_back(prefix + "l0_files", sample.l0_files);
+            row.emplace_back(prefix + "memtable_bytes", sample.memtable_bytes);
+            row.emplace_back(prefix + "immutable_memtables", sample.immutable_memtables);
+            row.emplace_back(prefix + "running_compactions", sample.running_compactions);
+            row.emplace_back(prefix + "running_flushes", sample.running_flushes);
+            row.emplace_back(prefix + "delayed_write_rate", sample.delayed_write_rate);
+            row.emplace_back(prefix + "write_stopped", sample.write_stopped);
+            row.emplace_back(prefix + "stall_micros", delta(sample.stall_micros, before.stall_micros));
+            row.emplace_back(prefix + "bytes_written", delta(sample.bytes_written, before.bytes_written));
+            row.emplace_back(prefix + "flush_write_bytes", delta(sample.flush_write_bytes, before.flush_write_bytes));
+            row.emplace_back(prefix + "compact_write_bytes", delta(sample.compact_write_bytes, before.compact_write_bytes));
+            row.emplace_back(prefix + "block_cache_hits", delta(sample.block_cache_hits, before.block_cache_hits));
+            row.emplace_back(prefix + "block_cache_misses", delta(sample.block_cache_misses, before.block_cache_misses));
+            row.emplace_back(prefix + "file_read_bytes", delta(sample.file_read_bytes, before.file_read_bytes));
+            interval_file_read += delta(sample.file_read_bytes, before.file_read_bytes);
+            row.emplace_back(prefix + "live_sst_bytes", sample.live_sst_bytes);
+            previous_db[sample.name] = sample;
+        }
+
+        // 放大随历史深度的变化：写/空间放大取累计值，读放大取区间内每次查询的文件读取字节
+        AmplificationReport amplification(db_samples, {}, logical_bytes_written_.load(), 0);
+        for (const auto& db : amplification.dbs()) {
+            row.emplace_back(db.name + "_write_amp", db.write_amplification());
+            row.emplace_back(db.name + "_space_amp", db.space_amplification());
+        }
+        row.emplace_back("write_amp", amplification.write_amplification());
+        row.emplace_back("space_amp", amplification.space_amplification());
+        row.emplace_back("file_read_bytes_per_query",
+                         interval_queries > 0 ? static_cast<double>(interval_file_read) / interval_queries : 0.0);
+
+        // 内存占用：各DB按类型拆分，进程内结构按组件拆分
+        auto memory = sample_memory_usage();
+        row.emplace_back("rss_bytes", memory.rss_bytes);
+        for (const auto& db : memory.dbs) {
+            const std::string prefix = db.name + "_mem_";
+            row.emplace_back(prefix + "memtable_bytes", db.memtable_total);
+            row.emplace_back(prefix + "table_readers_bytes", db.table_readers);
+            row.emplace_back(prefix + "cache_bytes", db.cache_total);
+        }
+        for (const auto& [name, bytes] : memory.components) {
+            row.emplace_back(name + "_bytes", bytes);
+        }
+
+        writer.append(row);
+    }
+
+    utils::log_info("Sampler thread stopped, time series written to {}", output_path);
+}
+
 StrategyScenarioRunner::QueryResult StrategyScenarioRunner::query_historical_version(const std::string& addr_slot, BlockNum target_version) {
-    auto query_start = std::chrono::high_resolution_clock::now();
+    uint64_t query_start = TscClock::now();
 
     auto result = db_manager_->query_historical_version(addr_slot, target_version);
 
-    auto query_end = std::chrono::high_resolution_clock::now();
-    double latency_ms = std::chrono::duration<double, std::milli>(query_end - query_start).count();
+    uint64_t latency_ns = TscClock::elapsed_nanos(query_start);
 
     QueryResult query_result;
     query_result.found = result.has_value();
-    query_result.latency_ms = latency_ms;
+    query_result.latency_ns = latency_ns;
+    query_result.latency_ms = latency_ns / 1e6;
 
     if (result.has_value()) {
         // 解析返回的结果（假设格式为 "block_num:value"）
@@ -375,6 +1582,42 @@ StrategyScenarioRunner::QueryResult StrategyScenarioRunner::query_historical_ver
         }
     }
 
+    query_result.items = query_result.found ? 1 : 0;
+    return query_result;
+}
+
+StrategyScenarioRunner::QueryResult StrategyScenarioRunner::query_latest_value(const std::string& addr_slot) {
+    uint64_t query_start = TscClock::now();
+    auto result = db_manager_->query_latest_value(addr_slot);
+    uint64_t latency_ns = TscClock::elapsed_nanos(query_start);
+
+    QueryResult query_result{};
+    query_result.found = result.has_value();
+    query_result.items = query_result.found ? 1 : 0;
+    query_result.latency_ns = latency_ns;
+    query_result.latency_ms = latency_ns / 1e6;
+    if (result.has_value()) {
+        query_result.value = std::move(*result);
+    }
+    return query_result;
+}
+
+StrategyScenarioRunner::QueryResult StrategyScenarioRunner::scan_version_history(const std::string& addr_slot,
+                                                                                 BlockNum from_block,
+                                                                                 BlockNum to_block, size_t limit) {
+    uint64_t query_start = TscClock::now();
+    auto versions = db_manager_->scan_version_history(addr_slot, from_block, to_block, limit);
+    uint64_t latency_ns = TscClock::elapsed_nanos(query_start);
+
+    QueryResult query_result{};
+    query_result.found = !versions.empty();
+    query_result.items = versions.size();
+    query_result.latency_ns = latency_ns;
+    query_result.latency_ms = latency_ns / 1e6;
+    if (!versions.empty()) {
+        query_result.block_num = versions.back().first;
+        query_result.value = std::move(versions.back().second);
+    }
     return query_result;
 }
 
@@ -383,40 +1626,686 @@ StrategyScenarioRunner::PerformanceStats StrategyScenarioRunner::get_performance
     PerformanceStats stats;
 
     utils::log_debug("GET_STATS: Acquiring write_perf_mutex_ to get write stats");
-    std::lock_guard<std::mutex> write_lock(write_perf_mutex_);
+    std::lock_guard<InstrumentedMutex> write_lock(write_perf_mutex_);
     stats.total_write_ops = write_count_.load();
-    stats.write_latencies_ms = write_latencies_;
+    stats.write_failed = write_failed_.load();
+    stats.total_write_records = write_record_count_.load();
+    stats.write_input_records = write_input_record_count_.load();
+    stats.write_duplicate_records = write_duplicate_count_.load();
+    stats.writer_thread_count = test_writer_threads_;
+    stats.reader_thread_count = test_reader_threads_;
+    LatencyHistogram write_histogram;
+    write_histogram.merge_from(write_latency_histogram_);
+    stats.write_stage_count = write_range_histogram_.count();
+    if (stats.write_stage_count > 0) {
+        stats.write_range_avg_ms = write_range_histogram_.mean() / 1e6;
+        stats.write_range_p99_ms = write_range_histogram_.percentile_ms(99.0);
+        stats.write_data_avg_ms = write_data_histogram_.mean() / 1e6;
+        stats.write_data_p99_ms = write_data_histogram_.percentile_ms(99.0);
+        stats.write_overlap_avg_ms = write_overlap_histogram_.mean() / 1e6;
+        // 各直方图的样本数相同，均值之比等于总和之比
+        if (stats.write_range_avg_ms + stats.write_data_avg_ms > 0) {
+            stats.write_overlap_ratio = stats.write_overlap_avg_ms / (stats.write_range_avg_ms + stats.write_data_avg_ms);
+        }
+    }
+    if (config_.read_before_write && block_execution_histogram_.count() > 0) {
+        stats.read_before_write = true;
+        stats.block_read_avg_ms = block_read_histogram_.mean() / 1e6;
+        stats.block_read_p50_ms = block_read_histogram_.percentile_ms(50.0);
+        stats.block_read_p99_ms = block_read_histogram_.percentile_ms(99.0);
+        stats.block_execution_avg_ms = block_execution_histogram_.mean() / 1e6;
+        stats.block_execution_p50_ms = block_execution_histogram_.percentile_ms(50.0);
+        stats.block_execution_p99_ms = block_execution_histogram_.percentile_ms(99.0);
+        stats.block_execution_max_ms = block_execution_histogram_.max() / 1e6;
+        stats.block_read_share = stats.block_execution_avg_ms > 0
+                                     ? stats.block_read_avg_ms / stats.block_execution_avg_ms : 0.0;
+        stats.block_reads = block_read_count_;
+        stats.block_read_found_rate = block_read_count_ > 0
+                                          ? static_cast<double>(block_read_found_count_) / block_read_count_ : 0.0;
+    }
     utils::log_debug("GET_STATS: Released write_perf_mutex_, write_ops: {}", stats.total_write_ops);
 
     utils::log_debug("GET_STATS: Acquiring query_merge_mutex_ to get query stats");
-    std::lock_guard<std::mutex> query_lock(query_merge_mutex_);
-    stats.total_query_ops = query_latencies_.size();
+    std::lock_guard<InstrumentedMutex> query_lock(query_merge_mutex_);
+    LatencyHistogram query_histogram;
+    for (const auto& histogram : reader_histograms_) {
+        query_histogram.merge_from(*histogram);
+    }
+    stats.total_query_ops = query_histogram.count();
     stats.successful_queries = total_successful_queries_.load();
-    stats.query_latencies_ms = query_latencies_;
+    if (target_query_rate_ > 0) {
+        LatencyHistogram service_histogram;
+        for (const auto& histogram : reader_service_histograms_) {
+            service_histogram.merge_from(*histogram);
+        }
+        stats.open_loop = true;
+        stats.offered_query_rate = target_query_rate_;
+        if (service_histogram.count() > 0) {
+            stats.service_avg_ms = service_histogram.mean() / 1e6;
+            stats.service_p50_ms = service_histogram.percentile_ms(50.0);
+            stats.service_p99_ms = service_histogram.percentile_ms(99.0);
+            stats.service_p999_ms = service_histogram.percentile_ms(99.9);
+            stats.service_max_ms = service_histogram.max() / 1e6;
+        }
+    }
+    const auto& age_labels = version_age_bucket_labels();
+    for (size_t bucket = 0; bucket < kVersionAgeBucketCount; ++bucket) {
+        LatencyHistogram age_histogram;
+        for (size_t i = bucket; i < reader_age_histograms_.size(); i += kVersionAgeBucketCount) {
+            age_histogram.merge_from(*reader_age_histograms_[i]);
+        }
+        if (age_histogram.count() == 0) {
+            continue;
+        }
+        PerformanceStats::VersionAgeLatency row;
+        row.bucket = age_labels[bucket];
+        row.count = age_histogram.count();
+        row.avg_ms = age_histogram.mean() / 1e6;
+        row.p50_ms = age_histogram.percentile_ms(50.0);
+        row.p99_ms = age_histogram.percentile_ms(99.0);
+        row.max_ms = age_histogram.max() / 1e6;
+        stats.version_age_latency.push_back(row);
+    }
+    if (workload_preset_) {
+        stats.workload = workload_preset_->name;
+        for (size_t op = 0; op < kReadOperationCount; ++op) {
+            LatencyHistogram op_histogram;
+            for (size_t i = op; i < reader_op_histograms_.size(); i += kReadOperationCount) {
+                op_histogram.merge_from(*reader_op_histograms_[i]);
+            }
+            if (op_histogram.count() == 0) {
+                continue;
+            }
+            PerformanceStats::OperationLatency row;
+            row.operation = read_operation_name(static_cast<ReadOperation>(op));
+            row.count = op_histogram.count();
+            row.found_rate = static_cast<double>(op_found_count_[op].load()) / row.count;
+            row.items_per_op = static_cast<double>(op_item_count_[op].load()) / row.count;
+            row.avg_ms = op_histogram.mean() / 1e6;
+            row.p50_ms = op_histogram.percentile_ms(50.0);
+            row.p99_ms = op_histogram.percentile_ms(99.0);
+            row.max_ms = op_histogram.max() / 1e6;
+            stats.operation_latency.push_back(row);
+        }
+    }
     utils::log_debug("GET_STATS: Released query_merge_mutex_, query_ops: {}", stats.total_query_ops);
 
-    calculate_performance_statistics(stats);
+    calculate_performance_statistics(stats, query_histogram, write_histogram);
 
     utils::log_debug("GET_STATS: Performance statistics calculated successfully");
     return stats;
 }
 
-// 计算性能统计数据
-void StrategyScenarioRunner::calculate_performance_statistics(PerformanceStats& stats) const {
-    // 计算查询性能统计
-    if (!stats.query_latencies_ms.empty()) {
-        std::vector<double> sorted_latencies = stats.query_latencies_ms;
-        std::sort(sorted_latencies.begin(), sorted_latencies.end());
+void StrategyScenarioRunner::snapshot_latency_histograms(LatencyHistogram& query_histogram,
+                                                         LatencyHistogram& write_histogram) const {
+    {
+        std::lock_guard<InstrumentedMutex> lock(write_perf_mutex_);
+        write_histogram.copy_from(write_latency_histogram_);
+    }
+    query_histogram.reset();
+    std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+    for (const auto& histogram : reader_histograms_) {
+        query_histogram.merge_from(*histogram);
+    }
+}
 
-        double sum = std::accumulate(sorted_latencies.begin(), sorted_latencies.end(), 0.0);
-        stats.query_avg_ms = sum / sorted_latencies.size();
+QueryPerfReport StrategyScenarioRunner::build_query_perf_report() const {
+    // 采样记录的是服务时间：闭环时与查询直方图一致，开环时用服务时间直方图分段
+    std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+    LatencyHistogram latency;
+    const auto& histograms = target_query_rate_ > 0 ? reader_service_histograms_ : reader_histograms_;
+    for (const auto& histogram : histograms) {
+        latency.merge_from(*histogram);
+    }
+    return QueryPerfReport(latency, perf_samples_);
+}
+
+void StrategyScenarioRunner::fill_catch_up_stats(PerformanceStats& stats, int64_t writers_start_ns,
+                                                 int64_t writers_end_ns, double baseline_seconds) const {
+    stats.catch_up = true;
+    stats.catch_up_seconds = std::max(0.0, (writers_end_ns - writers_start_ns) / 1e9);
+    if (stats.catch_up_seconds > 0) {
+        stats.catch_up_blocks_per_sec = stats.total_write_ops / stats.catch_up_seconds;
+        stats.catch_up_kv_per_sec = stats.total_write_records / stats.catch_up_seconds;
+        stats.catch_up_query_rate = stats.total_query_ops / stats.catch_up_seconds;
+    }
+
+    // 写线程运行期间每个窗口的block吞吐；首尾不完整的秒不计入
+    size_t first = static_cast<size_t>(std::max<int64_t>(0, writers_start_ns - test_origin_ns_) / 1000000000) + 1;
+    size_t last = std::min(write_timeline_.size(),
+                           static_cast<size_t>(std::max<int64_t>(0, writers_end_ns - test_origin_ns_) / 1000000000));
+    stats.catch_up_blocks_per_sec_timeline = write_timeline_.window_rates(first, last, kCatchUpWindowSeconds);
+    if (!stats.catch_up_blocks_per_sec_timeline.empty()) {
+        std::vector<double> sorted = stats.catch_up_blocks_per_sec_timeline;
+        std::sort(sorted.begin(), sorted.end());
+        stats.catch_up_window_min_blocks_per_sec = sorted.front();
+        stats.catch_up_window_p50_blocks_per_sec = sorted[sorted.size() / 2];
+        stats.catch_up_window_max_blocks_per_sec = sorted.back();
+    }
+
+    // 与追块阶段重叠的写停顿，按重叠部分计时
+    if (auto event_log = db_manager_->get_event_log()) {
+        for (const auto& window : event_log->stall_windows(writers_end_ns)) {
+            int64_t from = std::max(window.start_ns, writers_start_ns);
+            int64_t to = std::min(window.end_ns, writers_end_ns);
+            if (to < from) {
+                continue;
+            }
+            stats.write_stall_count++;
+            stats.write_stall_seconds += (to - from) / 1e9;
+        }
+        stats.write_stall_share = stats.catch_up_seconds > 0 ? stats.write_stall_seconds / stats.catch_up_seconds
+                                                             : 0.0;
+    }
 
-        size_t size = sorted_latencies.size();
-        stats.query_p50_ms = sorted_latencies[size * 0.5];
-        stats.query_p95_ms = sorted_latencies[size * 0.95];
-        stats.query_p99_ms = sorted_latencies[size * 0.99];
-        stats.query_min_ms = sorted_latencies.front();
-        stats.query_max_ms = sorted_latencies.back();
+    std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+    LatencyHistogram baseline;
+    for (const auto& histogram : reader_baseline_histograms_) {
+        baseline.merge_from(*histogram);
+    }
+    stats.baseline_queries = baseline.count();
+    if (baseline.count() > 0) {
+        stats.baseline_query_rate = baseline_seconds > 0 ? baseline.count() / baseline_seconds : 0.0;
+        stats.baseline_p50_ms = baseline.percentile_ms(50.0);
+        stats.baseline_p99_ms = baseline.percentile_ms(99.0);
+        stats.baseline_max_ms = baseline.max() / 1e6;
+    }
+}
+
+// 写停顿窗口与延迟尖峰的对应关系
+void StrategyScenarioRunner::report_stall_correlation(int64_t end_ns) const {
+    auto event_log = db_manager_->get_event_log();
+    if (!event_log || query_timeline_.size() == 0) {
+        return;
+    }
+
+    auto totals = event_log->totals();
+    utils::log_info("=== RocksDB Event Timeline ===");
+    utils::log_info("Flushes: {} ({:.1f} MB written)", totals.flushes, totals.flush_bytes_written / 1048576.0);
+    utils::log_info("Compactions: {} ({:.1f} s, {:.1f} MB read, {:.1f} MB written)", totals.compactions,
+                   totals.compaction_micros / 1e6, totals.compaction_bytes_read / 1048576.0,
+                   totals.compaction_bytes_written / 1048576.0);
+
+    // 只看与本次测试重叠的停顿窗口
+    std::vector<StallWindow> windows;
+    for (const auto& window : event_log->stall_windows(end_ns)) {
+        if (window.end_ns >= test_origin_ns_ && window.start_ns <= end_ns) {
+            windows.push_back(window);
+        }
+    }
+
+    // 停顿窗口内/外的延迟对比：按秒聚合，窗口覆盖的整秒都算作停顿期
+    size_t seconds = std::min<size_t>(query_timeline_.size(),
+                                      static_cast<size_t>((end_ns - test_origin_ns_) / 1000000000) + 1);
+    std::vector<bool> stalled(seconds, false);
+    for (const auto& window : windows) {
+        size_t first = static_cast<size_t>(std::max<int64_t>(0, window.start_ns - test_origin_ns_) / 1000000000);
+        size_t last = static_cast<size_t>(std::max<int64_t>(0, window.end_ns - test_origin_ns_) / 1000000000);
+        for (size_t s = first; s <= last && s < seconds; ++s) {
+            stalled[s] = true;
+        }
+    }
+    LatencyTimeline::Second query_in, query_out, write_in, write_out;
+    size_t stalled_seconds = 0;
+    auto add = [](LatencyTimeline::Second& total, const LatencyTimeline::Second& second) {
+        total.count += second.count;
+        total.sum_ns += second.sum_ns;
+        total.max_ns = std::max(total.max_ns, second.max_ns);
+    };
+    for (size_t s = 0; s < seconds; ++s) {
+        if (stalled[s]) {
+            stalled_seconds++;
+            add(query_in, query_timeline_.at(s));
+            add(write_in, write_timeline_.at(s));
+        } else {
+            add(query_out, query_timeline_.at(s));
+            add(write_out, write_timeline_.at(s));
+        }
+    }
+
+    utils::log_info("=== Write Stall Correlation ===");
+    utils::log_info("Stall windows: {}, stalled seconds: {} of {}", windows.size(), stalled_seconds, seconds);
+    const size_t max_listed = 20;
+    for (size_t i = 0; i < windows.size() && i < max_listed; ++i) {
+        const auto& window = windows[i];
+        auto query = query_timeline_.aggregate(window.start_ns, window.end_ns);
+        auto write = write_timeline_.aggregate(window.start_ns, window.end_ns);
+        utils::log_info("  [{:>8.1f}s +{:.1f}s] {} {}: queries {} avg {:.3f} ms max {:.3f} ms, "
+                       "writes {} avg {:.3f} ms max {:.3f} ms",
+                       (window.start_ns - test_origin_ns_) / 1e9, (window.end_ns - window.start_ns) / 1e9,
+                       window.db_name, window.condition, query.count, query.avg_ms(), query.max_ms(),
+                       write.count, write.avg_ms(), write.max_ms());
+    }
+    if (windows.size() > max_listed) {
+        utils::log_info("  ... {} more stall windows in the event log", windows.size() - max_listed);
+    }
+    utils::log_info("Query latency: during stalls avg {:.3f} ms max {:.3f} ms, otherwise avg {:.3f} ms max {:.3f} ms",
+                   query_in.avg_ms(), query_in.max_ms(), query_out.avg_ms(), query_out.max_ms());
+    utils::log_info("Write latency: during stalls avg {:.3f} ms max {:.3f} ms, otherwise avg {:.3f} ms max {:.3f} ms",
+                   write_in.avg_ms(), write_in.max_ms(), write_out.avg_ms(), write_out.max_ms());
+
+    // 最慢的几秒：标出同时发生的停顿、flush和compaction
+    std::vector<size_t> order(seconds);
+    std::iota(order.begin(), order.end(), 0);
+    size_t top = std::min<size_t>(5, seconds);
+    std::partial_sort(order.begin(), order.begin() + top, order.end(), [this](size_t a, size_t b) {
+        return query_timeline_.at(a).max_ns > query_timeline_.at(b).max_ns;
+    });
+    utils::log_info("Slowest query seconds:");
+    for (size_t i = 0; i < top; ++i) {
+        size_t s = order[i];
+        auto second = query_timeline_.at(s);
+        if (second.count == 0) {
+            break;
+        }
+        int64_t from = test_origin_ns_ + static_cast<int64_t>(s) * 1000000000;
+        size_t flushes = 0;
+        size_t compactions = 0;
+        for (const auto& event : event_log->events_between(from, from + 1000000000)) {
+            flushes += event.type == DBEvent::Type::kFlush;
+            compactions += event.type == DBEvent::Type::kCompaction;
+        }
+        utils::log_info("  t={}s max {:.3f} ms avg {:.3f} ms ({} queries){}, flushes {}, compactions {}",
+                       s, second.max_ms(), second.avg_ms(), second.count,
+                       stalled[s] ? ", write stall" : "", flushes, compactions);
+    }
+}
+
+// 事件时间线写到logs/<strategy>_events_<time>.jsonl
+AmplificationReport StrategyScenarioRunner::build_amplification_report() const {
+    uint64_t queries = 0;
+    uint64_t sampled_io_bytes = 0;
+    size_t sampled_queries = 0;
+    {
+        std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+        for (const auto& histogram : reader_histograms_) {
+            queries += histogram->count();
+        }
+        for (const auto& sample : perf_samples_) {
+            sampled_io_bytes += sample.total.io_bytes_read;
+        }
+        sampled_queries = perf_samples_.size();
+    }
+    AmplificationReport report(db_manager_->sample_runtime_metrics(), read_baseline_,
+                               logical_bytes_written_.load(), queries);
+    if (sampled_queries > 0) {
+        report.set_sampled_io_bytes_per_query(static_cast<double>(sampled_io_bytes) / sampled_queries);
+    }
+    return report;
+}
+
+StrategyDBManager::MemoryUsageSample StrategyScenarioRunner::sample_memory_usage() const {
+    auto sample = db_manager_->sample_memory_usage();
+    sample.components.emplace_back("key_table", key_table_bytes_);
+
+    // write_latency_histogram_ + block_read_histogram_ + block_execution_histogram_ + 三个写入阶段直方图
+    uint64_t histogram_bytes = 6 * LatencyHistogram::memory_bytes();
+    uint64_t perf_sample_bytes = 0;
+    {
+        std::lock_guard<InstrumentedMutex> lock(query_merge_mutex_);
+        histogram_bytes += (reader_histograms_.size() + reader_service_histograms_.size() +
+                            reader_age_histograms_.size() + reader_op_histograms_.size() +
+                            reader_baseline_histograms_.size()) *
+                           LatencyHistogram::memory_bytes();
+        perf_sample_bytes = perf_samples_.capacity() * sizeof(query_perf::Sample);
+        for (const auto& perf_sample : perf_samples_) {
+            perf_sample_bytes += perf_sample.stages.capacity() * sizeof(query_perf::StageCounters);
+        }
+    }
+    sample.components.emplace_back("latency_histograms", histogram_bytes);
+    sample.components.emplace_back("latency_timelines",
+                                   query_timeline_.memory_bytes() + write_timeline_.memory_bytes());
+    sample.components.emplace_back("perf_samples", perf_sample_bytes);
+    return sample;
+}
+
+void StrategyScenarioRunner::print_memory_usage(const std::string& phase) const {
+    auto sample = sample_memory_usage();
+    auto mb = [](uint64_t bytes) { return bytes / (1024.0 * 1024.0); };
+
+    utils::log_info("=== Memory Usage ({}) ===", phase);
+    for (const auto& db : sample.dbs) {
+        utils::log_info("  {:<16} memtables {:.1f} MB (unflushed {:.1f} MB), table readers {:.1f} MB, cache {:.1f} MB",
+                       db.name, mb(db.memtable_total), mb(db.memtable_unflushed),
+                       mb(db.table_readers), mb(db.cache_total));
+    }
+    for (const auto& [name, bytes] : sample.components) {
+        utils::log_info("  {:<20} {:.1f} MB", name, mb(bytes));
+    }
+    uint64_t accounted = sample.rocksdb_bytes() + sample.components_bytes();
+    utils::log_info("  RocksDB total: {:.1f} MB, in-process structures: {:.1f} MB",
+                   mb(sample.rocksdb_bytes()), mb(sample.components_bytes()));
+    utils::log_info("  Process RSS: {:.1f} MB (peak {:.1f} MB), unaccounted: {:.1f} MB",
+                   mb(sample.rss_bytes), mb(sample.peak_rss_bytes),
+                   mb(sample.rss_bytes > accounted ? sample.rss_bytes - accounted : 0));
+}
+
+nlohmann::ordered_json StrategyScenarioRunner::memory_usage_to_json(const StrategyDBManager::MemoryUsageSample& sample) {
+    nlohmann::ordered_json dbs = nlohmann::ordered_json::object();
+    for (const auto& db : sample.dbs) {
+        dbs[db.name] = {
+            {"memtable_bytes", db.memtable_total},
+            {"memtable_unflushed_bytes", db.memtable_unflushed},
+            {"table_readers_bytes", db.table_readers},
+            {"cache_bytes", db.cache_total},
+        };
+    }
+    nlohmann::ordered_json components = nlohmann::ordered_json::object();
+    for (const auto& [name, bytes] : sample.components) {
+        components[name] = bytes;
+    }
+    uint64_t accounted = sample.rocksdb_bytes() + sample.components_bytes();
+    return {
+        {"rss_bytes", sample.rss_bytes},
+        {"peak_rss_bytes", sample.peak_rss_bytes},
+        {"rocksdb_bytes", sample.rocksdb_bytes()},
+        {"components_bytes", sample.components_bytes()},
+        {"unaccounted_bytes", sample.rss_bytes > accounted ? sample.rss_bytes - accounted : 0},
+        {"dbs", std::move(dbs)},
+        {"components", std::move(components)},
+    };
+}
+
+void StrategyScenarioRunner::write_event_log(int64_t end_ns) const {
+    auto event_log = db_manager_->get_event_log();
+    if (!event_log) {
+        return;
+    }
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::ostringstream oss;
+    oss << "logs/" << db_manager_->get_strategy_name() << "_events_"
+        << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".jsonl";
+    if (event_log->write_jsonl(oss.str(), test_origin_ns_)) {
+        utils::log_info("RocksDB event timeline written to {}", oss.str());
+    }
+}
+
+// 导出JSON结果文件
+void StrategyScenarioRunner::export_results(const ConcurrentTestConfig& test_config, const PerformanceStats& stats) {
+    std::string output_path = config_.result_file;
+    if (output_path.empty()) {
+        auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::ostringstream oss;
+        oss << "logs/" << db_manager_->get_strategy_name()
+            << (workload_preset_ ? "_" + workload_preset_->name : std::string())
+            << (scenario_phase_.empty() ? std::string() : "_" + scenario_phase_) << "_result_"
+            << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".json";
+        output_path = oss.str();
+    }
+
+    nlohmann::ordered_json document;
+    document["schema_version"] = result_document::kSchemaVersion;
+    document["tool"] = "rocksdb_bench_app";
+    {
+        auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::ostringstream oss;
+        oss << std::put_time(std::gmtime(&now), "%Y-%m-%dT%H:%M:%SZ");
+        document["timestamp"] = oss.str();
+    }
+    document["build"] = result_document::build_info_json();
+    document["hardware"] = result_document::hardware_info_json();
+    document["config"] = config_.to_json();
+    document["strategy"] = db_manager_->get_strategy_name();
+    if (!scenario_phase_.empty()) {
+        document["phase"] = scenario_phase_;
+    }
+
+    document["test"] = {
+        {"duration_seconds", stats.test_duration_seconds},
+        {"reader_threads", stats.reader_thread_count},
+        {"writer_threads", stats.writer_thread_count},
+        {"write_sleep_seconds", test_config.write_sleep_seconds},
+        {"block_size", test_config.block_size},
+        {"query_load", test_config.target_query_rate > 0 ? "open_loop" : "closed_loop"},
+        {"arrival_process", test_config.poisson_arrivals ? "poisson" : "fixed"},
+        {"initial_load_end_block", initial_load_end_block_},
+        {"final_max_block", current_max_block_.load()},
+        {"write_failed", stats.write_failed},
+    };
+
+    if (initial_load_stats_.blocks_written > 0) {
+        document["initial_load"] = {
+            {"producer_threads", initial_load_stats_.producer_threads},
+            {"blocks_written", initial_load_stats_.blocks_written},
+            {"records_written", initial_load_stats_.records_written},
+            {"wall_seconds", initial_load_stats_.wall_seconds},
+            {"records_per_sec", initial_load_stats_.wall_seconds > 0
+                                    ? initial_load_stats_.records_written / initial_load_stats_.wall_seconds
+                                    : 0.0},
+        };
+    }
+
+    document["summary"] = {
+        {"total_query_ops", stats.total_query_ops},
+        {"successful_queries", stats.successful_queries},
+        {"query_success_rate", stats.query_success_rate},
+        {"query_ops_per_sec", stats.query_ops_per_sec},
+        {"query_avg_ms", stats.query_avg_ms},
+        {"query_p50_ms", stats.query_p50_ms},
+        {"query_p90_ms", stats.query_p90_ms},
+        {"query_p99_ms", stats.query_p99_ms},
+        {"query_p999_ms", stats.query_p999_ms},
+        {"query_p9999_ms", stats.query_p9999_ms},
+        {"query_max_ms", stats.query_max_ms},
+        {"total_write_ops", stats.total_write_ops},
+        {"total_write_records", stats.total_write_records},
+        {"write_ops_per_sec", stats.write_ops_per_sec},
+        {"write_kv_per_sec", stats.write_records_per_sec},
+        {"write_avg_ms", stats.write_avg_ms},
+        {"write_p50_ms", stats.write_p50_ms},
+        {"write_p99_ms", stats.write_p99_ms},
+        {"write_p999_ms", stats.write_p999_ms},
+        {"write_max_ms", stats.write_max_ms},
+        {"write_duplicate_rate", stats.write_duplicate_rate},
+    };
+    if (stats.open_loop) {
+        document["summary"]["offered_query_rate"] = stats.offered_query_rate;
+        document["summary"]["service_p50_ms"] = stats.service_p50_ms;
+        document["summary"]["service_p99_ms"] = stats.service_p99_ms;
+        document["summary"]["service_p999_ms"] = stats.service_p999_ms;
+    }
+
+    nlohmann::ordered_json version_age = nlohmann::ordered_json::array();
+    for (const auto& row : stats.version_age_latency) {
+        version_age.push_back({
+            {"age_blocks", row.bucket},
+            {"count", row.count},
+            {"avg_ms", row.avg_ms},
+            {"p50_ms", row.p50_ms},
+            {"p99_ms", row.p99_ms},
+            {"max_ms", row.max_ms},
+        });
+    }
+    document["query_latency_by_version_age"] = std::move(version_age);
+
+    if (workload_preset_) {
+        nlohmann::ordered_json mix = nlohmann::ordered_json::object();
+        for (size_t op = 0; op < kReadOperationCount; ++op) {
+            mix[read_operation_name(static_cast<ReadOperation>(op))] =
+                workload_preset_->mix.share(static_cast<ReadOperation>(op));
+        }
+        nlohmann::ordered_json operations = nlohmann::ordered_json::array();
+        for (const auto& row : stats.operation_latency) {
+            operations.push_back({
+                {"operation", row.operation},
+                {"count", row.count},
+                {"found_rate", row.found_rate},
+                {"items_per_op", row.items_per_op},
+                {"avg_ms", row.avg_ms},
+                {"p50_ms", row.p50_ms},
+                {"p99_ms", row.p99_ms},
+                {"max_ms", row.max_ms},
+            });
+        }
+        document["workload"] = {
+            {"preset", workload_preset_->name},
+            {"description", workload_preset_->description},
+            {"read_mix", std::move(mix)},
+            {"scan_window_blocks", workload_preset_->scan_window_blocks},
+            {"scan_limit", workload_preset_->scan_limit},
+            {"operations", std::move(operations)},
+        };
+    }
+
+    if (stats.read_before_write) {
+        document["block_execution"] = {
+            {"read_batch", config_.read_batch},
+            {"execution_avg_ms", stats.block_execution_avg_ms},
+            {"execution_p50_ms", stats.block_execution_p50_ms},
+            {"execution_p99_ms", stats.block_execution_p99_ms},
+            {"execution_max_ms", stats.block_execution_max_ms},
+            {"read_avg_ms", stats.block_read_avg_ms},
+            {"read_p50_ms", stats.block_read_p50_ms},
+            {"read_p99_ms", stats.block_read_p99_ms},
+            {"write_avg_ms", stats.write_avg_ms},
+            {"write_p99_ms", stats.write_p99_ms},
+            {"read_share", stats.block_read_share},
+            {"reads", stats.block_reads},
+            {"read_found_rate", stats.block_read_found_rate},
+        };
+    }
+
+    if (stats.catch_up) {
+        document["catch_up"] = {
+            {"target_blocks_per_sec", stats.catch_up_target_block_rate},
+            {"seconds", stats.catch_up_seconds},
+            {"blocks_per_sec", stats.catch_up_blocks_per_sec},
+            {"kv_per_sec", stats.catch_up_kv_per_sec},
+            {"window_seconds", kCatchUpWindowSeconds},
+            {"window_min_blocks_per_sec", stats.catch_up_window_min_blocks_per_sec},
+            {"window_p50_blocks_per_sec", stats.catch_up_window_p50_blocks_per_sec},
+            {"window_max_blocks_per_sec", stats.catch_up_window_max_blocks_per_sec},
+            {"blocks_per_sec_timeline", stats.catch_up_blocks_per_sec_timeline},
+            {"write_stalls", stats.write_stall_count},
+            {"write_stall_seconds", stats.write_stall_seconds},
+            {"write_stall_share", stats.write_stall_share},
+            {"baseline_queries", stats.baseline_queries},
+            {"baseline_query_rate", stats.baseline_query_rate},
+            {"baseline_p50_ms", stats.baseline_p50_ms},
+            {"baseline_p99_ms", stats.baseline_p99_ms},
+            {"baseline_max_ms", stats.baseline_max_ms},
+            {"catch_up_query_rate", stats.catch_up_query_rate},
+            {"catch_up_p50_ms", stats.query_p50_ms},
+            {"catch_up_p99_ms", stats.query_p99_ms},
+            {"catch_up_max_ms", stats.query_max_ms},
+        };
+    }
+
+    document["cpu"] = {
+        {"process_cpu_seconds", stats.process_cpu_seconds},
+        {"reader_cpu_seconds", stats.reader_cpu_seconds},
+        {"writer_cpu_seconds", stats.writer_cpu_seconds},
+        {"background_cpu_seconds", stats.background_cpu_seconds},
+        {"background_cpu_share", stats.background_cpu_share},
+        {"cores_used", stats.cores_used},
+        {"cpu_us_per_query", stats.cpu_us_per_query},
+        {"cpu_us_per_write_record", stats.cpu_us_per_write_record},
+    };
+
+    LatencyHistogram query_histogram;
+    LatencyHistogram write_histogram;
+    snapshot_latency_histograms(query_histogram, write_histogram);
+    document["histograms"] = {
+        {"query_latency", result_document::histogram_to_json(query_histogram)},
+        {"write_latency", result_document::histogram_to_json(write_histogram)},
+    };
+
+    nlohmann::ordered_json intervals = nlohmann::ordered_json::array();
+    {
+        std::lock_guard<std::mutex> lock(sampler_mutex_);
+        for (const auto& sample : interval_throughput_) {
+            intervals.push_back({
+                {"elapsed_s", sample.elapsed_s},
+                {"interval_s", sample.interval_s},
+                {"query_ops_per_sec", sample.query_ops_per_sec},
+                {"write_blocks_per_sec", sample.write_blocks_per_sec},
+                {"write_kv_per_sec", sample.write_kv_per_sec},
+            });
+        }
+    }
+    document["intervals"] = std::move(intervals);
+
+    if (perf_sample_rate_ > 0) {
+        document["query_perf"] = build_query_perf_report().to_json();
+        document["query_perf"]["sample_rate"] = perf_sample_rate_;
+    }
+
+    // RocksDB事件汇总和写停顿窗口（相对测试开始的秒数）
+    auto event_log = db_manager_->get_event_log();
+    if (event_log) {
+        auto totals = event_log->totals();
+        nlohmann::ordered_json windows = nlohmann::ordered_json::array();
+        int64_t end_ns = DBEventLog::now_ns();
+        for (const auto& window : event_log->stall_windows(end_ns)) {
+            if (window.end_ns < test_origin_ns_) {
+                continue;
+            }
+            windows.push_back({
+                {"db", window.db_name},
+                {"condition", window.condition},
+                {"start_s", (window.start_ns - test_origin_ns_) / 1e9},
+                {"duration_s", (window.end_ns - window.start_ns) / 1e9},
+            });
+        }
+        document["events"] = {
+            {"flushes", totals.flushes},
+            {"flush_bytes_written", totals.flush_bytes_written},
+            {"compactions", totals.compactions},
+            {"compaction_seconds", totals.compaction_micros / 1e6},
+            {"compaction_bytes_read", totals.compaction_bytes_read},
+            {"compaction_bytes_written", totals.compaction_bytes_written},
+            {"stall_windows", std::move(windows)},
+        };
+    }
+
+    document["amplification"] = nlohmann::ordered_json::object();
+    if (initial_load_amplification_) {
+        document["amplification"]["initial_load"] = initial_load_amplification_->to_json();
+    }
+    document["amplification"]["end_of_test"] = build_amplification_report().to_json();
+    document["memory"] = memory_usage_to_json(sample_memory_usage());
+
+    if (LockStatsRegistry::enabled()) {
+        nlohmann::ordered_json locks = nlohmann::ordered_json::array();
+        for (const auto& lock : LockStatsRegistry::instance().snapshot()) {
+            locks.push_back({
+                {"name", lock.name},
+                {"acquisitions", lock.acquisitions},
+                {"contended", lock.contended},
+                {"contention_rate", lock.contention_rate()},
+                {"wait_total_ms", lock.wait_total_ns / 1e6},
+                {"wait_p50_us", lock.wait_p50_us},
+                {"wait_p99_us", lock.wait_p99_us},
+                {"wait_max_us", lock.wait_max_us},
+                {"hold_total_ms", lock.hold_total_ns / 1e6},
+                {"hold_p50_us", lock.hold_p50_us},
+                {"hold_p99_us", lock.hold_p99_us},
+                {"hold_max_us", lock.hold_max_us},
+            });
+        }
+        document["locks"] = std::move(locks);
+    }
+
+    if (result_document::write_file(output_path, document)) {
+        utils::log_info("Result document written to {}", output_path);
+    }
+}
+
+// 计算性能统计数据
+void StrategyScenarioRunner::calculate_performance_statistics(PerformanceStats& stats,
+                                                              const LatencyHistogram& query_histogram,
+                                                              const LatencyHistogram& write_histogram) const {
+    // 计算查询性能统计
+    if (query_histogram.count() > 0) {
+        stats.query_avg_ms = query_histogram.mean() / 1e6;
+        stats.query_p50_ms = query_histogram.percentile_ms(50.0);
+        stats.query_p90_ms = query_histogram.percentile_ms(90.0);
+        stats.query_p95_ms = query_histogram.percentile_ms(95.0);
+        stats.query_p99_ms = query_histogram.percentile_ms(99.0);
+        stats.query_p999_ms = query_histogram.percentile_ms(99.9);
+        stats.query_p9999_ms = query_histogram.percentile_ms(99.99);
+        stats.query_min_ms = query_histogram.min() / 1e6;
+        stats.query_max_ms = query_histogram.max() / 1e6;
 
         if (stats.test_duration_seconds > 0) {
             stats.query_ops_per_sec = static_cast<double>(stats.total_query_ops) / stats.test_duration_seconds;
@@ -425,20 +2314,22 @@ void StrategyScenarioRunner::calculate_performance_statistics(PerformanceStats&
     }
 
     // 计算写入性能统计
-    if (!stats.write_latencies_ms.empty()) {
-        std::vector<double> sorted_write_latencies = stats.write_latencies_ms;
-        std::sort(sorted_write_latencies.begin(), sorted_write_latencies.end());
-
-        double sum = std::accumulate(sorted_write_latencies.begin(), sorted_write_latencies.end(), 0.0);
-        stats.write_avg_ms = sum / sorted_write_latencies.size();
-
-        size_t size = sorted_write_latencies.size();
-        stats.write_p50_ms = sorted_write_latencies[size * 0.5];
-        stats.write_p95_ms = sorted_write_latencies[size * 0.95];
-        stats.write_p99_ms = sorted_write_latencies[size * 0.99];
+    if (write_histogram.count() > 0) {
+        stats.write_avg_ms = write_histogram.mean() / 1e6;
+        stats.write_p50_ms = write_histogram.percentile_ms(50.0);
+        stats.write_p90_ms = write_histogram.percentile_ms(90.0);
+        stats.write_p95_ms = write_histogram.percentile_ms(95.0);
+        stats.write_p99_ms = write_histogram.percentile_ms(99.0);
+        stats.write_p999_ms = write_histogram.percentile_ms(99.9);
+        stats.write_p9999_ms = write_histogram.percentile_ms(99.99);
+        stats.write_max_ms = write_histogram.max() / 1e6;
 
         if (stats.test_duration_seconds > 0) {
             stats.write_ops_per_sec = static_cast<double>(stats.total_write_ops) / stats.test_duration_seconds;
+            stats.write_records_per_sec = static_cast<double>(stats.total_write_records) / stats.test_duration_seconds;
+        }
+        if (stats.write_input_records > 0) {
+            stats.write_duplicate_rate = static_cast<double>(stats.write_duplicate_records) / stats.write_input_records;
         }
     }
 }
@@ -446,34 +2337,144 @@ void StrategyScenarioRunner::calculate_performance_statistics(PerformanceStats&
 // 打印性能统计
 void StrategyScenarioRunner::PerformanceStats::print_statistics() const {
     utils::log_info("=== Concurrent Read-Write Performance Statistics ===");
+    if (!phase.empty()) {
+        utils::log_info("Scenario phase: {}", phase);
+    }
     utils::log_info("Test duration: {:.1f} seconds", test_duration_seconds);
     utils::log_info("Write operations: {}", total_write_ops);
+    if (write_failed) {
+        utils::log_error("Writes FAILED: a writer thread could not write its block, the test stopped early");
+    }
     utils::log_info("Query operations: {}", total_query_ops);
     utils::log_info("Successful queries: {}", successful_queries);
 
-    if (!query_latencies_ms.empty()) {
+    if (total_query_ops > 0) {
         utils::log_info("=== Query Performance ===");
         utils::log_info("Count: {}", total_query_ops);
         utils::log_info("Average: {:.3f} ms", query_avg_ms);
         utils::log_info("Min: {:.3f} ms", query_min_ms);
         utils::log_info("Max: {:.3f} ms", query_max_ms);
         utils::log_info("P50: {:.3f} ms", query_p50_ms);
+        utils::log_info("P90: {:.3f} ms", query_p90_ms);
         utils::log_info("P95: {:.3f} ms", query_p95_ms);
         utils::log_info("P99: {:.3f} ms", query_p99_ms);
+        utils::log_info("P99.9: {:.3f} ms", query_p999_ms);
+        utils::log_info("P99.99: {:.3f} ms", query_p9999_ms);
         utils::log_info("Query OPS: {:.2f}", query_ops_per_sec);
         utils::log_info("Success Rate: {:.2f}%", query_success_rate);
+        if (open_loop) {
+            // 上面的延迟从计划发起时刻算起；与服务时间的差距就是排队（被闭环测试掩盖的部分）
+            utils::log_info("Open loop: offered {:.0f} q/s, achieved {:.0f} q/s", offered_query_rate,
+                           query_ops_per_sec);
+            utils::log_info("Service time (excl. queueing): avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms, "
+                           "P99.9 {:.3f} ms, Max {:.3f} ms",
+                           service_avg_ms, service_p50_ms, service_p99_ms, service_p999_ms, service_max_ms);
+        }
+        if (!version_age_latency.empty()) {
+            utils::log_info("Service time by target version age (blocks behind head):");
+            for (const auto& row : version_age_latency) {
+                utils::log_info("  {:>11}: {:>10} queries ({:5.1f}%), avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms, "
+                               "Max {:.3f} ms",
+                               row.bucket, row.count, 100.0 * row.count / total_query_ops, row.avg_ms,
+                               row.p50_ms, row.p99_ms, row.max_ms);
+            }
+        }
+        if (!operation_latency.empty()) {
+            utils::log_info("Service time by operation (workload {}):", workload);
+            for (const auto& row : operation_latency) {
+                utils::log_info("  {:>10}: {:>10} ops ({:5.1f}%), found {:5.1f}%, {:.1f} versions/op, avg {:.3f} ms, "
+                               "P50 {:.3f} ms, P99 {:.3f} ms, Max {:.3f} ms",
+                               row.operation, row.count, 100.0 * row.count / total_query_ops,
+                               row.found_rate * 100.0, row.items_per_op, row.avg_ms, row.p50_ms, row.p99_ms,
+                               row.max_ms);
+            }
+        }
     }
 
-    if (!write_latencies_ms.empty()) {
+    if (total_write_ops > 0) {
         utils::log_info("=== Write Performance ===");
         utils::log_info("Count: {}", total_write_ops);
         utils::log_info("Average: {:.3f} ms", write_avg_ms);
         utils::log_info("P50: {:.3f} ms", write_p50_ms);
+        utils::log_info("P90: {:.3f} ms", write_p90_ms);
         utils::log_info("P95: {:.3f} ms", write_p95_ms);
         utils::log_info("P99: {:.3f} ms", write_p99_ms);
+        utils::log_info("P99.9: {:.3f} ms", write_p999_ms);
+        utils::log_info("P99.99: {:.3f} ms", write_p9999_ms);
+        utils::log_info("Max: {:.3f} ms", write_max_ms);
         utils::log_info("Write OPS: {:.2f}", write_ops_per_sec);
+        utils::log_info("Write throughput: {:.0f} kv/s across {} writer threads", write_records_per_sec,
+                       writer_thread_count);
+        utils::log_info("Coalesced duplicates: {} of {} updates ({:.2f}%), {} Puts written",
+                       write_duplicate_records, write_input_records, write_duplicate_rate * 100.0,
+                       total_write_records);
     }
 
+    if (read_before_write) {
+        // block执行时间 = 读取各slot当前值 + 写入，节点同步速度取决于这个值
+        utils::log_info("=== Block Execution (read-before-write) ===");
+        utils::log_info("Execution: avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms, Max {:.3f} ms",
+                       block_execution_avg_ms, block_execution_p50_ms, block_execution_p99_ms,
+                       block_execution_max_ms);
+        utils::log_info("  Reads:  avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms ({:.1f}% of execution)",
+                       block_read_avg_ms, block_read_p50_ms, block_read_p99_ms, block_read_share * 100.0);
+        utils::log_info("  Writes: avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms", write_avg_ms, write_p50_ms,
+                       write_p99_ms);
+        utils::log_info("Latest-value reads: {} ({:.2f}% found)", block_reads, block_read_found_rate * 100.0);
+    }
+
+    if (catch_up) {
+        utils::log_info("=== Catch-up ({}) ===",
+                       catch_up_target_block_rate > 0 ? fmt::format("target {:.1f} blocks/s", catch_up_target_block_rate)
+                                                      : std::string("unlimited"));
+        utils::log_info("Sustained: {:.2f} blocks/s, {:.0f} kv/s over {:.1f} s", catch_up_blocks_per_sec,
+                       catch_up_kv_per_sec, catch_up_seconds);
+        if (!catch_up_blocks_per_sec_timeline.empty()) {
+            std::string series;
+            for (double rate : catch_up_blocks_per_sec_timeline) {
+                series += fmt::format("{}{:.1f}", series.empty() ? "" : " ", rate);
+            }
+            utils::log_info("Blocks/s per {} s: min {:.2f}, median {:.2f}, max {:.2f}", kCatchUpWindowSeconds,
+                           catch_up_window_min_blocks_per_sec, catch_up_window_p50_blocks_per_sec,
+                           catch_up_window_max_blocks_per_sec);
+            utils::log_info("  {}", series);
+        }
+        utils::log_info("Write stalls: {} windows, {:.1f} s ({:.1f}% of catch-up)", write_stall_count,
+                       write_stall_seconds, write_stall_share * 100.0);
+        if (baseline_queries > 0) {
+            utils::log_info("Queries, readers only: {:.0f} q/s, P50 {:.3f} ms, P99 {:.3f} ms, Max {:.3f} ms",
+                           baseline_query_rate, baseline_p50_ms, baseline_p99_ms, baseline_max_ms);
+        }
+        utils::log_info("Queries, catching up:  {:.0f} q/s, P50 {:.3f} ms, P99 {:.3f} ms, Max {:.3f} ms",
+                       catch_up_query_rate, query_p50_ms, query_p99_ms, query_max_ms);
+        if (baseline_queries > 0 && baseline_p99_ms > 0) {
+            utils::log_info("Reader P99 impact: x{:.2f}", query_p99_ms / baseline_p99_ms);
+        }
+    }
+
+    if (write_stage_count > 0) {
+        utils::log_info("=== Write Stage Breakdown ===");
+        utils::log_info("Range index write: avg {:.3f} ms, P99 {:.3f} ms", write_range_avg_ms, write_range_p99_ms);
+        utils::log_info("Data write: avg {:.3f} ms, P99 {:.3f} ms", write_data_avg_ms, write_data_p99_ms);
+        utils::log_info("Overlap: avg {:.3f} ms ({:.1f}% of serial range+data time)",
+                       write_overlap_avg_ms, write_overlap_ratio * 100.0);
+    }
+
+    if (process_cpu_seconds > 0) {
+        utils::log_info("=== CPU Efficiency ===");
+        utils::log_info("Process CPU: {:.1f} s ({:.2f} cores), readers {:.1f} s, writers {:.1f} s, background {:.1f} s ({:.1f}%)",
+                       process_cpu_seconds, cores_used, reader_cpu_seconds, writer_cpu_seconds,
+                       background_cpu_seconds, background_cpu_share * 100.0);
+        utils::log_info("CPU per query: {:.2f} us, CPU per written record: {:.2f} us",
+                       cpu_us_per_query, cpu_us_per_write_record);
+    }
+
+    // 单行汇总，便于对比不同写线程数下的写吞吐与读延迟
+    utils::log_info("Writer scaling: writers={} readers={} write_blocks/s={:.3f} write_kv/s={:.0f} "
+                   "write_p99_ms={:.3f} query_ops/s={:.1f} query_p50_ms={:.3f} query_p99_ms={:.3f}",
+                   writer_thread_count, reader_thread_count, write_ops_per_sec, write_records_per_sec,
+                   write_p99_ms, query_ops_per_sec, query_p50_ms, query_p99_ms);
+
     utils::log_info("=== End Statistics ===");
 }
 
@@ -504,12 +2505,14 @@ void StrategyScenarioRunner::collect_rocksdb_statistics() {
     utils::log_info("Compaction Summary: bytes_read={}, bytes_written={}, time_micros={}",
                    compaction_stats.bytes_read, compaction_stats.bytes_written, compaction_stats.time_micros);
 
-    if (compaction_stats.bytes_read > 0) {
-        // Estimate compaction count and record metrics
-        size_t compaction_count = compaction_stats.bytes_read / (10 * 1024 * 1024); // Rough estimate
-        for (size_t i = 0; i < compaction_count; ++i) {
-            double avg_time = static_cast<double>(compaction_stats.time_micros) / compaction_count / 1000.0;
-            metrics_collector_->record_compaction(avg_time, compaction_stats.bytes_read / compaction_count, 2);
+    // 每次compaction的实际耗时、字节数和层级来自EventListener
+    if (auto event_log = db_manager_->get_event_log()) {
+        for (const auto& event : event_log->events()) {
+            if (event.type == DBEvent::Type::kCompaction) {
+                size_t levels = event.output_level >= event.input_level
+                    ? static_cast<size_t>(event.output_level - event.input_level + 1) : 1;
+                metrics_collector_->record_compaction(event.duration_ms(), event.bytes_read, levels);
+            }
         }
     }
 }
@@ -3,6 +3,17 @@
 #include "metrics_collector.hpp"
 #include "../utils/data_generator.hpp"
 #include "../core/config.hpp"
+#include "../utils/latency_histogram.hpp"
+#include "../utils/latency_timeline.hpp"
+#include "../utils/instrumented_mutex.hpp"
+#include "../utils/key_distribution.hpp"
+#include "../utils/version_distribution.hpp"
+#include "../core/query_perf_context.hpp"
+#include "query_perf_report.hpp"
+#include "amplification_report.hpp"
+#include "workload_trace.hpp"
+#include "workload_preset.hpp"
+#include "scenario.hpp"
 #include <memory>
 #include <chrono>
 #include <vector>
@@ -10,6 +21,8 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <set>
+#include <condition_variable>
 
 class StrategyScenarioRunner {
 public:
@@ -19,7 +32,17 @@ public:
         size_t queries_per_thread = 200;       // 每个读线程的查询次数
         size_t test_duration_seconds = 3600;   // 测试持续时间（秒）
         size_t write_sleep_seconds = 3;        // 写线程sleep时间
+        size_t writer_thread_count = 1;        // 写线程数量，共享一个原子block计数器
+        size_t sample_interval_seconds = 0;    // 时间序列采样间隔（0=关闭）
+        std::string timeseries_file;           // 时间序列输出文件
         size_t block_size = 10000;             // 每个block的kv数量
+        double target_query_rate = 0.0;        // 开环：所有读线程合计的目标查询速率（0=闭环）
+        bool poisson_arrivals = false;         // 开环到达过程：true=泊松，false=等间隔
+        bool write_result_file = true;         // 测试结束后写出JSON结果文件（SLO扫描的单步不写）
+        size_t perf_sample_rate = 0;           // 每N次查询采样一次RocksDB内部计数（0=关闭）
+        bool catch_up = false;                 // 追块模式：写线程不sleep，连续写block
+        double catch_up_block_rate = 0.0;      // 追块模式所有写线程合计的目标block速率（0=不限速）
+        size_t catch_up_baseline_seconds = 0;  // 追块前读线程单独运行的秒数（查询延迟基线）
 
         // 获取推荐的读线程数量（CPU核心数的2倍）
         static size_t get_recommended_reader_threads() {
@@ -53,6 +76,15 @@ public:
             // 注意：reader_thread_count 现在不再使用，实际线程数由 get_recommended_reader_threads() 动态计算
             test_config.reader_thread_count = 0; // 这个值现在被忽略
             test_config.test_duration_seconds = config.continuous_duration_minutes * 60;
+            test_config.writer_thread_count = config.writer_threads;
+            test_config.sample_interval_seconds = config.sample_interval_seconds;
+            test_config.timeseries_file = config.timeseries_file;
+            test_config.target_query_rate = config.query_rate;
+            test_config.poisson_arrivals = config.arrival_process == "poisson";
+            test_config.perf_sample_rate = config.perf_sample_rate;
+            test_config.catch_up = config.catch_up;
+            test_config.catch_up_block_rate = config.catch_up_block_rate;
+            test_config.catch_up_baseline_seconds = config.catch_up_baseline_seconds;
             return test_config;
         }
     };
@@ -71,12 +103,50 @@ public:
 
     void run_initial_load_phase();
 
+    // Initial load阶段耗时分解
+    struct InitialLoadPhaseStats {
+        size_t producer_threads = 0;
+        size_t buffer_count = 0;
+        size_t blocks_written = 0;
+        size_t records_written = 0;
+        double wall_seconds = 0.0;
+        double generate_ms = 0.0;            // 生产者生成records的耗时（所有线程累加）
+        double producer_wait_ms = 0.0;       // 生产者等待空闲buffer（消费/写入侧慢）
+        double consumer_wait_ms = 0.0;       // 消费者等待已生成block（生成侧慢）
+        double strategy_call_ms = 0.0;       // write_initial_load_batch耗时（编码+背压）
+        std::optional<InitialLoadStats> strategy_stats;  // 策略内部的编码/提交耗时
+
+        void print_statistics() const;
+    };
+
+    const InitialLoadPhaseStats& get_initial_load_stats() const { return initial_load_stats_; }
+
     // 新的并发读写测试接口
+    // 有写线程写入失败时，统计和结果文件照常输出，之后抛出std::runtime_error
     void run_concurrent_read_write_test(const ConcurrentTestConfig& test_config);
 
     // 兼容性接口 - 从旧的continuous_duration_minutes转换
     void run_continuous_update_query_loop(size_t duration_minutes = 360);
 
+    // SLO扫描的一个点：开环offered速率下的实际吞吐和延迟
+    struct SloSweepPoint {
+        double offered_rate = 0.0;
+        double achieved_rate = 0.0;
+        double p50_ms = 0.0;
+        double p99_ms = 0.0;
+        double p999_ms = 0.0;
+        double service_p99_ms = 0.0;   // 不含排队的服务时间
+        double write_kv_per_sec = 0.0;
+        bool meets_slo = false;
+    };
+
+    // 从config的sweep_start_rate开始按sweep_rate_factor逐步提高开环查询速率，
+    // 每步运行sweep_step_seconds，直到p99超过slo_p99_ms或吞吐跟不上offered速率
+    std::vector<SloSweepPoint> run_slo_sweep();
+
+    // 依次运行标准工作负载预设（W-A … W-F），每个预设workload_seconds秒、单独输出结果文件，最后汇总对比
+    void run_workload_suite(const std::vector<std::string>& preset_names);
+
     // Collect real RocksDB statistics
     void collect_rocksdb_statistics();
 
@@ -86,75 +156,319 @@ public:
     // 获取性能统计结果
     struct PerformanceStats {
         size_t total_write_ops = 0;
+        size_t writer_thread_count = 1;
+        size_t reader_thread_count = 0;
+        size_t total_write_records = 0;
         size_t total_query_ops = 0;
         size_t successful_queries = 0;
         double test_duration_seconds = 0.0;
 
-        // 查询性能
-        std::vector<double> query_latencies_ms;
+        // 查询性能（来自对数分桶直方图，百分位相对误差<1%）
         double query_avg_ms = 0.0;
         double query_p50_ms = 0.0;
+        double query_p90_ms = 0.0;
         double query_p95_ms = 0.0;
         double query_p99_ms = 0.0;
+        double query_p999_ms = 0.0;
+        double query_p9999_ms = 0.0;
         double query_min_ms = 0.0;
         double query_max_ms = 0.0;
         double query_ops_per_sec = 0.0;
         double query_success_rate = 0.0;
 
+        // 开环模式：上面的查询延迟从计划发起时刻算起（含排队），这里是不含排队的服务时间
+        bool open_loop = false;
+        double offered_query_rate = 0.0;
+        double service_avg_ms = 0.0;
+        double service_p50_ms = 0.0;
+        double service_p99_ms = 0.0;
+        double service_p999_ms = 0.0;
+        double service_max_ms = 0.0;
+
         // 写入性能
-        std::vector<double> write_latencies_ms;
         double write_avg_ms = 0.0;
         double write_p50_ms = 0.0;
+        double write_p90_ms = 0.0;
         double write_p95_ms = 0.0;
         double write_p99_ms = 0.0;
+        double write_p999_ms = 0.0;
+        double write_p9999_ms = 0.0;
+        double write_max_ms = 0.0;
         double write_ops_per_sec = 0.0;
+        bool write_failed = false;             // 有写线程写入失败，测试提前结束
+        double write_records_per_sec = 0.0;    // 所有写线程合计的kv吞吐
+        size_t write_input_records = 0;        // 合并前的更新数
+        size_t write_duplicate_records = 0;    // block内重复key被合并掉的更新数
+        double write_duplicate_rate = 0.0;
+
+        // 写入阶段分解（仅多DB策略，例如dual的range index / data两路写入）
+        size_t write_stage_count = 0;          // 有阶段分解的block数
+        double write_range_avg_ms = 0.0;
+        double write_range_p99_ms = 0.0;
+        double write_data_avg_ms = 0.0;
+        double write_data_p99_ms = 0.0;
+        double write_overlap_avg_ms = 0.0;
+        double write_overlap_ratio = 0.0;   // 重叠时间占range+data串行耗时的比例
+
+        // read-before-write：block执行时间 = 读取各slot最新值 + 写入（写入部分即上面的写延迟）
+        bool read_before_write = false;
+        double block_read_avg_ms = 0.0;
+        double block_read_p50_ms = 0.0;
+        double block_read_p99_ms = 0.0;
+        double block_execution_avg_ms = 0.0;
+        double block_execution_p50_ms = 0.0;
+        double block_execution_p99_ms = 0.0;
+        double block_execution_max_ms = 0.0;
+        double block_read_share = 0.0;       // 读取时间占block执行时间的比例
+        size_t block_reads = 0;
+        double block_read_found_rate = 0.0;
+
+        // 追块模式：写线程连续写block时的持续吞吐、写停顿时间，以及与只有读线程时相比的查询延迟
+        bool catch_up = false;
+        double catch_up_target_block_rate = 0.0;        // 0=不限速
+        double catch_up_seconds = 0.0;                  // 写线程运行的墙钟时间
+        double catch_up_blocks_per_sec = 0.0;           // 全程平均
+        double catch_up_kv_per_sec = 0.0;
+        double catch_up_window_min_blocks_per_sec = 0.0;   // 按kCatchUpWindowSeconds秒窗口统计
+        double catch_up_window_p50_blocks_per_sec = 0.0;
+        double catch_up_window_max_blocks_per_sec = 0.0;
+        std::vector<double> catch_up_blocks_per_sec_timeline;
+        size_t write_stall_count = 0;                   // 与追块阶段重叠的写停顿窗口（各DB分别计）
+        double write_stall_seconds = 0.0;
+        double write_stall_share = 0.0;                 // 停顿时间占追块时间的比例
+        uint64_t baseline_queries = 0;                  // 基线阶段的查询，不计入上面的总体查询统计
+        double baseline_query_rate = 0.0;
+        double baseline_p50_ms = 0.0;
+        double baseline_p99_ms = 0.0;
+        double baseline_max_ms = 0.0;
+        double catch_up_query_rate = 0.0;
+
+        // CPU效率：读写线程按CLOCK_THREAD_CPUTIME_ID计量，进程总量来自getrusage；写线程包含dual并行提交时
+        // CommitExecutor代其执行的data写入。后台 = 进程 - 读写线程 - 采样线程，主要是RocksDB的flush/compaction
+        double reader_cpu_seconds = 0.0;
+        double writer_cpu_seconds = 0.0;
+        double process_cpu_seconds = 0.0;
+        double background_cpu_seconds = 0.0;
+        double cpu_us_per_query = 0.0;
+        double cpu_us_per_write_record = 0.0;
+        double background_cpu_share = 0.0;   // 后台CPU占进程CPU的比例
+        double cores_used = 0.0;             // 进程CPU时间 / 测试墙钟时间
+
+        // 按目标版本年龄（head - target_version）分桶的服务时间，空桶不输出
+        struct VersionAgeLatency {
+            std::string bucket;
+            uint64_t count = 0;
+            double avg_ms = 0.0;
+            double p50_ms = 0.0;
+            double p99_ms = 0.0;
+            double max_ms = 0.0;
+        };
+        std::vector<VersionAgeLatency> version_age_latency;
+
+        // 工作负载预设：按读操作类型统计的服务时间，只输出发生过的操作
+        struct OperationLatency {
+            std::string operation;
+            uint64_t count = 0;
+            double found_rate = 0.0;
+            double items_per_op = 0.0;   // 扫描：平均返回的版本数；点查等于found_rate
+            double avg_ms = 0.0;
+            double p50_ms = 0.0;
+            double p99_ms = 0.0;
+            double max_ms = 0.0;
+        };
+        std::string workload;            // 预设名称，未使用预设时为空
+        std::vector<OperationLatency> operation_latency;
+
+        std::string phase;               // 场景阶段名，不在场景中运行时为空
 
         void print_statistics() const;
     };
 
     PerformanceStats get_performance_stats() const;
 
+    // 场景中一个阶段的结果：读写阶段带完整统计，load/prune/reopen只有耗时和details
+    struct ScenarioPhaseResult {
+        std::string name;
+        ScenarioPhaseType type = ScenarioPhaseType::kSteady;
+        double seconds = 0.0;
+        bool success = true;
+        std::optional<PerformanceStats> stats;
+        nlohmann::ordered_json details;
+    };
+
+    // 按顺序执行场景的各阶段。读写阶段的参数覆盖命令行配置，结果文件、时间序列和统计都按阶段名标记；
+    // 某个阶段失败（prune的compaction出错、reopen无法打开数据库）时停止。最后输出阶段汇总表和汇总JSON
+    std::vector<ScenarioPhaseResult> run_scenario(const Scenario& scenario);
+
     // Test support methods for accessing internal mutexes
-    std::mutex& get_write_perf_mutex() { return write_perf_mutex_; }
-    std::mutex& get_query_merge_mutex() { return query_merge_mutex_; }
+    std::mutex& get_write_perf_mutex() { return write_perf_mutex_.native(); }
+    std::mutex& get_query_merge_mutex() { return query_merge_mutex_.native(); }
+    // 最近一次并发读写测试的读分布（测试前为nullptr）
+    const KeyDistribution* get_read_distribution() const { return read_distribution_.get(); }
 
 private:
     std::shared_ptr<StrategyDBManager> db_manager_;
     std::shared_ptr<MetricsCollector> metrics_collector_;
     std::unique_ptr<DataGenerator> data_generator_;
+    uint64_t key_table_bytes_ = 0;            // key表在构造后不再变化，只统计一次
     BenchmarkConfig config_;
 
     // 测试状态
+    InitialLoadPhaseStats initial_load_stats_;
+    PerformanceStats last_test_stats_;        // 最近一次并发读写测试的统计（SLO扫描逐步读取）
     BlockNum initial_load_end_block_ = 0;
     std::atomic<BlockNum> current_max_block_{0};
     std::atomic<bool> test_running_{false};
+    // 某个写线程写入失败后置位：它领取的block永远不会发布，水位无法再推进，所有写线程随即退出
+    std::atomic<bool> write_failed_{false};
 
     // 优化后的并发控制和性能统计
 
     // 写线程专用锁和数据
-    mutable std::mutex write_perf_mutex_;
-    std::vector<double> write_latencies_;
+    mutable InstrumentedMutex write_perf_mutex_{"runner.write_perf_mutex"};
+    LatencyHistogram write_latency_histogram_;   // 受write_perf_mutex_保护
+    // 写入阶段分解：range index、data两路写入及其重叠时间，受write_perf_mutex_保护
+    LatencyHistogram write_range_histogram_;
+    LatencyHistogram write_data_histogram_;
+    LatencyHistogram write_overlap_histogram_;
+    LatencyHistogram block_read_histogram_;        // read-before-write的读取耗时，受write_perf_mutex_保护
+    LatencyHistogram block_execution_histogram_;   // 读取+写入，受write_perf_mutex_保护
+    size_t block_read_count_ = 0;                  // 受write_perf_mutex_保护
+    size_t block_read_found_count_ = 0;            // 受write_perf_mutex_保护
     std::atomic<size_t> write_count_{0};
+    std::atomic<size_t> write_record_count_{0};
+    std::atomic<size_t> write_input_record_count_{0};
+    std::atomic<size_t> write_duplicate_count_{0};
+    // 读/写/采样线程累计的线程CPU时间（ThreadCpuMeter周期发布，采样线程可读取区间值；写线程含CommitExecutor代执行的任务）
+    std::atomic<uint64_t> reader_cpu_ns_{0};
+    std::atomic<uint64_t> writer_cpu_ns_{0};
+    std::atomic<uint64_t> sampler_cpu_ns_{0};
+    // 应用层写入的addr_slot+value字节（含initial load，不随测试清零），作为跨DB放大的分母
+    std::atomic<uint64_t> logical_bytes_written_{0};
+
+    // 多写线程：共享的下一个待写block号；已完成但前面还有未完成block的block号集合。
+    // current_max_block_只推进到连续完成的最大block，读线程不会查询到写了一半的区间
+    std::atomic<BlockNum> next_write_block_{0};
+    BlockNum next_publish_block_ = 0;          // 受state_mutex_保护
+    std::set<BlockNum> completed_unpublished_; // 受state_mutex_保护
+    size_t test_writer_threads_ = 1;
+    size_t test_reader_threads_ = 0;
 
-    // 读线程使用线程本地存储
-    thread_local static std::vector<double> thread_query_latencies_;
+    // 读写线程各自的key热度分布，每轮测试开始时按配置创建，运行期间只读共享
+    std::unique_ptr<KeyDistribution> write_distribution_;
+    std::unique_ptr<KeyDistribution> read_distribution_;
+    std::unique_ptr<VersionDistribution> version_distribution_;   // 查询目标版本分布
+
+    // 每个读线程一个直方图，运行期间只由对应线程记录；统计时无锁合并
+    std::vector<std::unique_ptr<LatencyHistogram>> reader_histograms_;
+    // 开环模式下每个读线程的服务时间直方图（reader_histograms_记录从计划时刻算起的延迟）
+    std::vector<std::unique_ptr<LatencyHistogram>> reader_service_histograms_;
+    // 每个读线程kVersionAgeBucketCount个按版本年龄分桶的服务时间直方图（下标thread * 桶数 + 桶）
+    std::vector<std::unique_ptr<LatencyHistogram>> reader_age_histograms_;
+    // 每个读线程kReadOperationCount个按操作类型的服务时间直方图（下标thread * 操作数 + 操作）
+    std::vector<std::unique_ptr<LatencyHistogram>> reader_op_histograms_;
+    std::array<std::atomic<uint64_t>, kReadOperationCount> op_found_count_{};
+    std::array<std::atomic<uint64_t>, kReadOperationCount> op_item_count_{};
+
+    // 追块模式：写线程不sleep；writer_block_interval_是每个写线程的block间隔（0=不限速）。
+    // 写线程启动前writers_running_为false，这期间读线程的延迟记入reader_baseline_histograms_
+    bool catch_up_ = false;
+    std::chrono::nanoseconds writer_block_interval_{0};
+    std::atomic<bool> writers_running_{false};
+    std::vector<std::unique_ptr<LatencyHistogram>> reader_baseline_histograms_;
+    static constexpr size_t kCatchUpWindowSeconds = 10;
+
+    // 当前场景阶段名（run_scenario期间设置）：加在结果文件名、时间序列文件名和PerformanceStats::phase上
+    std::string scenario_phase_;
+    // 把读写阶段的参数应用到config_和workload_preset_，返回该阶段的测试配置
+    ConcurrentTestConfig prepare_scenario_phase(const ScenarioPhase& phase, const BenchmarkConfig& base_config);
+    void write_scenario_summary(const Scenario& scenario, const std::vector<ScenarioPhaseResult>& results) const;
+
+    // 当前工作负载预设（run_workload_suite期间设置）：读操作比例和扫描参数。为空时只有历史版本点查
+    const WorkloadPreset* workload_preset_ = nullptr;
+    double target_query_rate_ = 0.0;
+    bool poisson_arrivals_ = false;
+    // 采样查询的内部计数，读线程结束时合并进来；受query_merge_mutex_保护
+    size_t perf_sample_rate_ = 0;
+    std::vector<query_perf::Sample> perf_samples_;
     std::atomic<size_t> total_successful_queries_{0};
 
-    // 合并后的最终查询延迟数据（只写一次）
-    std::vector<double> query_latencies_;
-    mutable std::mutex query_merge_mutex_;
+    // 保护reader_histograms_的分配与遍历
+    mutable InstrumentedMutex query_merge_mutex_{"runner.query_merge_mutex"};
+
+    // 按秒聚合的查询/写入延迟，测试结束后与RocksDB事件时间线对齐
+    LatencyTimeline query_timeline_;
+    LatencyTimeline write_timeline_;
+    int64_t test_origin_ns_ = 0;               // 时间线起点（DBEventLog::now_ns时钟）
 
     // 状态保护
-    mutable std::mutex state_mutex_;
+    mutable InstrumentedMutex state_mutex_{"runner.state_mutex"};
+
+    // 时间序列采样线程的停止信号
+    std::mutex sampler_mutex_;
+    std::condition_variable sampler_cv_;
+    bool sampler_stop_ = false;
+
+    // 每个采样区间的吞吐，写入结果文件供rocksdb_bench_compare做吞吐的bootstrap
+    struct IntervalThroughput {
+        double elapsed_s = 0.0;
+        double interval_s = 0.0;
+        double query_ops_per_sec = 0.0;
+        double write_blocks_per_sec = 0.0;
+        double write_kv_per_sec = 0.0;
+    };
+    std::vector<IntervalThroughput> interval_throughput_;  // 受sampler_mutex_保护
+
+    // --trace-record：读写线程把写集合和查询记录到trace（未配置时为nullptr）
+    std::unique_ptr<TraceWriter> trace_writer_;
+    void open_trace_writer();
+
+    // Initial load生产者线程数（0=按CPU核心数自动选择）
+    size_t resolve_load_thread_count(size_t total_blocks) const;
 
     // 写线程函数
-    void writer_thread_function(size_t duration_seconds, size_t sleep_seconds, size_t block_size);
+    void writer_thread_function(int writer_id, size_t duration_seconds, size_t sleep_seconds, size_t block_size);
+
+    // block写入完成后调用，推进连续完成水位current_max_block_
+    void publish_completed_block(BlockNum block_num);
 
     // 读线程函数
     void reader_thread_function(int thread_id, std::chrono::seconds test_duration);
 
+    // 采样线程函数：每隔interval_seconds追加一行区间吞吐、区间延迟百分位和各DB的RocksDB状态
+    void sampler_thread_function(size_t interval_seconds, std::string output_path);
+
+    // 合并各读线程直方图并复制写直方图（内部加锁）
+    void snapshot_latency_histograms(LatencyHistogram& query_histogram, LatencyHistogram& write_histogram) const;
+
+    // 测试结束后写出JSON结果文件：配置、构建/硬件信息、汇总指标、完整直方图和区间吞吐
+    void export_results(const ConcurrentTestConfig& test_config, const PerformanceStats& stats);
+
+    // 按延迟分段汇总采样查询的内部工作量；开环时按服务时间分段
+    QueryPerfReport build_query_perf_report() const;
+
+    // 写/空间/读放大；读放大相对read_baseline_（测试开始时的各DB快照）
+    AmplificationReport build_amplification_report() const;
+    std::vector<StrategyDBManager::DBRuntimeSample> read_baseline_;
+    std::optional<AmplificationReport> initial_load_amplification_;
+
+    // 内存占用：各DB的RocksDB内存 + 策略和runner自身的进程内结构 + 进程RSS
+    StrategyDBManager::MemoryUsageSample sample_memory_usage() const;
+    void print_memory_usage(const std::string& phase) const;
+    static nlohmann::ordered_json memory_usage_to_json(const StrategyDBManager::MemoryUsageSample& sample);
+
+    // 测试结束后：输出写停顿窗口与延迟尖峰的对应关系，并把事件时间线写到logs/
+    void report_stall_correlation(int64_t end_ns) const;
+
+    // 追块模式：写线程运行区间[writers_start_ns, writers_end_ns]内的block吞吐时间线、写停顿和基线查询延迟
+    void fill_catch_up_stats(PerformanceStats& stats, int64_t writers_start_ns, int64_t writers_end_ns,
+                             double baseline_seconds) const;
+    void write_event_log(int64_t end_ns) const;
+
     // 性能统计计算
-    void calculate_performance_statistics(PerformanceStats& stats) const;
+    void calculate_performance_statistics(PerformanceStats& stats,
+                                          const LatencyHistogram& query_histogram,
+                                          const LatencyHistogram& write_histogram) const;
 
     // 兼容性：保留旧的查询接口
     struct QueryResult {
@@ -162,7 +476,12 @@ private:
         BlockNum block_num;
         Value value;
         double latency_ms;
+        uint64_t latency_ns;
+        size_t items = 0;     // 返回的版本数（点查为0或1）
     };
 
     QueryResult query_historical_version(const std::string& addr_slot, BlockNum target_version);
+    QueryResult query_latest_value(const std::string& addr_slot);
+    QueryResult scan_version_history(const std::string& addr_slot, BlockNum from_block, BlockNum to_block,
+                                     size_t limit);
 };
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "time_series_writer.hpp"
+#include "../utils/logger.hpp"
+#include <filesystem>
+#include <nlohmann/json.hpp>
+
+TimeSeriesWriter::TimeSeriesWriter(const std::string& path) : path_(path) {
+    jsonl_ = path.size() >= 6 && path.compare(path.size() - 6, 6, ".jsonl") == 0;
+
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    // 追加模式：已有内容的CSV不重复写表头
+    header_written_ = std::filesystem::exists(path, ec) && std::filesystem::file_size(path, ec) > 0;
+
+    out_.open(path, std::ios::out | std::ios::app);
+    if (!out_.is_open()) {
+        utils::log_error("TimeSeriesWriter: failed to open {}", path);
+    }
+}
+
+void TimeSeriesWriter::append(const Row& row) {
+    if (!out_.is_open()) {
+        return;
+    }
+    if (jsonl_) {
+        append_jsonl(row);
+    } else {
+        append_csv(row);
+    }
+    out_.flush();
+}
+
+void TimeSeriesWriter::append_csv(const Row& row) {
+    if (columns_.empty()) {
+        for (const auto& [name, value] : row) {
+            columns_.push_back(name);
+        }
+        if (!header_written_) {
+            for (size_t i = 0; i < columns_.size(); ++i) {
+                out_ << (i == 0 ? "" : ",") << columns_[i];
+            }
+            out_ << '\n';
+            header_written_ = true;
+        }
+    }
+
+    // 按表头列顺序输出，缺失的列留空
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (i > 0) {
+            out_ << ',';
+        }
+        for (const auto& [name, value] : row) {
+            if (name != columns_[i]) {
+                continue;
+            }
+            std::visit([this](const auto& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, double>) {
+                    out_ << fmt::format("{:.6f}", v);
+                } else {
+                    out_ << v;
+                }
+            }, value);
+            break;
+        }
+    }
+    out_ << '\n';
+}
+
+void TimeSeriesWriter::append_jsonl(const Row& row) {
+    nlohmann::ordered_json line;
+    for (const auto& [name, value] : row) {
+        std::visit([&line, &name](const auto& v) { line[name] = v; }, value);
+    }
+    out_ << line.dump() << '\n';
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// 时间序列指标输出 - 每个采样间隔追加一行，写完立即flush，进程中途崩溃也不丢失已采样的数据
+// 文件名以.jsonl结尾时输出JSON Lines，否则输出CSV（列由第一行确定，文件为空时写表头）
+class TimeSeriesWriter {
+public:
+    using SampleValue = std::variant<uint64_t, double, std::string>;
+    using Row = std::vector<std::pair<std::string, SampleValue>>;
+
+    explicit TimeSeriesWriter(const std::string& path);
+
+    bool is_open() const { return out_.is_open(); }
+    const std::string& path() const { return path_; }
+    bool is_jsonl() const { return jsonl_; }
+
+    void append(const Row& row);
+
+private:
+    void append_csv(const Row& row);
+    void append_jsonl(const Row& row);
+
+    std::string path_;
+    std::ofstream out_;
+    bool jsonl_ = false;
+    bool header_written_ = false;
+    std::vector<std::string> columns_;
+};
@@ -0,0 +1,246 @@
+#include "trace_replayer.hpp"
+#include "workload_trace.hpp"
+#include "result_document.hpp"
+#include "../utils/bounded_queue.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/tsc_clock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct QueryTask {
+    std::string key;
+    BlockNum target_version = 0;
+    Clock::time_point intended;
+};
+
+}  // namespace
+
+TraceReplayer::TraceReplayer(std::shared_ptr<StrategyDBManager> db_manager, const Options& options)
+    : db_manager_(std::move(db_manager)), options_(options) {
+    options_.query_threads = std::max<size_t>(1, options_.query_threads);
+}
+
+std::unique_ptr<TraceReplayer::Result> TraceReplayer::replay(const std::string& path) {
+    auto result = std::make_unique<Result>();
+    TraceReader reader(path);
+    if (!reader.is_open()) {
+        return result;
+    }
+    utils::log_info("Replaying trace {} at {} with {} query threads", path,
+                   options_.speed > 0 ? fmt::format("{:.2f}x", options_.speed) : std::string("full speed"),
+                   options_.query_threads);
+
+    // 写线程：按trace顺序执行，完成数通过writes_done_通知分发线程
+    BoundedQueue<std::unique_ptr<TraceEvent>> write_queue(16);
+    std::atomic<uint64_t> writes_done{0};
+    std::atomic<bool> write_failed{false};
+    std::thread writer([&]() {
+        while (auto event = write_queue.pop()) {
+            if (write_failed) {
+                continue;   // 丢弃失败之后已排队的写
+            }
+            bool success;
+            if ((*event)->type == TraceEventType::kInitialLoadBlock) {
+                success = db_manager_->write_initial_load_batch((*event)->records);
+            } else {
+                uint64_t start = TscClock::now();
+                success = db_manager_->write_batch((*event)->records);
+                result->write_latency.record(TscClock::elapsed_nanos(start));
+            }
+            if (!success) {
+                utils::log_error("Trace replay: failed to write block {}", (*event)->block_num);
+                write_failed = true;
+                write_queue.close();
+                writes_done.notify_all();
+                continue;
+            }
+            writes_done.fetch_add(1);
+            writes_done.notify_all();
+        }
+    });
+
+    // 查询线程：每个线程自己的直方图，结束后合并
+    BoundedQueue<QueryTask> query_queue(4096);
+    std::vector<std::unique_ptr<LatencyHistogram>> latency(options_.query_threads);
+    std::vector<std::unique_ptr<LatencyHistogram>> service(options_.query_threads);
+    std::atomic<uint64_t> found{0};
+    std::vector<std::thread> query_workers;
+    for (size_t t = 0; t < options_.query_threads; ++t) {
+        latency[t] = std::make_unique<LatencyHistogram>();
+        service[t] = std::make_unique<LatencyHistogram>();
+        query_workers.emplace_back([&, t]() {
+            while (auto task = query_queue.pop()) {
+                uint64_t start = TscClock::now();
+                auto value = db_manager_->query_historical_version(task->key, task->target_version);
+                service[t]->record(TscClock::elapsed_nanos(start));
+                auto response = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - task->intended);
+                latency[t]->record(static_cast<uint64_t>(std::max<int64_t>(response.count(), 0)));
+                if (value.has_value()) {
+                    found.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    auto wait_for_writes = [&](uint64_t count) {
+        uint64_t done = writes_done.load();
+        while (done < count && !write_failed) {
+            writes_done.wait(done);
+            done = writes_done.load();
+        }
+    };
+
+    uint64_t writes_dispatched = 0;
+    bool in_initial_load = true;
+    auto load_start = Clock::now();
+    Clock::time_point replay_start = load_start;
+    int64_t trace_origin_ns = 0;
+    int64_t trace_last_ns = 0;
+    double max_lag_ns = 0.0;
+    auto event = std::make_unique<TraceEvent>();
+
+    while (!write_failed && reader.next(*event)) {
+        if (event->type == TraceEventType::kInitialLoadBlock) {
+            result->initial_load_blocks++;
+            result->initial_load_records += event->records.size();
+            writes_dispatched++;
+            write_queue.push(std::move(event));
+            event = std::make_unique<TraceEvent>();
+            continue;
+        }
+
+        if (in_initial_load) {
+            // initial load结束：等待导入完成再开始计时重放
+            in_initial_load = false;
+            wait_for_writes(writes_dispatched);
+            db_manager_->flush_all_batches();
+            replay_start = Clock::now();
+            result->initial_load_seconds = std::chrono::duration<double>(replay_start - load_start).count();
+            if (result->initial_load_blocks > 0) {
+                utils::log_info("Trace replay: initial load of {} blocks ({} records) took {:.1f} s",
+                               result->initial_load_blocks, result->initial_load_records,
+                               result->initial_load_seconds);
+            }
+            trace_origin_ns = event->timestamp_ns;
+        }
+
+        Clock::time_point intended = Clock::now();
+        trace_last_ns = std::max(trace_last_ns, event->timestamp_ns);
+        if (options_.speed > 0) {
+            auto offset = std::chrono::nanoseconds(
+                static_cast<int64_t>((event->timestamp_ns - trace_origin_ns) / options_.speed));
+            intended = replay_start + offset;
+            std::this_thread::sleep_until(intended);
+            max_lag_ns = std::max<double>(max_lag_ns, std::chrono::duration<double, std::nano>(
+                                                          Clock::now() - intended).count());
+        }
+
+        if (event->type == TraceEventType::kWriteBlock) {
+            result->write_blocks++;
+            result->write_records += event->records.size();
+            writes_dispatched++;
+            write_queue.push(std::move(event));
+            event = std::make_unique<TraceEvent>();
+        } else {
+            // 录制时排在该查询之前的写已经完成
+            wait_for_writes(writes_dispatched);
+            result->queries++;
+            query_queue.push(QueryTask{std::move(event->key), event->block_num, intended});
+        }
+    }
+
+    write_queue.close();
+    writer.join();
+    query_queue.close();
+    for (auto& worker : query_workers) {
+        worker.join();
+    }
+    if (in_initial_load) {
+        db_manager_->flush_all_batches();
+        result->initial_load_seconds = std::chrono::duration<double>(Clock::now() - load_start).count();
+    } else {
+        result->replay_seconds = std::chrono::duration<double>(Clock::now() - replay_start).count();
+        result->trace_seconds = (trace_last_ns - trace_origin_ns) / 1e9;
+    }
+
+    for (size_t t = 0; t < options_.query_threads; ++t) {
+        result->query_latency.merge_from(*latency[t]);
+        result->query_service.merge_from(*service[t]);
+    }
+    result->queries_found = found.load();
+    result->max_dispatch_lag_ms = max_lag_ns / 1e6;
+    result->completed = !write_failed && !reader.truncated();
+    return result;
+}
+
+void TraceReplayer::Result::print() const {
+    utils::log_info("=== Trace Replay ===");
+    if (!completed) {
+        utils::log_error("Replay did not complete (corrupt trace or write failure); results cover the replayed prefix");
+    }
+    utils::log_info("Initial load: {} blocks, {} records, {:.1f} s", initial_load_blocks, initial_load_records,
+                   initial_load_seconds);
+    utils::log_info("Replayed {:.1f} s of trace in {:.1f} s, max dispatch lag {:.3f} ms", trace_seconds,
+                   replay_seconds, max_dispatch_lag_ms);
+    if (write_blocks > 0) {
+        utils::log_info("Writes: {} blocks, {} records, avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms, Max {:.3f} ms",
+                       write_blocks, write_records, write_latency.mean() / 1e6, write_latency.percentile_ms(50.0),
+                       write_latency.percentile_ms(99.0), write_latency.max() / 1e6);
+    }
+    if (queries > 0) {
+        utils::log_info("Queries: {} ({:.2f}% found), {:.0f} q/s", queries, 100.0 * queries_found / queries,
+                       replay_seconds > 0 ? queries / replay_seconds : 0.0);
+        utils::log_info("Query latency: avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms, P99.9 {:.3f} ms, Max {:.3f} ms",
+                       query_latency.mean() / 1e6, query_latency.percentile_ms(50.0),
+                       query_latency.percentile_ms(99.0), query_latency.percentile_ms(99.9),
+                       query_latency.max() / 1e6);
+        utils::log_info("Service time: avg {:.3f} ms, P50 {:.3f} ms, P99 {:.3f} ms, Max {:.3f} ms",
+                       query_service.mean() / 1e6, query_service.percentile_ms(50.0),
+                       query_service.percentile_ms(99.0), query_service.max() / 1e6);
+    }
+}
+
+nlohmann::ordered_json TraceReplayer::Result::to_json() const {
+    // summary字段与并发读写测试的结果文件同名，rocksdb_bench_compare可以直接比较两次重放
+    nlohmann::ordered_json j;
+    j["replay"] = {
+        {"completed", completed},
+        {"initial_load_blocks", initial_load_blocks},
+        {"initial_load_records", initial_load_records},
+        {"initial_load_seconds", initial_load_seconds},
+        {"replay_seconds", replay_seconds},
+        {"trace_seconds", trace_seconds},
+        {"max_dispatch_lag_ms", max_dispatch_lag_ms},
+    };
+    j["summary"] = {
+        {"total_query_ops", queries},
+        {"successful_queries", queries_found},
+        {"query_success_rate", queries > 0 ? 100.0 * queries_found / queries : 0.0},
+        {"query_ops_per_sec", replay_seconds > 0 ? queries / replay_seconds : 0.0},
+        {"query_avg_ms", query_latency.mean() / 1e6},
+        {"query_p50_ms", query_latency.percentile_ms(50.0)},
+        {"query_p99_ms", query_latency.percentile_ms(99.0)},
+        {"query_p999_ms", query_latency.percentile_ms(99.9)},
+        {"query_max_ms", query_latency.max() / 1e6},
+        {"service_p50_ms", query_service.percentile_ms(50.0)},
+        {"service_p99_ms", query_service.percentile_ms(99.0)},
+        {"total_write_ops", write_blocks},
+        {"total_write_records", write_records},
+        {"write_avg_ms", write_latency.mean() / 1e6},
+        {"write_p50_ms", write_latency.percentile_ms(50.0)},
+        {"write_p99_ms", write_latency.percentile_ms(99.0)},
+        {"write_max_ms", write_latency.max() / 1e6},
+    };
+    j["histograms"] = {
+        {"query_latency", result_document::histogram_to_json(query_latency)},
+        {"write_latency", result_document::histogram_to_json(write_latency)},
+    };
+    return j;
+}
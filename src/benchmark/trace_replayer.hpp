@@ -0,0 +1,46 @@
+#pragma once
+#include "../core/strategy_db_manager.hpp"
+#include "../utils/latency_histogram.hpp"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <string>
+
+// trace重放 - 按trace中的顺序和时间间隔驱动任意策略：initial load block不限速地导入，
+// 之后的写和查询按原始时间戳（除以speed）发起。一个写线程按顺序写block，查询分发到查询线程池；
+// 查询发起前等待trace中排在它前面的写全部完成，保证与录制时看到的数据一致
+class TraceReplayer {
+public:
+    struct Options {
+        double speed = 1.0;          // 时间加速倍数（0=不限速，尽快重放）
+        size_t query_threads = 8;
+    };
+
+    struct Result {
+        uint64_t initial_load_blocks = 0;
+        uint64_t initial_load_records = 0;
+        uint64_t write_blocks = 0;
+        uint64_t write_records = 0;
+        uint64_t queries = 0;
+        uint64_t queries_found = 0;
+        double initial_load_seconds = 0.0;
+        double replay_seconds = 0.0;           // initial load之后的重放墙钟时间
+        double trace_seconds = 0.0;            // trace中对应的原始时间跨度
+        double max_dispatch_lag_ms = 0.0;      // 事件实际发起时刻落后于计划时刻的最大值
+        bool completed = false;                // trace完整读完且所有写入成功
+        LatencyHistogram query_latency;        // 从计划发起时刻算起（含排队）
+        LatencyHistogram query_service;        // 查询本身的耗时
+        LatencyHistogram write_latency;
+
+        void print() const;
+        nlohmann::ordered_json to_json() const;
+    };
+
+    TraceReplayer(std::shared_ptr<StrategyDBManager> db_manager, const Options& options);
+
+    // 重放整个trace；结果中completed=false表示trace损坏、被截断或写入失败
+    std::unique_ptr<Result> replay(const std::string& path);
+
+private:
+    std::shared_ptr<StrategyDBManager> db_manager_;
+    Options options_;
+};
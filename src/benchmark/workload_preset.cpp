@@ -0,0 +1,166 @@
+#include "workload_preset.hpp"
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+const char* read_operation_name(ReadOperation op) {
+    switch (op) {
+    case ReadOperation::kHistorical:
+        return "historical";
+    case ReadOperation::kLatest:
+        return "latest";
+    case ReadOperation::kScan:
+        return "scan";
+    case ReadOperation::kAbsent:
+        return "absent";
+    }
+    return "unknown";
+}
+
+ReadOperation ReadOperationMix::pick(std::mt19937& rng) const {
+    double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double u = std::uniform_real_distribution<double>(0.0, total)(rng);
+    for (size_t i = 0; i < kReadOperationCount; ++i) {
+        if (u < weights[i]) {
+            return static_cast<ReadOperation>(i);
+        }
+        u -= weights[i];
+    }
+    // 浮点误差时落到最后一个非零权重
+    for (size_t i = kReadOperationCount; i-- > 0;) {
+        if (weights[i] > 0) {
+            return static_cast<ReadOperation>(i);
+        }
+    }
+    return ReadOperation::kHistorical;
+}
+
+double ReadOperationMix::share(ReadOperation op) const {
+    double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    return total > 0 ? weights[static_cast<size_t>(op)] / total : 0.0;
+}
+
+std::string ReadOperationMix::describe() const {
+    std::ostringstream oss;
+    for (size_t i = 0; i < kReadOperationCount; ++i) {
+        double percent = share(static_cast<ReadOperation>(i)) * 100.0;
+        if (percent <= 0) {
+            continue;
+        }
+        if (oss.tellp() > 0) {
+            oss << ", ";
+        }
+        oss << read_operation_name(static_cast<ReadOperation>(i)) << " " << std::round(percent) << "%";
+    }
+    return oss.str();
+}
+
+namespace {
+
+ReadOperationMix make_mix(double historical, double latest, double scan, double absent) {
+    ReadOperationMix mix;
+    mix.weights = {historical, latest, scan, absent};
+    return mix;
+}
+
+}  // namespace
+
+const std::vector<WorkloadPreset>& workload_presets() {
+    static const std::vector<WorkloadPreset> presets = [] {
+        std::vector<WorkloadPreset> list;
+
+        WorkloadPreset a;
+        a.name = "W-A";
+        a.description = "update heavy: 10k-kv blocks every second, half latest and half historical reads";
+        a.write_sleep_seconds = 1;
+        a.write_distribution = "scrambled_zipfian";
+        a.read_distribution = "scrambled_zipfian";
+        a.version_distribution = "exponential";
+        a.mix = make_mix(0.50, 0.50, 0.0, 0.0);
+        list.push_back(a);
+
+        WorkloadPreset b;
+        b.name = "W-B";
+        b.description = "read mostly at head: latest-value reads with a few historical and absent-key reads";
+        b.write_distribution = "scrambled_zipfian";
+        b.read_distribution = "scrambled_zipfian";
+        b.version_distribution = "recent";
+        b.mix = make_mix(0.05, 0.90, 0.0, 0.05);
+        list.push_back(b);
+
+        WorkloadPreset c;
+        c.name = "W-C";
+        c.description = "archive reads: small blocks, historical reads spread over all history, uniform keys";
+        c.block_size = 1000;
+        c.write_distribution = "uniform";
+        c.read_distribution = "uniform";
+        c.version_distribution = "uniform_all";
+        c.mix = make_mix(0.90, 0.0, 0.0, 0.10);
+        list.push_back(c);
+
+        WorkloadPreset d;
+        d.name = "W-D";
+        d.description = "recent history: historical reads of the last blocks on recently written keys";
+        d.write_distribution = "scrambled_zipfian";
+        d.read_distribution = "scrambled_zipfian";
+        d.version_distribution = "recent";
+        d.mix = make_mix(0.95, 0.05, 0.0, 0.0);
+        list.push_back(d);
+
+        WorkloadPreset e;
+        e.name = "W-E";
+        e.description = "history scans: up to 100 versions from a 1024-block window per scan";
+        e.write_distribution = "scrambled_zipfian";
+        e.read_distribution = "scrambled_zipfian";
+        e.version_distribution = "recent";
+        e.mix = make_mix(0.0, 0.05, 0.95, 0.0);
+        list.push_back(e);
+
+        WorkloadPreset f;
+        f.name = "W-F";
+        f.description = "read-modify-write: writers read every slot before writing its block";
+        f.read_before_write = true;
+        f.write_distribution = "scrambled_zipfian";
+        f.read_distribution = "scrambled_zipfian";
+        f.version_distribution = "exponential";
+        f.mix = make_mix(0.50, 0.50, 0.0, 0.0);
+        list.push_back(f);
+
+        return list;
+    }();
+    return presets;
+}
+
+const WorkloadPreset* find_workload_preset(const std::string& name) {
+    for (const auto& preset : workload_presets()) {
+        if (preset.name == name) {
+            return &preset;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> parse_workload_suite(const std::string& spec) {
+    std::vector<std::string> names;
+    if (spec == "all") {
+        for (const auto& preset : workload_presets()) {
+            names.push_back(preset.name);
+        }
+        return names;
+    }
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t comma = spec.find(',', start);
+        std::string name = spec.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        if (!find_workload_preset(name)) {
+            throw std::invalid_argument("Unknown workload preset: '" + name + "' (expected W-A … W-F or all)");
+        }
+        names.push_back(name);
+        if (comma == std::string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return names;
+}
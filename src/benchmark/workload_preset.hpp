@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+// 读线程发起的操作类型
+enum class ReadOperation : size_t {
+    kHistorical = 0,   // 历史版本点查（原有的唯一查询类型）
+    kLatest,           // 最新值点查
+    kScan,             // 一段block区间内的版本历史扫描
+    kAbsent,           // 不存在的key（测试bloom filter / 未命中路径）
+};
+constexpr size_t kReadOperationCount = 4;
+
+const char* read_operation_name(ReadOperation op);
+
+// 读操作比例，权重之和不必为1
+struct ReadOperationMix {
+    std::array<double, kReadOperationCount> weights{1.0, 0.0, 0.0, 0.0};
+
+    ReadOperation pick(std::mt19937& rng) const;
+    double share(ReadOperation op) const;
+    std::string describe() const;   // 例如"latest 95%, historical 5%"
+};
+
+// 标准工作负载（类似YCSB A–F，针对版本化状态）：写入节奏、key/版本分布和读操作比例全部固定，
+// 不同策略、不同版本之间的结果可以直接按名称比较
+struct WorkloadPreset {
+    std::string name;
+    std::string description;
+    size_t block_size = 10000;            // 每个block的kv数
+    size_t write_sleep_seconds = 3;       // 写线程每个block之后的sleep
+    bool read_before_write = false;       // 写入前先读各key最新值（block执行）
+    std::string write_distribution;
+    std::string read_distribution;
+    std::string version_distribution;
+    ReadOperationMix mix;
+    size_t scan_window_blocks = 1024;     // 扫描区间：[target - window, target]
+    size_t scan_limit = 100;              // 每次扫描最多返回的版本数
+};
+
+// W-A … W-F
+const std::vector<WorkloadPreset>& workload_presets();
+
+// 未知名称返回nullptr
+const WorkloadPreset* find_workload_preset(const std::string& name);
+
+// "all"或逗号分隔的预设名称；未知名称或空列表抛出std::invalid_argument
+std::vector<std::string> parse_workload_suite(const std::string& spec);
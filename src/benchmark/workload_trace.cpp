@@ -0,0 +1,201 @@
+#include "workload_trace.hpp"
+#include "../utils/logger.hpp"
+#include <bit>
+#include <cstring>
+#include <filesystem>
+
+static_assert(std::endian::native == std::endian::little, "trace format assumes a little-endian host");
+
+namespace {
+
+constexpr char kMagic[8] = {'R', 'D', 'B', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr size_t kFlushThreshold = 4 * 1024 * 1024;
+
+template <typename T>
+void put(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+}  // namespace
+
+TraceWriter::TraceWriter(const std::string& path) : path_(path), origin_(Clock::now()) {
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    out_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out_.is_open()) {
+        utils::log_error("TraceWriter: failed to open {}", path);
+        return;
+    }
+    buffer_.append(kMagic, sizeof(kMagic));
+    put<uint32_t>(buffer_, kFormatVersion);
+    put<uint32_t>(buffer_, 0);
+}
+
+TraceWriter::~TraceWriter() {
+    flush();
+}
+
+int64_t TraceWriter::relative_ns(Clock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin_).count();
+}
+
+void TraceWriter::record_block(TraceEventType type, BlockNum block_num, const std::vector<DataRecord>& records,
+                               Clock::time_point issued_at) {
+    if (!out_.is_open()) {
+        return;
+    }
+    std::lock_guard<InstrumentedMutex> lock(mutex_);
+    put<uint8_t>(buffer_, static_cast<uint8_t>(type));
+    put<int64_t>(buffer_, relative_ns(issued_at));
+    put<uint64_t>(buffer_, block_num);
+    put<uint32_t>(buffer_, static_cast<uint32_t>(records.size()));
+    for (const auto& record : records) {
+        put<uint16_t>(buffer_, static_cast<uint16_t>(record.addr_slot.size()));
+        buffer_.append(record.addr_slot);
+        put<uint32_t>(buffer_, static_cast<uint32_t>(record.value.size()));
+        buffer_.append(record.value);
+    }
+    events_++;
+    if (buffer_.size() >= kFlushThreshold) {
+        flush_locked();
+    }
+}
+
+void TraceWriter::record_query(const std::string& key, BlockNum target_version, Clock::time_point issued_at) {
+    if (!out_.is_open()) {
+        return;
+    }
+    std::lock_guard<InstrumentedMutex> lock(mutex_);
+    put<uint8_t>(buffer_, static_cast<uint8_t>(TraceEventType::kQuery));
+    put<int64_t>(buffer_, relative_ns(issued_at));
+    put<uint64_t>(buffer_, target_version);
+    put<uint16_t>(buffer_, static_cast<uint16_t>(key.size()));
+    buffer_.append(key);
+    events_++;
+    if (buffer_.size() >= kFlushThreshold) {
+        flush_locked();
+    }
+}
+
+void TraceWriter::flush() {
+    std::lock_guard<InstrumentedMutex> lock(mutex_);
+    flush_locked();
+}
+
+void TraceWriter::flush_locked() {
+    if (!out_.is_open() || buffer_.empty()) {
+        return;
+    }
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    out_.flush();
+    bytes_ += buffer_.size();
+    buffer_.clear();
+}
+
+uint64_t TraceWriter::events_written() const {
+    std::lock_guard<InstrumentedMutex> lock(mutex_);
+    return events_;
+}
+
+uint64_t TraceWriter::bytes_written() const {
+    std::lock_guard<InstrumentedMutex> lock(mutex_);
+    return bytes_ + buffer_.size();
+}
+
+TraceReader::TraceReader(const std::string& path) : stream_buffer_(1 << 20) {
+    // 设置较大的流缓冲，顺序读取时减少系统调用
+    in_.rdbuf()->pubsetbuf(stream_buffer_.data(), static_cast<std::streamsize>(stream_buffer_.size()));
+    in_.open(path, std::ios::in | std::ios::binary);
+    if (!in_.is_open()) {
+        utils::log_error("TraceReader: failed to open {}", path);
+        return;
+    }
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0;
+    uint32_t reserved = 0;
+    if (!read_bytes(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !read_bytes(&version, sizeof(version)) || !read_bytes(&reserved, sizeof(reserved))) {
+        utils::log_error("TraceReader: {} is not a workload trace", path);
+        return;
+    }
+    if (version != kFormatVersion) {
+        utils::log_error("TraceReader: {} has unsupported format version {}", path, version);
+        return;
+    }
+    header_ok_ = true;
+}
+
+bool TraceReader::read_bytes(void* data, size_t size) {
+    in_.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<size_t>(in_.gcount()) == size;
+}
+
+bool TraceReader::next(TraceEvent& event) {
+    if (!is_open() || truncated_) {
+        return false;
+    }
+    uint8_t type = 0;
+    if (!read_bytes(&type, sizeof(type))) {
+        return false;   // 正常结束
+    }
+
+    auto fail = [this](const char* what) {
+        utils::log_error("TraceReader: truncated or corrupt trace after {} events ({})", events_, what);
+        truncated_ = true;
+        return false;
+    };
+
+    if (type < static_cast<uint8_t>(TraceEventType::kInitialLoadBlock) ||
+        type > static_cast<uint8_t>(TraceEventType::kQuery)) {
+        return fail("unknown event type");
+    }
+    event.type = static_cast<TraceEventType>(type);
+    uint64_t block_num = 0;
+    if (!read_bytes(&event.timestamp_ns, sizeof(event.timestamp_ns)) || !read_bytes(&block_num, sizeof(block_num))) {
+        return fail("event header");
+    }
+    event.block_num = block_num;
+
+    if (event.type == TraceEventType::kQuery) {
+        uint16_t key_size = 0;
+        if (!read_bytes(&key_size, sizeof(key_size))) {
+            return fail("query key size");
+        }
+        event.key.resize(key_size);
+        if (!read_bytes(event.key.data(), key_size)) {
+            return fail("query key");
+        }
+        event.records.clear();
+    } else {
+        uint32_t count = 0;
+        if (!read_bytes(&count, sizeof(count))) {
+            return fail("record count");
+        }
+        event.key.clear();
+        event.records.resize(count);
+        for (auto& record : event.records) {
+            uint16_t key_size = 0;
+            uint32_t value_size = 0;
+            record.block_num = block_num;
+            if (!read_bytes(&key_size, sizeof(key_size))) {
+                return fail("record key size");
+            }
+            record.addr_slot.resize(key_size);
+            if (!read_bytes(record.addr_slot.data(), key_size) || !read_bytes(&value_size, sizeof(value_size))) {
+                return fail("record key");
+            }
+            record.value.resize(value_size);
+            if (!read_bytes(record.value.data(), value_size)) {
+                return fail("record value");
+            }
+        }
+    }
+    events_++;
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "../core/storage_strategy.hpp"
+#include "../utils/instrumented_mutex.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// 二进制负载trace，用于在不同策略/参数之间重放完全相同的负载。
+// 文件格式（小端）：8字节magic "RDBTRACE" + u32版本号 + u32保留，之后是连续的事件：
+//   u8类型 + i64时间戳（相对trace开始，纳秒） + u64 block号（写）或目标版本（查询）
+//   写：u32记录数，每条记录u16 key长度 + key + u32 value长度 + value
+//   查询：u16 key长度 + key
+// 写事件在写入完成后记录，时间戳是发起时刻；因此文件中排在查询之前的写在查询发起时已经完成
+enum class TraceEventType : uint8_t {
+    kInitialLoadBlock = 1,
+    kWriteBlock = 2,
+    kQuery = 3,
+};
+
+struct TraceEvent {
+    TraceEventType type = TraceEventType::kQuery;
+    int64_t timestamp_ns = 0;
+    BlockNum block_num = 0;              // 写：block号；查询：目标版本
+    std::string key;                     // 仅查询
+    std::vector<DataRecord> records;     // 仅写
+};
+
+// trace记录器 - 多个读写线程并发记录，内部缓冲后批量写出
+class TraceWriter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TraceWriter(const std::string& path);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool is_open() const { return out_.is_open(); }
+    const std::string& path() const { return path_; }
+
+    void record_block(TraceEventType type, BlockNum block_num, const std::vector<DataRecord>& records,
+                      Clock::time_point issued_at);
+    void record_query(const std::string& key, BlockNum target_version, Clock::time_point issued_at);
+
+    // 把缓冲区写到文件（测试结束时调用，进程退出前也会自动调用）
+    void flush();
+
+    uint64_t events_written() const;
+    uint64_t bytes_written() const;
+
+private:
+    void flush_locked();
+    int64_t relative_ns(Clock::time_point time) const;
+
+    std::string path_;
+    std::ofstream out_;
+    Clock::time_point origin_;
+    mutable InstrumentedMutex mutex_{"trace.writer_mutex"};
+    std::string buffer_;          // 受mutex_保护
+    uint64_t events_ = 0;         // 受mutex_保护
+    uint64_t bytes_ = 0;          // 受mutex_保护
+};
+
+// trace读取器 - 顺序流式读取，只缓冲当前事件，多GB的trace也不需要全部载入内存
+class TraceReader {
+public:
+    explicit TraceReader(const std::string& path);
+
+    bool is_open() const { return in_.is_open() && header_ok_; }
+
+    // 读取下一个事件（复用event中的buffer）；文件结束或出错时返回false，出错时truncated()为true
+    bool next(TraceEvent& event);
+    bool truncated() const { return truncated_; }
+    uint64_t events_read() const { return events_; }
+
+private:
+    bool read_bytes(void* data, size_t size);
+
+    std::ifstream in_;
+    std::vector<char> stream_buffer_;
+    bool header_ok_ = false;
+    bool truncated_ = false;
+    uint64_t events_ = 0;
+};
@@ -0,0 +1,74 @@
+#include "benchmark/result_comparison.hpp"
+#include "benchmark/result_document.hpp"
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+#include <iostream>
+
+// rocksdb_bench_compare - 对比一个基线结果文件与若干候选结果文件
+// 用法: rocksdb_bench_compare baseline.json candidate.json [candidate2.json ...]
+// 任一候选存在显著回退时退出码为1，便于在脚本中使用
+int main(int argc, char* argv[]) {
+    CLI::App app{"Compare rocksdb_bench result documents with bootstrap confidence intervals"};
+
+    std::vector<std::string> files;
+    ResultComparator::Options options;
+    app.add_option("files", files, "Baseline result file followed by one or more candidate files")
+        ->required()
+        ->expected(2, -1);
+    app.add_option("--iterations", options.iterations, "Bootstrap resamples per metric")
+        ->default_val(1000);
+    app.add_option("--confidence", options.confidence, "Confidence level of the intervals")
+        ->default_val(0.95)
+        ->check(CLI::Range(0.5, 0.999));
+    app.add_option("--min-effect", options.min_effect_pct,
+                   "Minimum relative change (%) to report a significant change as regression")
+        ->default_val(1.0);
+    app.add_option("--seed", options.seed, "Random seed for resampling")->default_val(42);
+
+    CLI11_PARSE(app, argc, argv);
+
+    nlohmann::json baseline;
+    std::string error;
+    if (!result_document::read_file(files[0], baseline, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 2;
+    }
+
+    auto describe = [](const nlohmann::json& doc) {
+        std::string commit = doc.contains("build") ? doc["build"].value("git_commit", "unknown") : "unknown";
+        return fmt::format("{} @ {} ({})", doc.value("strategy", "?"), commit, doc.value("timestamp", "?"));
+    };
+
+    bool any_regression = false;
+    for (size_t i = 1; i < files.size(); ++i) {
+        nlohmann::json candidate;
+        if (!result_document::read_file(files[i], candidate, error)) {
+            std::cerr << "Error: " << error << std::endl;
+            return 2;
+        }
+
+        std::cout << fmt::format("=== {} vs {} ===\n", files[i], files[0]);
+        std::cout << fmt::format("baseline:  {}\n", describe(baseline));
+        std::cout << fmt::format("candidate: {}\n", describe(candidate));
+        std::cout << fmt::format("{:<28} {:>12} {:>12} {:>9}  {:<22} {}\n",
+                                 "metric", "baseline", "candidate", "delta", "CI", "verdict");
+
+        ResultComparator comparator(options);
+        for (const auto& metric : comparator.compare(baseline, candidate)) {
+            std::string ci = metric.has_ci
+                ? fmt::format("[{:+.2f}%, {:+.2f}%]", metric.ci_low_pct, metric.ci_high_pct)
+                : "n/a";
+            std::string verdict = metric.regression ? "REGRESSION"
+                                : metric.improvement ? "improved"
+                                : metric.significant ? "significant (small)"
+                                : "-";
+            std::cout << fmt::format("{:<28} {:>12.4f} {:>12.4f} {:>+8.2f}%  {:<22} {}\n",
+                                     metric.name, metric.baseline, metric.candidate, metric.delta_pct,
+                                     ci, verdict);
+            any_regression = any_regression || metric.regression;
+        }
+        std::cout << std::endl;
+    }
+
+    return any_regression ? 1 : 0;
+}
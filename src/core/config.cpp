@@ -1,6 +1,9 @@
 #include "config.hpp"
 #include "../utils/logger.hpp"
+#include "../utils/key_distribution.hpp"
+#include "../utils/version_distribution.hpp"
 #include <CLI/CLI.hpp>
+#include <nlohmann/json.hpp>
 #include <cctype>
 #include <iostream>
 
@@ -42,6 +45,40 @@ BenchmarkConfig BenchmarkConfig::from_args(int argc, char *argv[]) {
   app.add_flag("--enable-dynamic-cache-optimization", config.enable_dynamic_cache_optimization,
                "Enable dynamic cache optimization (for DualRocksDB strategy)");
 
+  app.add_flag("!--no-write-coalescing", config.coalesce_writes,
+               "Write every update in a block, including repeated keys (default: keep only the last write per key)");
+
+  app.add_flag("--read-before-write", config.read_before_write,
+               "Writers look up the latest value of every key in a block before writing it, like block execution");
+
+  app.add_flag("--read-batch", config.read_batch,
+               "Batch the read-before-write lookups of a block (MultiGet where the strategy supports it)");
+
+  app.add_flag("--lock-stats", config.lock_stats,
+               "Record acquisitions, contention and wait/hold time per named lock and report a contention table");
+
+  app.add_flag("--derived-keys", config.derived_keys,
+               "Compute key i from a keyed bijective hash of i instead of materializing a key table");
+
+  app.add_option("--key-seed", config.key_seed,
+                 "Hash seed for --derived-keys; the same seed reproduces the same keyspace")
+      ->default_val(0);
+
+  app.add_flag("--contract-keys", config.contract_keys,
+               "Group keys into contracts with power-law slot counts and 32-byte hashed slots; "
+               "reads and writes pick a contract first, then a slot");
+
+  app.add_option("--contract-slot-alpha", config.contract_slot_alpha,
+                 "Pareto exponent of slots per contract (smaller = more large contracts)")
+      ->default_val(1.0);
+
+  app.add_option("--contract-max-slots", config.contract_max_slots,
+                 "Upper bound on slots per contract (0 = total keys / 20)")
+      ->default_val(0);
+
+  app.add_flag("!--serial-commit", config.parallel_commit,
+               "Write range index and data DBs one after another instead of concurrently (for DualRocksDB strategy)");
+
   // 策略特定选项
   app.add_option("--range-size", config.range_size,
                  "Range size for dual_rocksdb_adaptive strategy")
@@ -64,6 +101,186 @@ BenchmarkConfig BenchmarkConfig::from_args(int argc, char *argv[]) {
       ->default_val(4UL * 1024 * 1024 * 1024)
       ->check(CLI::PositiveNumber);
 
+  app.add_option("--writer-threads", config.writer_threads,
+                 "Number of concurrent writer threads in the read/write test (default: 1)")
+      ->default_val(1)
+      ->check(CLI::PositiveNumber);
+
+  app.add_flag("--catch-up", config.catch_up,
+               "Writers write blocks back to back instead of sleeping between blocks (node catch-up)");
+
+  app.add_option("--catch-up-block-rate", config.catch_up_block_rate,
+                 "Target blocks/sec across all writers in catch-up mode (default: 0 = as fast as possible)")
+      ->default_val(0.0)
+      ->check(CLI::NonNegativeNumber);
+
+  app.add_option("--catch-up-baseline-seconds", config.catch_up_baseline_seconds,
+                 "Seconds readers run alone before catch-up starts, as a latency baseline (default: 10)")
+      ->default_val(10);
+
+  app.add_option("--sample-interval", config.sample_interval_seconds,
+                 "Seconds between time-series samples during the read/write test (default: 10, 0 = off)")
+      ->default_val(10);
+
+  app.add_option("--timeseries-file", config.timeseries_file,
+                 "Time-series output file, .csv or .jsonl (default: logs/<strategy>_timeseries_<time>.csv)");
+
+  app.add_option("--result-file", config.result_file,
+                 "JSON result document for rocksdb_bench_compare (default: logs/<strategy>_result_<time>.json)");
+
+  app.add_option("--trace-record", config.trace_record_file,
+                 "Record every written block and every query of the read/write test to a binary trace");
+
+  app.add_flag("--trace-initial-load", config.trace_initial_load,
+               "Also record the initial load blocks, so the trace can be replayed into an empty database");
+
+  app.add_option("--trace-replay", config.trace_replay_file,
+                 "Replay a recorded trace against the selected strategy instead of running the synthetic workload");
+
+  app.add_option("--replay-speed", config.replay_speed,
+                 "Time acceleration for --trace-replay (1 = original pace, 0 = as fast as possible)")
+      ->default_val(1.0);
+
+  app.add_option("--replay-query-threads", config.replay_query_threads,
+                 "Query threads used by --trace-replay")
+      ->default_val(8)
+      ->check(CLI::PositiveNumber);
+
+  app.add_option("--query-rate", config.query_rate,
+                 "Open-loop target query rate across all readers in queries/s (default: 0 = closed loop)")
+      ->default_val(0.0);
+
+  app.add_option("--arrival", config.arrival_process,
+                 "Open-loop arrival process (fixed, poisson)")
+      ->check(CLI::IsMember({"fixed", "poisson"}))
+      ->default_val("fixed");
+
+  app.add_option("--write-distribution", config.write_distribution,
+                 "Key popularity for writers: uniform, tiered, zipfian, scrambled_zipfian, latest, hotspot (default: tiered)")
+      ->check(CLI::IsMember(key_distribution_names()))
+      ->default_val("tiered");
+
+  app.add_option("--read-distribution", config.read_distribution,
+                 "Key popularity for readers, same choices as --write-distribution (default: uniform)")
+      ->check(CLI::IsMember(key_distribution_names()))
+      ->default_val("uniform");
+
+  app.add_option("--zipf-theta", config.zipf_theta,
+                 "Zipfian exponent for zipfian, scrambled_zipfian and latest (default: 0.99)")
+      ->default_val(0.99);
+
+  app.add_option("--value-size-distribution", config.value_size_distribution,
+                 "Value sizes: fixed, uniform, lognormal or empirical (default: fixed)")
+      ->check(CLI::IsMember(value_size_distribution_names()))
+      ->default_val("fixed");
+
+  app.add_option("--value-size", config.value_size,
+                 "Fixed value size, or the median of lognormal sizes, in bytes (default: 32)")
+      ->default_val(32);
+
+  app.add_option("--value-min-size", config.value_min_size,
+                 "Smallest value for uniform and lognormal sizes (default: 8)")
+      ->default_val(8);
+
+  app.add_option("--value-max-size", config.value_max_size,
+                 "Largest value for uniform and lognormal sizes (default: 128)")
+      ->default_val(128);
+
+  app.add_option("--value-size-sigma", config.value_size_sigma,
+                 "Standard deviation of ln(size) for lognormal sizes (default: 1.0)")
+      ->default_val(1.0);
+
+  app.add_option("--value-size-file", config.value_size_file,
+                 "Histogram for empirical sizes, one \"size weight\" pair per line");
+
+  app.add_option("--value-content", config.value_content,
+                 "Value bytes: random (incompressible), pattern (repeated 16-byte unit) or zeros "
+                 "(leading zero bytes like storage words) (default: random)")
+      ->check(CLI::IsMember(value_content_names()))
+      ->default_val("random");
+
+  app.add_option("--value-zero-ratio", config.value_zero_ratio,
+                 "Fraction of leading zero bytes for --value-content zeros (default: 0.75)")
+      ->default_val(0.75);
+
+  app.add_option("--version-distribution", config.version_distribution,
+                 "Query target version: uniform, uniform_all, recent, exponential, or a mixture such as "
+                 "exponential:0.95,uniform_all:0.05")
+      ->default_val("uniform");
+
+  app.add_option("--version-window", config.version_window,
+                 "Number of most recent blocks covered by the recent version distribution")
+      ->default_val(128)
+      ->check(CLI::PositiveNumber);
+
+  app.add_option("--version-decay-blocks", config.version_decay_blocks,
+                 "Mean distance from head, in blocks, of the exponential version distribution")
+      ->default_val(128.0);
+
+  app.add_option("--hotspot-fraction", config.hotspot_fraction,
+                 "Fraction of the keyspace in the moving hotspot window (default: 0.01)")
+      ->default_val(0.01);
+
+  app.add_option("--hotspot-probability", config.hotspot_probability,
+                 "Probability that an access falls inside the hotspot window (default: 0.9)")
+      ->default_val(0.9);
+
+  app.add_option("--hotspot-period-seconds", config.hotspot_period_seconds,
+                 "Seconds before the hotspot window moves by its own width, 0 = fixed (default: 60)")
+      ->default_val(60.0);
+
+  app.add_option("--workload", config.workload_suite,
+                 "Run standard workload presets instead of the ad hoc loop: all, or a comma-separated "
+                 "list of W-A (update heavy), W-B (read latest), W-C (archive reads), W-D (recent history), "
+                 "W-E (history scans), W-F (read-modify-write)");
+
+  app.add_option("--workload-seconds", config.workload_seconds,
+                 "Duration of each workload preset in seconds (default: 300)")
+      ->default_val(300)
+      ->check(CLI::PositiveNumber);
+
+  app.add_option("--scenario", config.scenario_file,
+                 "Run the ordered phases of a JSON scenario file (load, warm_up, steady, burst, catch_up, prune, "
+                 "reopen) instead of initial load plus the continuous loop");
+
+  app.add_flag("--slo-sweep", config.slo_sweep,
+               "Ramp the open-loop query rate step by step until query p99 exceeds --slo-p99-ms");
+
+  app.add_option("--slo-p99-ms", config.slo_p99_ms,
+                 "Query p99 latency SLO for the sweep in ms (default: 10)")
+      ->default_val(10.0);
+
+  app.add_option("--sweep-start-rate", config.sweep_start_rate,
+                 "First offered query rate of the sweep in queries/s (default: 1000)")
+      ->default_val(1000.0);
+
+  app.add_option("--sweep-rate-factor", config.sweep_rate_factor,
+                 "Offered rate multiplier between sweep steps (default: 1.5)")
+      ->default_val(1.5);
+
+  app.add_option("--sweep-step-seconds", config.sweep_step_seconds,
+                 "Duration of each sweep step in seconds (default: 60)")
+      ->default_val(60)
+      ->check(CLI::PositiveNumber);
+
+  app.add_option("--sweep-max-steps", config.sweep_max_steps,
+                 "Maximum number of sweep steps (default: 20)")
+      ->default_val(20)
+      ->check(CLI::PositiveNumber);
+
+  app.add_option("--perf-sample-rate", config.perf_sample_rate,
+                 "Capture RocksDB perf/iostats context for 1 in N queries (default: 1000, 0 = off)")
+      ->default_val(1000);
+
+  app.add_option("--load-threads", config.load_threads,
+                 "Number of initial load producer threads (default: 0 = auto)")
+      ->default_val(0);
+
+  app.add_option("--commit-buffers", config.commit_buffers,
+                 "Number of write batches in the initial load commit pipeline (default: 2, 1 = synchronous)")
+      ->default_val(2)
+      ->check(CLI::PositiveNumber);
+
   // 位置参数
   app.add_option("db_path_pos", config.db_path,
                  "Database path (positional argument)")
@@ -121,15 +338,182 @@ void BenchmarkConfig::print_config() const {
   utils::log_info("Verbose Output: {}", verbose ? "Yes" : "No");
   utils::log_info("Batch Size Blocks: {}", batch_size_blocks);
   utils::log_info("Max Batch Size: {} MB", max_batch_size_bytes / (1024 * 1024));
+  utils::log_info("Commit Buffers: {}", commit_buffers);
+  utils::log_info("Writer Threads: {}", writer_threads);
+  utils::log_info("Write Coalescing: {}", coalesce_writes ? "Enabled" : "Disabled");
+  if (read_before_write) {
+    utils::log_info("Write Mode: read-before-write ({} reads)", read_batch ? "batched" : "per-key");
+  } else {
+    utils::log_info("Write Mode: blind writes");
+  }
+  if (catch_up) {
+    utils::log_info("Catch-up Mode: {} blocks/s, {} s reader baseline",
+                    catch_up_block_rate > 0 ? fmt::format("{:.1f}", catch_up_block_rate) : std::string("unlimited"),
+                    catch_up_baseline_seconds);
+  }
+  if (sample_interval_seconds > 0) {
+    utils::log_info("Time-series Sampling: every {} s -> {}", sample_interval_seconds,
+                    timeseries_file.empty() ? std::string("logs/ (auto)") : timeseries_file);
+  } else {
+    utils::log_info("Time-series Sampling: Disabled");
+  }
+  if (!trace_replay_file.empty()) {
+    utils::log_info("Trace Replay: {} at {} with {} query threads", trace_replay_file,
+                    replay_speed > 0 ? fmt::format("{:.2f}x", replay_speed) : std::string("full speed"),
+                    replay_query_threads);
+  } else if (!trace_record_file.empty()) {
+    utils::log_info("Trace Recording: {}{}", trace_record_file,
+                    trace_initial_load ? " (including initial load)" : "");
+  }
+  if (!scenario_file.empty()) {
+    utils::log_info("Scenario: {}", scenario_file);
+  } else if (!workload_suite.empty()) {
+    utils::log_info("Workload Suite: {} ({} s per preset)", workload_suite, workload_seconds);
+  } else if (slo_sweep) {
+    utils::log_info("Query Load: SLO sweep from {:.0f} q/s x{:.2f} per {} s step until p99 > {:.2f} ms ({})",
+                    sweep_start_rate, sweep_rate_factor, sweep_step_seconds, slo_p99_ms, arrival_process);
+  } else if (query_rate > 0) {
+    utils::log_info("Query Load: open loop at {:.0f} q/s ({})", query_rate, arrival_process);
+  } else {
+    utils::log_info("Query Load: closed loop");
+  }
+  if (perf_sample_rate > 0) {
+    utils::log_info("Query Perf Sampling: 1 in {} queries", perf_sample_rate);
+  } else {
+    utils::log_info("Query Perf Sampling: Disabled");
+  }
+  utils::log_info("Lock Statistics: {}", lock_stats ? "Enabled" : "Disabled");
+  if (contract_keys) {
+    utils::log_info("Keys: contract-clustered, slot alpha {:.2f}, max slots {} (seed {})", contract_slot_alpha,
+                    contract_max_slots == 0 ? std::string("auto") : std::to_string(contract_max_slots), key_seed);
+  } else if (derived_keys) {
+    utils::log_info("Keys: derived from index (seed {})", key_seed);
+  } else {
+    utils::log_info("Keys: random key table");
+  }
+  utils::log_info("Value Sizes: {}{}, content {}", value_size_distribution,
+                  value_size_distribution == "fixed" ? fmt::format(" {} B", value_size)
+                  : value_size_distribution == "empirical" ? fmt::format(" from {}", value_size_file)
+                  : fmt::format(" [{}, {}] B", value_min_size, value_max_size),
+                  value_content);
+  utils::log_info("Key Distribution: writes {}, reads {}", write_distribution, read_distribution);
+  if (write_distribution == "zipfian" || write_distribution == "scrambled_zipfian" || write_distribution == "latest" ||
+      read_distribution == "zipfian" || read_distribution == "scrambled_zipfian" || read_distribution == "latest") {
+    utils::log_info("Zipf Theta: {:.2f}", zipf_theta);
+  }
+  utils::log_info("Query Target Version: {} (recent window {}, exponential mean {:.0f} blocks)",
+                  version_distribution, version_window, version_decay_blocks);
+  if (write_distribution == "hotspot" || read_distribution == "hotspot") {
+    utils::log_info("Hotspot: {:.2f}% of keys get {:.0f}% of accesses, moves every {:.0f} s",
+                    hotspot_fraction * 100.0, hotspot_probability * 100.0, hotspot_period_seconds);
+  }
+  utils::log_info("Load Threads: {}", load_threads == 0 ? std::string("auto") : std::to_string(load_threads));
 
   if (storage_strategy == "dual_rocksdb_adaptive") {
     utils::log_info("Range Size: {}", range_size);
     utils::log_info("Cache Size: {} MB", cache_size / (1024 * 1024));
+    utils::log_info("Parallel Commit: {}", parallel_commit ? "Enabled" : "Disabled");
   }
 
   utils::log_info("================================================");
 }
 
+nlohmann::ordered_json BenchmarkConfig::to_json() const {
+  nlohmann::ordered_json j;
+  j["storage_strategy"] = storage_strategy;
+  j["db_path"] = db_path;
+  j["total_keys"] = total_keys;
+  j["continuous_duration_minutes"] = continuous_duration_minutes;
+  j["enable_bloom_filter"] = enable_bloom_filter;
+  j["clean_existing_data"] = clean_existing_data;
+  j["enable_dynamic_cache_optimization"] = enable_dynamic_cache_optimization;
+  j["range_size"] = range_size;
+  j["cache_size"] = cache_size;
+  j["batch_size_blocks"] = batch_size_blocks;
+  j["max_batch_size_bytes"] = max_batch_size_bytes;
+  j["commit_buffers"] = commit_buffers;
+  j["parallel_commit"] = parallel_commit;
+  j["load_threads"] = load_threads;
+  j["writer_threads"] = writer_threads;
+  j["coalesce_writes"] = coalesce_writes;
+  j["read_before_write"] = read_before_write;
+  j["read_batch"] = read_batch;
+  j["catch_up"] = catch_up;
+  if (catch_up) {
+    j["catch_up_block_rate"] = catch_up_block_rate;
+    j["catch_up_baseline_seconds"] = catch_up_baseline_seconds;
+  }
+  j["sample_interval_seconds"] = sample_interval_seconds;
+  j["query_rate"] = query_rate;
+  j["arrival_process"] = arrival_process;
+  j["slo_sweep"] = slo_sweep;
+  if (!workload_suite.empty()) {
+    j["workload_suite"] = workload_suite;
+    j["workload_seconds"] = workload_seconds;
+  }
+  if (!scenario_file.empty()) {
+    j["scenario_file"] = scenario_file;
+  }
+  j["perf_sample_rate"] = perf_sample_rate;
+  j["lock_stats"] = lock_stats;
+  j["derived_keys"] = derived_keys;
+  j["key_seed"] = key_seed;
+  j["contract_keys"] = contract_keys;
+  if (contract_keys) {
+    j["contract_slot_alpha"] = contract_slot_alpha;
+    j["contract_max_slots"] = contract_max_slots;
+  }
+  j["value_size_distribution"] = value_size_distribution;
+  j["value_size"] = value_size;
+  j["value_min_size"] = value_min_size;
+  j["value_max_size"] = value_max_size;
+  j["value_size_sigma"] = value_size_sigma;
+  if (!value_size_file.empty()) {
+    j["value_size_file"] = value_size_file;
+  }
+  j["value_content"] = value_content;
+  j["value_zero_ratio"] = value_zero_ratio;
+  j["write_distribution"] = write_distribution;
+  j["read_distribution"] = read_distribution;
+  j["zipf_theta"] = zipf_theta;
+  j["hotspot_fraction"] = hotspot_fraction;
+  j["hotspot_probability"] = hotspot_probability;
+  j["hotspot_period_seconds"] = hotspot_period_seconds;
+  j["version_distribution"] = version_distribution;
+  j["version_window"] = version_window;
+  j["version_decay_blocks"] = version_decay_blocks;
+  if (!trace_record_file.empty()) {
+    j["trace_record_file"] = trace_record_file;
+    j["trace_initial_load"] = trace_initial_load;
+  }
+  if (!trace_replay_file.empty()) {
+    j["trace_replay_file"] = trace_replay_file;
+    j["replay_speed"] = replay_speed;
+    j["replay_query_threads"] = replay_query_threads;
+  }
+  if (slo_sweep) {
+    j["slo_p99_ms"] = slo_p99_ms;
+    j["sweep_start_rate"] = sweep_start_rate;
+    j["sweep_rate_factor"] = sweep_rate_factor;
+    j["sweep_step_seconds"] = sweep_step_seconds;
+    j["sweep_max_steps"] = sweep_max_steps;
+  }
+  return j;
+}
+
+ValueGeneratorParams BenchmarkConfig::value_generator_params() const {
+  ValueGeneratorParams params;
+  params.size_distribution = value_size_distribution;
+  params.size = value_size;
+  params.min_size = value_min_size;
+  params.max_size = value_max_size;
+  params.sigma = value_size_sigma;
+  params.histogram_file = value_size_file;
+  params.content = value_content;
+  params.zero_ratio = value_zero_ratio;
+  return params;
+}
+
 bool BenchmarkConfig::validate() const {
   return get_validation_errors().empty();
 }
@@ -145,6 +529,78 @@ std::vector<std::string> BenchmarkConfig::get_validation_errors() const {
     errors.push_back("Duration must be greater than 0");
   }
 
+  if (writer_threads == 0) {
+    errors.push_back("Writer threads must be greater than 0");
+  }
+
+  if (commit_buffers == 0) {
+    errors.push_back("Commit buffers must be greater than 0");
+  }
+
+  if (query_rate < 0) {
+    errors.push_back("Query rate must not be negative");
+  }
+
+  if (catch_up_block_rate < 0) {
+    errors.push_back("Catch-up block rate must not be negative");
+  }
+
+  if (!is_key_distribution_name(write_distribution)) {
+    errors.push_back("Unknown write distribution: " + write_distribution);
+  }
+  if (!is_key_distribution_name(read_distribution)) {
+    errors.push_back("Unknown read distribution: " + read_distribution);
+  }
+  if (zipf_theta <= 0) {
+    errors.push_back("Zipf theta must be greater than 0");
+  }
+  if (hotspot_fraction <= 0 || hotspot_fraction > 1) {
+    errors.push_back("Hotspot fraction must be in (0, 1]");
+  }
+  if (hotspot_probability < 0 || hotspot_probability > 1) {
+    errors.push_back("Hotspot probability must be in [0, 1]");
+  }
+  if (hotspot_period_seconds < 0) {
+    errors.push_back("Hotspot period must not be negative");
+  }
+  try {
+    VersionDistributionParams version_params;
+    version_params.recent_window = version_window;
+    version_params.decay_mean_blocks = version_decay_blocks;
+    make_version_distribution(version_distribution, version_params);
+  } catch (const std::invalid_argument& e) {
+    errors.push_back(e.what());
+  }
+  try {
+    make_value_generator(value_generator_params());
+  } catch (const std::exception& e) {
+    errors.push_back(e.what());
+  }
+  if (contract_slot_alpha <= 0) {
+    errors.push_back("Contract slot alpha must be greater than 0");
+  }
+  if (replay_speed < 0) {
+    errors.push_back("Replay speed must not be negative");
+  }
+  if (!trace_record_file.empty() && trace_record_file == trace_replay_file) {
+    errors.push_back("Cannot record a trace to the file being replayed");
+  }
+  if (!scenario_file.empty() && (!workload_suite.empty() || slo_sweep)) {
+    errors.push_back("--scenario cannot be combined with --workload or --slo-sweep");
+  }
+
+  if (slo_sweep) {
+    if (sweep_start_rate <= 0) {
+      errors.push_back("Sweep start rate must be greater than 0");
+    }
+    if (sweep_rate_factor <= 1.0) {
+      errors.push_back("Sweep rate factor must be greater than 1");
+    }
+    if (slo_p99_ms <= 0) {
+      errors.push_back("SLO p99 must be greater than 0");
+    }
+  }
+
   if (storage_strategy == "dual_rocksdb_adaptive") {
     if (range_size == 0) {
       errors.push_back("Range size must be greater than 0");
@@ -183,6 +639,84 @@ void BenchmarkConfig::print_help(const std::string &program_name) {
                "(default: 5)\n";
   std::cout << "  --max-batch-size-bytes N    Maximum batch size in bytes "
                "(default: 4GB)\n";
+  std::cout << "  --writer-threads N          Concurrent writer threads in the "
+               "read/write test (default: 1)\n";
+  std::cout << "  --catch-up                  Write blocks back to back (no sleep) "
+               "and report sustained blocks/sec\n";
+  std::cout << "  --catch-up-block-rate N     Target blocks/sec across writers "
+               "(default: 0 = unlimited)\n";
+  std::cout << "  --catch-up-baseline-seconds N\n"
+               "                              Reader-only baseline before catch-up "
+               "starts (default: 10)\n";
+  std::cout << "  --sample-interval N         Seconds between time-series samples "
+               "(default: 10, 0 = off)\n";
+  std::cout << "  --timeseries-file PATH      Time-series output, .csv or .jsonl "
+               "(default: logs/<strategy>_timeseries_<time>.csv)\n";
+  std::cout << "  --result-file PATH          JSON result document "
+               "(default: logs/<strategy>_result_<time>.json)\n";
+  std::cout << "  --trace-record PATH         Record written blocks and queries to a binary trace\n";
+  std::cout << "  --trace-initial-load        Include initial load blocks in the recorded trace\n";
+  std::cout << "  --trace-replay PATH         Replay a trace instead of the synthetic workload\n";
+  std::cout << "  --replay-speed N            Replay time acceleration (default: 1, 0 = full speed)\n";
+  std::cout << "  --replay-query-threads N    Replay query threads (default: 8)\n";
+  std::cout << "  --query-rate N              Open-loop target query rate, queries/s "
+               "(default: 0 = closed loop)\n";
+  std::cout << "  --arrival fixed|poisson     Open-loop arrival process (default: fixed)\n";
+  std::cout << "  --write-distribution NAME   Writer key popularity: uniform, tiered, zipfian, "
+               "scrambled_zipfian, latest, hotspot (default: tiered)\n";
+  std::cout << "  --read-distribution NAME    Reader key popularity, same choices (default: uniform)\n";
+  std::cout << "  --zipf-theta N              Zipfian exponent (default: 0.99)\n";
+  std::cout << "  --hotspot-fraction N        Hotspot window size as a fraction of keys (default: 0.01)\n";
+  std::cout << "  --hotspot-probability N     Share of accesses inside the hotspot (default: 0.9)\n";
+  std::cout << "  --hotspot-period-seconds N  Hotspot moves by its width every N s, 0 = fixed "
+               "(default: 60)\n";
+  std::cout << "  --value-size-distribution D Value sizes: fixed, uniform, lognormal, "
+               "empirical (default: fixed)\n";
+  std::cout << "  --value-size N              Fixed size / lognormal median in bytes (default: 32)\n";
+  std::cout << "  --value-min-size N          Uniform/lognormal lower bound (default: 8)\n";
+  std::cout << "  --value-max-size N          Uniform/lognormal upper bound (default: 128)\n";
+  std::cout << "  --value-size-sigma N        Lognormal sigma of ln(size) (default: 1.0)\n";
+  std::cout << "  --value-size-file PATH      \"size weight\" histogram for empirical sizes\n";
+  std::cout << "  --value-content C           random, pattern or zeros (default: random)\n";
+  std::cout << "  --value-zero-ratio N        Leading zero fraction for zeros content "
+               "(default: 0.75)\n";
+  std::cout << "  --version-distribution SPEC Query target version: uniform, uniform_all, "
+               "recent, exponential or name:weight,... (default: uniform)\n";
+  std::cout << "  --version-window N          Blocks covered by recent (default: 128)\n";
+  std::cout << "  --version-decay-blocks N    Mean age of exponential in blocks (default: 128)\n";
+  std::cout << "  --workload SPEC             Run presets W-A … W-F (comma list or all) "
+               "instead of the ad hoc loop\n";
+  std::cout << "  --workload-seconds N        Duration of each preset (default: 300)\n";
+  std::cout << "  --scenario FILE             Run the phases of a JSON scenario file "
+               "(see generate_config_example --scenario)\n";
+  std::cout << "  --slo-sweep                 Ramp the query rate until p99 exceeds the SLO\n";
+  std::cout << "  --slo-p99-ms N              Query p99 SLO for the sweep (default: 10)\n";
+  std::cout << "  --sweep-start-rate N        First offered rate of the sweep (default: 1000)\n";
+  std::cout << "  --sweep-rate-factor N       Rate multiplier between sweep steps (default: 1.5)\n";
+  std::cout << "  --sweep-step-seconds N      Duration of each sweep step (default: 60)\n";
+  std::cout << "  --sweep-max-steps N         Maximum number of sweep steps (default: 20)\n";
+  std::cout << "  --perf-sample-rate N        Capture perf/iostats context for 1 in N "
+               "queries (default: 1000, 0 = off)\n";
+  std::cout << "  --lock-stats                Report acquisitions, contention and wait/hold "
+               "time per named lock\n";
+  std::cout << "  --derived-keys              Compute keys from their index instead of "
+               "building a key table\n";
+  std::cout << "  --key-seed N                Hash seed for --derived-keys (default: 0)\n";
+  std::cout << "  --contract-keys             Cluster keys into contracts with power-law "
+               "slot counts\n";
+  std::cout << "  --contract-slot-alpha N     Pareto exponent of slots per contract (default: 1.0)\n";
+  std::cout << "  --contract-max-slots N      Max slots per contract (default: 0 = keys / 20)\n";
+  std::cout << "  --load-threads N            Initial load producer threads "
+               "(default: 0 = auto)\n";
+  std::cout << "  --commit-buffers N          Write batches in the initial load commit "
+               "pipeline; each may hold up to --max-batch-size-bytes (default: 2)\n";
+  std::cout << "  --read-before-write         Look up each key's latest value before "
+               "writing a block\n";
+  std::cout << "  --read-batch                Batch those lookups per block (MultiGet)\n";
+  std::cout << "  --no-write-coalescing        Keep repeated keys within a block "
+               "instead of only the last write\n";
+  std::cout << "  --serial-commit              Write range index and data DBs "
+               "sequentially (for DualRocksDB strategy)\n";
   std::cout << "  --enable-dynamic-cache-optimization\n"
                "                              Enable dynamic cache optimization "
                "(for DualRocksDB strategy)\n";
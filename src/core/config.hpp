@@ -1,8 +1,10 @@
 #pragma once
 #include "storage_strategy.hpp"
+#include "../utils/value_generator.hpp"
 #include <memory>
 #include <vector>
 #include <string>
+#include <nlohmann/json_fwd.hpp>
 
 // 前向声明策略工厂
 class StorageStrategyFactory;
@@ -10,6 +12,16 @@ class StorageStrategyFactory;
 // 版本信息打印函数声明
 void print_version_info();
 
+// 构建信息（git提交、分支、构建时间），用于结果文件
+struct BuildInfo {
+    std::string version;
+    std::string git_commit;
+    std::string git_branch;
+    std::string git_date;
+    std::string build_time;
+};
+BuildInfo get_build_info();
+
 // 历史版本查询测试配置 - 简化版本，专注于test.mdx需求
 struct BenchmarkConfig {
     std::string storage_strategy = "direct_version";  // 存储策略，默认direct_version
@@ -31,6 +43,70 @@ struct BenchmarkConfig {
     // Batch配置（用于所有策略）
     uint32_t batch_size_blocks = 5000;                // 每个WriteBatch写入的块数（默认5个块）
     size_t max_batch_size_bytes = 4UL * 1024 * 1024 * 1024; // 最大批次大小（4GB）
+    size_t commit_buffers = 2;                        // initial load提交流水线buffer数（1=同步写入）
+    bool parallel_commit = true;                      // DualRocksDB range index/data两路并发写入
+    size_t load_threads = 0;                          // initial load生产者线程数（0=自动）
+    size_t writer_threads = 1;                        // 并发读写测试中的写线程数
+    bool coalesce_writes = true;                      // 写入前合并block内重复key，只保留最后一次写入
+    bool read_before_write = false;                   // 写线程先查询block内每个key的最新值再写入（模拟block执行）
+    bool read_batch = false;                          // read-before-write的读取整块批量执行（策略支持时用MultiGet）
+    bool catch_up = false;                            // 追块模式：写线程不sleep，连续写block（模拟节点同步追赶）
+    double catch_up_block_rate = 0.0;                 // 追块模式的目标block速率（所有写线程合计，0=不限速）
+    size_t catch_up_baseline_seconds = 10;            // 追块开始前读线程单独运行的秒数，作为查询延迟基线
+    size_t sample_interval_seconds = 10;              // 时间序列采样间隔（秒，0=关闭）
+    std::string timeseries_file;                      // 时间序列输出文件（.csv或.jsonl，空=logs/下自动命名）
+    std::string result_file;                          // JSON结果文件（空=logs/下自动命名）
+
+    // 开环查询负载：按目标到达时刻发起查询，延迟从计划发起时刻算起（修正coordinated omission）
+    double query_rate = 0.0;                          // 所有读线程合计的目标查询速率（次/秒，0=闭环）
+    std::string arrival_process = "fixed";            // 到达过程：fixed（等间隔）或poisson
+    bool slo_sweep = false;                           // 逐步提高查询速率直到p99超过SLO
+    std::string workload_suite;                       // 依次运行的标准工作负载预设（"all"或"W-A,W-E"，空=不运行）
+    size_t workload_seconds = 300;                    // 每个预设的运行时间（秒）
+    std::string scenario_file;                        // 多阶段场景文件（JSON），设置后按场景的阶段运行（包括initial load）
+    double slo_p99_ms = 10.0;                         // SLO：查询p99上限（毫秒）
+    double sweep_start_rate = 1000.0;                 // 扫描起始速率（次/秒）
+    double sweep_rate_factor = 1.5;                   // 每一步速率乘以该系数
+    size_t sweep_step_seconds = 60;                   // 每一步的持续时间（秒）
+    size_t sweep_max_steps = 20;                      // 最多扫描步数
+    size_t perf_sample_rate = 1000;                   // 每N次查询采样一次PerfContext/IOStatsContext（0=关闭）
+    bool lock_stats = false;                          // 统计各命名锁的获取/竞争次数和等待/持有时间
+    bool derived_keys = false;                        // key i由keyed双射hash按需计算，不在内存中生成key表
+    uint64_t key_seed = 0;                            // 派生key的hash种子，相同种子得到相同keyspace
+    bool contract_keys = false;                       // 按合约聚集key：每个合约的slot数服从幂律，读写先选合约再选slot
+    double contract_slot_alpha = 1.0;                 // 合约slot数的Pareto指数（越小大合约越多）
+    size_t contract_max_slots = 0;                    // 单个合约的slot上限（0=total_keys/20）
+
+    // value长度分布（fixed, uniform, lognormal, empirical）和内容可压缩性（random, pattern, zeros）
+    std::string value_size_distribution = "fixed";
+    size_t value_size = 32;                           // fixed的长度，lognormal的中位数（原有行为：固定32字节）
+    size_t value_min_size = 8;                        // uniform范围 / lognormal截断范围
+    size_t value_max_size = 128;
+    double value_size_sigma = 1.0;                    // lognormal：ln(size)的标准差
+    std::string value_size_file;                      // empirical：每行"长度 权重"的直方图文件
+    std::string value_content = "random";
+    double value_zero_ratio = 0.75;                   // zeros：前导零字节占比
+
+    // 负载trace：录制并发读写测试的写集合和查询，或重放已有trace（重放时跳过initial load和测试）
+    std::string trace_record_file;                    // 录制到该文件（空=不录制）
+    bool trace_initial_load = false;                  // 同时录制initial load的block，重放时可从空库开始
+    std::string trace_replay_file;                    // 重放该trace（空=正常运行）
+    double replay_speed = 1.0;                        // 重放时间加速倍数（0=不限速）
+    size_t replay_query_threads = 8;                  // 重放查询线程数
+    
+    // key热度分布（uniform, tiered, zipfian, scrambled_zipfian, latest, hotspot），读写可分别设置
+    std::string write_distribution = "tiered";        // 写入：10%热点key承担80%更新（原有行为）
+    std::string read_distribution = "uniform";        // 查询：均匀（原有行为）
+    double zipf_theta = 0.99;                         // zipfian/scrambled_zipfian/latest的指数θ
+    double hotspot_fraction = 0.01;                   // hotspot窗口占keyspace的比例
+    double hotspot_probability = 0.9;                 // 访问落在hotspot窗口内的概率
+    double hotspot_period_seconds = 60.0;             // hotspot窗口每隔多少秒移动一个窗口宽度（0=固定）
+
+    // 查询目标版本分布：uniform（测试期间写入的block，原有行为）, uniform_all, recent, exponential，
+    // 或逗号分隔的"名称:权重"混合，例如"exponential:0.95,uniform_all:0.05"
+    std::string version_distribution = "uniform";
+    size_t version_window = 128;                      // recent：最近N个block
+    double version_decay_blocks = 128.0;              // exponential：距head的平均block数
     
     // 静态方法
     static BenchmarkConfig from_args(int argc, char* argv[]);
@@ -38,6 +114,8 @@ struct BenchmarkConfig {
     
     // 实例方法
     void print_config() const;
+    nlohmann::ordered_json to_json() const;
+    ValueGeneratorParams value_generator_params() const;
     
     // 验证配置
     bool validate() const;
@@ -0,0 +1,241 @@
+#include "db_event_log.hpp"
+#include "../utils/logger.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+const char* condition_name(rocksdb::WriteStallCondition condition) {
+    switch (condition) {
+        case rocksdb::WriteStallCondition::kNormal: return "normal";
+        case rocksdb::WriteStallCondition::kDelayed: return "delayed";
+        case rocksdb::WriteStallCondition::kStopped: return "stopped";
+    }
+    return "unknown";
+}
+
+std::string flush_reason_name(rocksdb::FlushReason reason) {
+    switch (reason) {
+        case rocksdb::FlushReason::kWriteBufferFull: return "write_buffer_full";
+        case rocksdb::FlushReason::kWriteBufferManager: return "write_buffer_manager";
+        case rocksdb::FlushReason::kManualFlush: return "manual";
+        case rocksdb::FlushReason::kShutDown: return "shutdown";
+        case rocksdb::FlushReason::kErrorRecovery: return "error_recovery";
+        default: return "reason_" + std::to_string(static_cast<int>(reason));
+    }
+}
+
+std::string compaction_reason_name(rocksdb::CompactionReason reason) {
+    switch (reason) {
+        case rocksdb::CompactionReason::kLevelL0FilesNum: return "l0_file_count";
+        case rocksdb::CompactionReason::kLevelMaxLevelSize: return "level_size";
+        case rocksdb::CompactionReason::kManualCompaction: return "manual";
+        case rocksdb::CompactionReason::kFilesMarkedForCompaction: return "marked_files";
+        case rocksdb::CompactionReason::kBottommostFiles: return "bottommost_files";
+        case rocksdb::CompactionReason::kTtl: return "ttl";
+        case rocksdb::CompactionReason::kPeriodicCompaction: return "periodic";
+        default: return "reason_" + std::to_string(static_cast<int>(reason));
+    }
+}
+
+int severity(const std::string& condition) {
+    return condition == "stopped" ? 2 : condition == "delayed" ? 1 : 0;
+}
+
+}  // namespace
+
+const char* DBEvent::type_name() const {
+    switch (type) {
+        case Type::kFlush: return "flush";
+        case Type::kCompaction: return "compaction";
+        case Type::kStallChange: return "stall";
+    }
+    return "unknown";
+}
+
+int64_t DBEventLog::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void DBEventLog::record(DBEvent event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (event.type == DBEvent::Type::kStallChange) {
+        std::string key = event.db_name + "/" + event.cf_name;
+        auto it = open_windows_.find(key);
+        if (event.condition == "normal") {
+            if (it != open_windows_.end()) {
+                windows_[it->second].end_ns = event.start_ns;
+                windows_[it->second].open = false;
+                open_windows_.erase(it);
+            }
+        } else if (it == open_windows_.end()) {
+            StallWindow window;
+            window.db_name = event.db_name;
+            window.cf_name = event.cf_name;
+            window.condition = event.condition;
+            window.start_ns = event.start_ns;
+            window.open = true;
+            open_windows_[key] = windows_.size();
+            windows_.push_back(std::move(window));
+        } else if (severity(event.condition) > severity(windows_[it->second].condition)) {
+            windows_[it->second].condition = event.condition;   // delayed -> stopped
+        }
+    }
+
+    events_.push_back(std::move(event));
+}
+
+std::vector<DBEvent> DBEventLog::events() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_;
+}
+
+std::vector<DBEvent> DBEventLog::events_between(int64_t from_ns, int64_t to_ns) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<DBEvent> result;
+    for (const auto& event : events_) {
+        if (event.end_ns >= from_ns && event.start_ns <= to_ns) {
+            result.push_back(event);
+        }
+    }
+    return result;
+}
+
+std::vector<StallWindow> DBEventLog::stall_windows(int64_t until_ns) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<StallWindow> result = windows_;
+    for (auto& window : result) {
+        if (window.open) {
+            window.end_ns = until_ns;
+        }
+    }
+    return result;
+}
+
+DBEventLog::Totals DBEventLog::totals() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Totals totals;
+    for (const auto& event : events_) {
+        if (event.type == DBEvent::Type::kFlush) {
+            totals.flushes++;
+            totals.flush_bytes_written += event.bytes_written;
+        } else if (event.type == DBEvent::Type::kCompaction) {
+            totals.compactions++;
+            totals.compaction_micros += static_cast<uint64_t>((event.end_ns - event.start_ns) / 1000);
+            totals.compaction_bytes_read += event.bytes_read;
+            totals.compaction_bytes_written += event.bytes_written;
+        }
+    }
+    totals.stall_windows = windows_.size();
+    return totals;
+}
+
+bool DBEventLog::write_jsonl(const std::string& path, int64_t origin_ns) const {
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        utils::log_error("Failed to open event log file {}", path);
+        return false;
+    }
+
+    for (const auto& event : events()) {
+        nlohmann::ordered_json j;
+        j["type"] = event.type_name();
+        j["db"] = event.db_name;
+        j["cf"] = event.cf_name;
+        j["start_s"] = (event.start_ns - origin_ns) / 1e9;
+        j["duration_ms"] = event.duration_ms();
+        if (event.type == DBEvent::Type::kStallChange) {
+            j["condition"] = event.condition;
+            j["previous_condition"] = event.previous_condition;
+        } else {
+            j["job_id"] = event.job_id;
+            j["reason"] = event.reason;
+            j["input_level"] = event.input_level;
+            j["output_level"] = event.output_level;
+            j["input_files"] = event.input_files;
+            j["output_files"] = event.output_files;
+            j["bytes_read"] = event.bytes_read;
+            j["bytes_written"] = event.bytes_written;
+        }
+        out << j.dump() << '\n';
+    }
+    return out.good();
+}
+
+DBEventListener::DBEventListener(std::string db_name, std::shared_ptr<DBEventLog> log)
+    : db_name_(std::move(db_name)), log_(std::move(log)) {}
+
+void DBEventListener::OnFlushBegin(rocksdb::DB*, const rocksdb::FlushJobInfo& info) {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    flush_start_ns_[info.job_id] = DBEventLog::now_ns();
+}
+
+void DBEventListener::OnFlushCompleted(rocksdb::DB*, const rocksdb::FlushJobInfo& info) {
+    DBEvent event;
+    event.type = DBEvent::Type::kFlush;
+    event.db_name = db_name_;
+    event.cf_name = info.cf_name;
+    event.end_ns = DBEventLog::now_ns();
+    event.start_ns = event.end_ns;
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex_);
+        auto it = flush_start_ns_.find(info.job_id);
+        if (it != flush_start_ns_.end()) {
+            event.start_ns = it->second;
+            flush_start_ns_.erase(it);
+        }
+    }
+    event.job_id = info.job_id;
+    event.output_level = 0;
+    event.output_files = 1;
+    event.bytes_written = info.table_properties.data_size + info.table_properties.index_size +
+                          info.table_properties.filter_size;
+    event.reason = flush_reason_name(info.flush_reason);
+    if (info.triggered_writes_stop) {
+        event.reason += ",triggered_stop";
+    } else if (info.triggered_writes_slowdown) {
+        event.reason += ",triggered_slowdown";
+    }
+    log_->record(std::move(event));
+}
+
+void DBEventListener::OnCompactionCompleted(rocksdb::DB*, const rocksdb::CompactionJobInfo& info) {
+    DBEvent event;
+    event.type = DBEvent::Type::kCompaction;
+    event.db_name = db_name_;
+    event.cf_name = info.cf_name;
+    event.end_ns = DBEventLog::now_ns();
+    event.start_ns = event.end_ns - static_cast<int64_t>(info.stats.elapsed_micros) * 1000;
+    event.job_id = info.job_id;
+    event.input_level = info.base_input_level;
+    event.output_level = info.output_level;
+    event.input_files = info.stats.num_input_files;
+    event.output_files = info.stats.num_output_files;
+    event.bytes_read = info.stats.total_input_bytes;
+    event.bytes_written = info.stats.total_output_bytes;
+    event.reason = compaction_reason_name(info.compaction_reason);
+    log_->record(std::move(event));
+}
+
+void DBEventListener::OnStallConditionsChanged(const rocksdb::WriteStallInfo& info) {
+    DBEvent event;
+    event.type = DBEvent::Type::kStallChange;
+    event.db_name = db_name_;
+    event.cf_name = info.cf_name;
+    event.start_ns = DBEventLog::now_ns();
+    event.end_ns = event.start_ns;
+    event.condition = condition_name(info.condition.cur);
+    event.previous_condition = condition_name(info.condition.prev);
+    utils::log_debug("Write stall condition on {}/{}: {} -> {}", db_name_, info.cf_name,
+                     event.previous_condition, event.condition);
+    log_->record(std::move(event));
+}
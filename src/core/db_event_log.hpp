@@ -0,0 +1,96 @@
+#pragma once
+#include <rocksdb/listener.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// RocksDB后台事件：flush、compaction完成，以及写停顿状态变化
+struct DBEvent {
+    enum class Type { kFlush, kCompaction, kStallChange };
+
+    Type type = Type::kFlush;
+    std::string db_name;             // 策略内的DB名称（main / range_index / data_storage）
+    std::string cf_name;
+    int64_t start_ns = 0;            // steady_clock时间点（纳秒）
+    int64_t end_ns = 0;
+    int job_id = 0;
+    int input_level = -1;
+    int output_level = -1;
+    uint64_t input_files = 0;
+    uint64_t output_files = 0;
+    uint64_t bytes_read = 0;
+    uint64_t bytes_written = 0;
+    std::string reason;              // flush/compaction原因
+    std::string condition;           // 写停顿：当前状态（normal / delayed / stopped）
+    std::string previous_condition;
+
+    double duration_ms() const { return (end_ns - start_ns) / 1e6; }
+    const char* type_name() const;
+};
+
+// 一段写停顿窗口：从离开normal到回到normal，condition取窗口内最严重的状态
+struct StallWindow {
+    std::string db_name;
+    std::string cf_name;
+    std::string condition;
+    int64_t start_ns = 0;
+    int64_t end_ns = 0;              // 仍在停顿中的窗口由stall_windows(until_ns)截断
+    bool open = false;
+};
+
+// 所有DB共享的事件时间线，由DBEventListener在RocksDB后台线程中追加
+class DBEventLog {
+public:
+    struct Totals {
+        uint64_t flushes = 0;
+        uint64_t flush_bytes_written = 0;
+        uint64_t compactions = 0;
+        uint64_t compaction_micros = 0;
+        uint64_t compaction_bytes_read = 0;
+        uint64_t compaction_bytes_written = 0;
+        uint64_t stall_windows = 0;
+    };
+
+    // 事件时间戳使用的时钟，与测试线程的steady_clock一致
+    static int64_t now_ns();
+
+    void record(DBEvent event);
+
+    std::vector<DBEvent> events() const;
+    std::vector<DBEvent> events_between(int64_t from_ns, int64_t to_ns) const;
+    std::vector<StallWindow> stall_windows(int64_t until_ns) const;
+    Totals totals() const;
+
+    // 每行一个事件，时间相对origin_ns（秒）
+    bool write_jsonl(const std::string& path, int64_t origin_ns) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<DBEvent> events_;
+    std::vector<StallWindow> windows_;
+    std::map<std::string, size_t> open_windows_;   // db_name/cf_name -> windows_下标
+};
+
+// 注册到每个RocksDB实例的监听器，回调中只做记录，不阻塞后台线程
+class DBEventListener : public rocksdb::EventListener {
+public:
+    DBEventListener(std::string db_name, std::shared_ptr<DBEventLog> log);
+
+    const char* Name() const override { return "DBEventListener"; }
+
+    void OnFlushBegin(rocksdb::DB* db, const rocksdb::FlushJobInfo& info) override;
+    void OnFlushCompleted(rocksdb::DB* db, const rocksdb::FlushJobInfo& info) override;
+    void OnCompactionCompleted(rocksdb::DB* db, const rocksdb::CompactionJobInfo& info) override;
+    void OnStallConditionsChanged(const rocksdb::WriteStallInfo& info) override;
+
+private:
+    std::string db_name_;
+    std::shared_ptr<DBEventLog> log_;
+
+    // FlushJobInfo不带耗时，用OnFlushBegin记录开始时刻
+    std::mutex flush_mutex_;
+    std::map<int, int64_t> flush_start_ns_;
+};
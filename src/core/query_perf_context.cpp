@@ -0,0 +1,126 @@
+#include "query_perf_context.hpp"
+#include <rocksdb/iostats_context.h>
+#include <rocksdb/perf_context.h>
+#include <rocksdb/perf_level.h>
+
+QueryPerfCounters QueryPerfCounters::capture() {
+    const rocksdb::PerfContext* perf = rocksdb::get_perf_context();
+    const rocksdb::IOStatsContext* io = rocksdb::get_iostats_context();
+
+    QueryPerfCounters counters;
+    counters.block_reads = perf->block_read_count;
+    counters.block_read_bytes = perf->block_read_byte;
+    counters.block_read_nanos = perf->block_read_time;
+    counters.block_cache_hits = perf->block_cache_hit_count;
+    counters.index_block_reads = perf->index_block_read_count;
+    counters.filter_block_reads = perf->filter_block_read_count;
+    counters.bloom_checks = perf->bloom_memtable_hit_count + perf->bloom_memtable_miss_count +
+                            perf->bloom_sst_hit_count + perf->bloom_sst_miss_count;
+    counters.bloom_sst_filtered = perf->bloom_sst_miss_count;
+    counters.memtable_probes = perf->get_from_memtable_count + perf->seek_on_memtable_count;
+    counters.sst_seeks = perf->seek_child_seek_count;
+    counters.internal_keys_skipped = perf->internal_key_skipped_count;
+    counters.tombstones_skipped = perf->internal_delete_skipped_count;
+    counters.io_bytes_read = io->bytes_read;
+    counters.io_read_nanos = io->read_nanos;
+    return counters;
+}
+
+QueryPerfCounters& QueryPerfCounters::operator+=(const QueryPerfCounters& other) {
+    block_reads += other.block_reads;
+    block_read_bytes += other.block_read_bytes;
+    block_read_nanos += other.block_read_nanos;
+    block_cache_hits += other.block_cache_hits;
+    index_block_reads += other.index_block_reads;
+    filter_block_reads += other.filter_block_reads;
+    bloom_checks += other.bloom_checks;
+    bloom_sst_filtered += other.bloom_sst_filtered;
+    memtable_probes += other.memtable_probes;
+    sst_seeks += other.sst_seeks;
+    internal_keys_skipped += other.internal_keys_skipped;
+    tombstones_skipped += other.tombstones_skipped;
+    io_bytes_read += other.io_bytes_read;
+    io_read_nanos += other.io_read_nanos;
+    return *this;
+}
+
+QueryPerfCounters QueryPerfCounters::operator-(const QueryPerfCounters& earlier) const {
+    auto diff = [](uint64_t now, uint64_t before) { return now > before ? now - before : uint64_t{0}; };
+    QueryPerfCounters result;
+    result.block_reads = diff(block_reads, earlier.block_reads);
+    result.block_read_bytes = diff(block_read_bytes, earlier.block_read_bytes);
+    result.block_read_nanos = diff(block_read_nanos, earlier.block_read_nanos);
+    result.block_cache_hits = diff(block_cache_hits, earlier.block_cache_hits);
+    result.index_block_reads = diff(index_block_reads, earlier.index_block_reads);
+    result.filter_block_reads = diff(filter_block_reads, earlier.filter_block_reads);
+    result.bloom_checks = diff(bloom_checks, earlier.bloom_checks);
+    result.bloom_sst_filtered = diff(bloom_sst_filtered, earlier.bloom_sst_filtered);
+    result.memtable_probes = diff(memtable_probes, earlier.memtable_probes);
+    result.sst_seeks = diff(sst_seeks, earlier.sst_seeks);
+    result.internal_keys_skipped = diff(internal_keys_skipped, earlier.internal_keys_skipped);
+    result.tombstones_skipped = diff(tombstones_skipped, earlier.tombstones_skipped);
+    result.io_bytes_read = diff(io_bytes_read, earlier.io_bytes_read);
+    result.io_read_nanos = diff(io_read_nanos, earlier.io_read_nanos);
+    return result;
+}
+
+namespace query_perf {
+
+namespace {
+
+struct ThreadState {
+    bool active = false;
+    rocksdb::PerfLevel previous_level = rocksdb::PerfLevel::kDisable;
+    std::vector<StageCounters> stages;
+};
+
+thread_local ThreadState state;
+
+}  // namespace
+
+void begin_sample() {
+    state.active = true;
+    state.stages.clear();
+    state.previous_level = rocksdb::GetPerfLevel();
+    // 计时不含mutex等待；采样查询本身会因计时略微变慢
+    rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableTimeExceptForMutex);
+    rocksdb::get_perf_context()->Reset();
+    rocksdb::get_iostats_context()->Reset();
+}
+
+Sample end_sample() {
+    Sample sample;
+    sample.total = QueryPerfCounters::capture();
+    sample.stages = std::move(state.stages);
+    state.stages.clear();
+    state.active = false;
+    rocksdb::SetPerfLevel(state.previous_level);
+    return sample;
+}
+
+bool active() {
+    return state.active;
+}
+
+StageScope::StageScope(const char* stage) : stage_(stage), active_(state.active) {
+    if (active_) {
+        start_ = QueryPerfCounters::capture();
+    }
+}
+
+StageScope::~StageScope() {
+    if (!active_) {
+        return;
+    }
+    QueryPerfCounters delta = QueryPerfCounters::capture() - start_;
+    for (auto& entry : state.stages) {
+        if (entry.name == stage_) {
+            entry.calls++;
+            entry.counters += delta;
+            return;
+        }
+    }
+    state.stages.push_back(StageCounters{stage_, 1, delta});
+}
+
+}  // namespace query_perf
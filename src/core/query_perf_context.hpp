@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 一次查询（或查询中的一个阶段）在RocksDB内部的工作量，来自PerfContext/IOStatsContext前后差值
+struct QueryPerfCounters {
+    uint64_t block_reads = 0;           // 从文件读取的block数（未命中block cache）
+    uint64_t block_read_bytes = 0;
+    uint64_t block_read_nanos = 0;
+    uint64_t block_cache_hits = 0;
+    uint64_t index_block_reads = 0;
+    uint64_t filter_block_reads = 0;
+    uint64_t bloom_checks = 0;          // memtable + SST的bloom检查次数
+    uint64_t bloom_sst_filtered = 0;    // SST bloom判定不存在、跳过文件的次数
+    uint64_t memtable_probes = 0;       // memtable的Get/Seek次数
+    uint64_t sst_seeks = 0;             // 迭代器对子迭代器（memtable/SST）的seek次数
+    uint64_t internal_keys_skipped = 0;
+    uint64_t tombstones_skipped = 0;
+    uint64_t io_bytes_read = 0;         // 文件系统层实际读取字节
+    uint64_t io_read_nanos = 0;
+
+    static QueryPerfCounters capture();
+
+    QueryPerfCounters& operator+=(const QueryPerfCounters& other);
+    QueryPerfCounters operator-(const QueryPerfCounters& earlier) const;
+};
+
+// 采样查询的内部工作量分解。只有被采样的查询才打开PerfContext，
+// 其余查询中StageScope只做一次thread_local判断
+namespace query_perf {
+
+struct StageCounters {
+    std::string name;
+    uint64_t calls = 0;
+    QueryPerfCounters counters;
+};
+
+struct Sample {
+    uint64_t latency_ns = 0;
+    QueryPerfCounters total;
+    std::vector<StageCounters> stages;   // 策略内部各阶段，例如dual的range_index_get / data_seek
+};
+
+// 在当前线程开启采样：提升perf level并清零上下文
+void begin_sample();
+// 结束采样并恢复perf level，返回整个查询和各阶段的计数
+Sample end_sample();
+bool active();
+
+// 策略在查询的各阶段使用：采样期间把阶段内的计数差值累加到同名阶段
+class StageScope {
+public:
+    explicit StageScope(const char* stage);
+    ~StageScope();
+
+    StageScope(const StageScope&) = delete;
+    StageScope& operator=(const StageScope&) = delete;
+
+private:
+    const char* stage_;
+    bool active_;
+    QueryPerfCounters start_;
+};
+
+}  // namespace query_perf
@@ -3,8 +3,11 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <memory>
 #include <rocksdb/db.h>
 
+class DBEventLog;
+
 using BlockNum = uint64_t;
 using Value = std::string;
 
@@ -15,6 +18,27 @@ struct DataRecord {
     Value value;
 };
 
+// 单个block写入的阶段耗时分解（多DB策略使用，例如dual的range index / data两路写入）
+struct WriteStageTiming {
+    double range_ms = 0.0;   // range index DB写入耗时
+    double data_ms = 0.0;    // data storage DB写入耗时
+    double total_ms = 0.0;   // 两路写入的墙钟耗时
+
+    // 两路写入重叠的时间；串行写入时为0
+    double overlap_ms() const {
+        double overlap = range_ms + data_ms - total_ms;
+        return overlap > 0.0 ? overlap : 0.0;
+    }
+};
+
+// Initial load阶段的策略内部耗时分解
+struct InitialLoadStats {
+    double encode_ms = 0.0;          // 把records编码进WriteBatch的耗时（生产者侧）
+    double backpressure_ms = 0.0;    // 等待提交流水线空闲buffer的耗时
+    double commit_ms = 0.0;          // db->Write耗时（提交线程）
+    uint64_t batches_committed = 0;
+};
+
 // 存储策略接口 - 每个策略完全独立管理自己的数据结构
 class IStorageStrategy {
 public:
@@ -41,6 +65,18 @@ public:
     virtual std::optional<Value> query_latest_value(rocksdb::DB* db, 
                                                    const std::string& addr_slot) = 0;
     
+    // 批量查询最新值（read-before-write写入模式），结果与addr_slots一一对应。
+    // 默认逐个调用query_latest_value，能用MultiGet批量点查的策略可以覆盖
+    virtual std::vector<std::optional<Value>> query_latest_values(rocksdb::DB* db,
+                                                                  const std::vector<std::string>& addr_slots) {
+        std::vector<std::optional<Value>> values;
+        values.reserve(addr_slots.size());
+        for (const auto& addr_slot : addr_slots) {
+            values.push_back(query_latest_value(db, addr_slot));
+        }
+        return values;
+    }
+    
     // 历史版本查询 - 苛刻测试用，实现复杂语义
     virtual std::optional<Value> query_historical_version(rocksdb::DB* db, 
                                                          const std::string& addr_slot, 
@@ -50,6 +86,39 @@ public:
         return query_latest_value(db, addr_slot);
     }
     
+    // 版本历史扫描：addr_slot在[from_block, to_block]内的(block, value)，按block升序，最多limit个。
+    // 默认返回空（不支持扫描的策略在工作负载中表现为未命中）
+    virtual std::vector<std::pair<BlockNum, Value>> scan_version_history(rocksdb::DB* db,
+                                                                         const std::string& addr_slot,
+                                                                         BlockNum from_block,
+                                                                         BlockNum to_block,
+                                                                         size_t limit) {
+        return {};
+    }
+    
+    // Initial load阶段耗时分解，未使用批量导入流水线的策略返回nullopt
+    virtual std::optional<InitialLoadStats> get_initial_load_stats() const {
+        return std::nullopt;
+    }
+    
+    // 当前线程最近一次write_batch的阶段耗时，单DB策略返回nullopt
+    virtual std::optional<WriteStageTiming> get_last_write_timing() const {
+        return std::nullopt;
+    }
+    
+    // 策略自己打开的RocksDB实例（名称, DB），用于运行时采样；只使用主DB的策略返回空
+    virtual std::vector<std::pair<std::string, rocksdb::DB*>> get_strategy_dbs() const {
+        return {};
+    }
+    
+    // 策略自己持有的进程内结构的内存占用（名称, 字节），RocksDB内部内存由DBManager统一统计
+    virtual std::vector<std::pair<std::string, uint64_t>> get_memory_usage() const {
+        return {};
+    }
+    
+    // 在initialize之前调用：策略自己打开的DB需要注册DBEventListener写入该时间线
+    virtual void set_event_log(std::shared_ptr<DBEventLog> event_log) {}
+    
     // 策略信息
     virtual std::string get_strategy_name() const = 0;
     virtual std::string get_description() const = 0;
@@ -4,6 +4,9 @@
 #include <filesystem>
 #include <rocksdb/options.h>
 #include <rocksdb/table_properties.h>
+#include <rocksdb/table.h>
+#include <rocksdb/utilities/memory_util.h>
+#include "../utils/process_memory.hpp"
 #include <algorithm>
 
 StrategyDBManager::StrategyDBManager(const std::string& db_path, 
@@ -11,6 +14,7 @@ StrategyDBManager::StrategyDBManager(const std::string& db_path,
     : db_path_(db_path), strategy_(std::move(strategy)) {
     
     statistics_ = rocksdb::CreateDBStatistics();
+    event_log_ = std::make_shared<DBEventLog>();
 }
 
 StrategyDBManager::~StrategyDBManager() {
@@ -30,6 +34,7 @@ bool StrategyDBManager::open(bool force_clean) {
         }
 
         rocksdb::Options options = get_db_options();
+        strategy_->set_event_log(event_log_);
         
         // Create database if not exists
         rocksdb::Status status = rocksdb::DB::Open(options, db_path_, &db_);
@@ -103,11 +108,39 @@ bool StrategyDBManager::write_batch(const std::vector<DataRecord>& records) {
 }
 
 std::optional<Value> StrategyDBManager::query_latest_value(const std::string& addr_slot) {
-    utils::log_error("Should not call this function");
-    return std::nullopt;
+    if (!is_open_) {
+        utils::log_error("Database is not open");
+        return std::nullopt;
+    }
+
+    try {
+        return strategy_->query_latest_value(db_.get(), addr_slot);
+    } catch (const std::exception& e) {
+        utils::log_error("Exception during query_latest_value: {}", e.what());
+        return std::nullopt;
+    }
+}
+
+std::vector<std::optional<Value>> StrategyDBManager::query_latest_values(const std::vector<std::string>& addr_slots) {
+    if (!is_open_) {
+        utils::log_error("Database is not open");
+        return std::vector<std::optional<Value>>(addr_slots.size());
+    }
+
+    try {
+        return strategy_->query_latest_values(db_.get(), addr_slots);
+    } catch (const std::exception& e) {
+        utils::log_error("Exception during query_latest_values: {}", e.what());
+        return std::vector<std::optional<Value>>(addr_slots.size());
+    }
 }
 
 std::optional<Value> StrategyDBManager::query_historical_version(const std::string& addr_slot, BlockNum target_version) {
+    if (!is_open_) {
+        utils::log_error("Database is not open");
+        return std::nullopt;
+    }
+
     try {
         // 调用strategy的历史版本查询方法
         return strategy_->query_historical_version(db_.get(), addr_slot, target_version);
@@ -117,6 +150,22 @@ std::optional<Value> StrategyDBManager::query_historical_version(const std::stri
     }
 }
 
+std::vector<std::pair<BlockNum, Value>> StrategyDBManager::scan_version_history(const std::string& addr_slot,
+                                                                                BlockNum from_block,
+                                                                                BlockNum to_block, size_t limit) {
+    if (!is_open_) {
+        utils::log_error("Database is not open");
+        return {};
+    }
+
+    try {
+        return strategy_->scan_version_history(db_.get(), addr_slot, from_block, to_block, limit);
+    } catch (const std::exception& e) {
+        utils::log_error("Exception during scan_version_history: {}", e.what());
+        return {};
+    }
+}
+
 bool StrategyDBManager::write_initial_load_batch(const std::vector<DataRecord>& records) {
     if (!is_open_) {
         utils::log_error("Database is not open");
@@ -130,6 +179,32 @@ void StrategyDBManager::flush_all_batches() {
     return strategy_->flush_all_batches();
 }
 
+bool StrategyDBManager::compact_all() {
+    if (!is_open_ || !db_) {
+        utils::log_error("Database is not open");
+        return false;
+    }
+    strategy_->flush_all_batches();
+
+    std::vector<std::pair<std::string, rocksdb::DB*>> dbs = {{"main", db_.get()}};
+    for (const auto& [name, db] : strategy_->get_strategy_dbs()) {
+        if (db) {
+            dbs.emplace_back(name, db);
+        }
+    }
+    rocksdb::CompactRangeOptions options;
+    options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForce;
+    bool success = true;
+    for (const auto& [name, db] : dbs) {
+        rocksdb::Status status = db->CompactRange(options, nullptr, nullptr);
+        if (!status.ok()) {
+            utils::log_error("Manual compaction of {} failed: {}", name, status.ToString());
+            success = false;
+        }
+    }
+    return success;
+}
+
 // Legacy interface for compatibility
 bool StrategyDBManager::write_batch(const std::vector<ChangeSetRecord>& changes, 
                                    const std::vector<IndexRecord>& indices) {
@@ -196,6 +271,7 @@ rocksdb::Options StrategyDBManager::get_db_options() {
     
     // Enable statistics for metrics collection
     options.statistics = statistics_;
+    options.listeners.push_back(std::make_shared<DBEventListener>("main", event_log_));
     
     utils::log_info("Database options configured with Bloom filter and statistics");
     utils::log_info("Large memory optimizations enabled: 2GB memtable, 8GB WAL, 16/8 background threads");
@@ -230,9 +306,8 @@ uint64_t StrategyDBManager::get_compaction_bytes_written() const {
 }
 
 uint64_t StrategyDBManager::get_compaction_time_micros() const {
-    if (!statistics_) return 0;
-    // Use approximation since COMPACT_TIME_MICROS might not be available
-    return statistics_->getTickerCount(rocksdb::COMPACT_READ_BYTES) / 1024; // rough approximation
+    // 来自EventListener记录的每次compaction实际耗时（包含策略自己打开的DB）
+    return event_log_ ? event_log_->totals().compaction_micros : 0;
 }
 
 void StrategyDBManager::debug_bloom_filter_stats() const {
@@ -280,4 +355,123 @@ StrategyDBManager::CompactionStats StrategyDBManager::get_compaction_stats() con
     stats.bytes_written = get_compaction_bytes_written();
     stats.time_micros = get_compaction_time_micros();
     return stats;
-}
\ No newline at end of file
+}
+
+std::vector<StrategyDBManager::DBRuntimeSample> StrategyDBManager::sample_runtime_metrics() const {
+    std::vector<DBRuntimeSample> samples;
+    if (!is_open_ || !db_) {
+        return samples;
+    }
+    samples.push_back(sample_db("main", db_.get()));
+    for (const auto& [name, db] : strategy_->get_strategy_dbs()) {
+        if (db) {
+            samples.push_back(sample_db(name, db));
+        }
+    }
+    return samples;
+}
+
+StrategyDBManager::DBRuntimeSample StrategyDBManager::sample_db(const std::string& name, rocksdb::DB* db) {
+    DBRuntimeSample sample;
+    sample.name = name;
+
+    auto int_property = [db](const std::string& property) -> uint64_t {
+        uint64_t value = 0;
+        return db->GetIntProperty(property, &value) ? value : 0;
+    };
+    sample.pending_compaction_bytes = int_property("rocksdb.estimate-pending-compaction-bytes");
+    sample.l0_files = int_property("rocksdb.num-files-at-level0");
+    sample.memtable_bytes = int_property("rocksdb.cur-size-all-mem-tables");
+    sample.immutable_memtables = int_property("rocksdb.num-immutable-mem-table");
+    sample.running_compactions = int_property("rocksdb.num-running-compactions");
+    sample.running_flushes = int_property("rocksdb.num-running-flushes");
+    sample.delayed_write_rate = int_property("rocksdb.actual-delayed-write-rate");
+    sample.write_stopped = int_property("rocksdb.is-write-stopped");
+    sample.live_sst_bytes = int_property("rocksdb.live-sst-files-size");
+    sample.live_blob_bytes = int_property("rocksdb.live-blob-file-size");
+    sample.estimate_live_data_bytes = int_property("rocksdb.estimate-live-data-size");
+
+    auto statistics = db->GetOptions().statistics;
+    if (statistics) {
+        sample.stall_micros = statistics->getTickerCount(rocksdb::STALL_MICROS);
+        sample.bytes_written = statistics->getTickerCount(rocksdb::BYTES_WRITTEN);
+        sample.flush_write_bytes = statistics->getTickerCount(rocksdb::FLUSH_WRITE_BYTES);
+        sample.compact_write_bytes = statistics->getTickerCount(rocksdb::COMPACT_WRITE_BYTES);
+        sample.block_cache_hits = statistics->getTickerCount(rocksdb::BLOCK_CACHE_HIT);
+        sample.block_cache_misses = statistics->getTickerCount(rocksdb::BLOCK_CACHE_MISS);
+        sample.wal_bytes = statistics->getTickerCount(rocksdb::WAL_FILE_BYTES);
+        sample.logical_read_bytes = statistics->getTickerCount(rocksdb::BYTES_READ) +
+                                    statistics->getTickerCount(rocksdb::ITER_BYTES_READ);
+        sample.file_read_bytes = statistics->getTickerCount(rocksdb::LAST_LEVEL_READ_BYTES) +
+                                 statistics->getTickerCount(rocksdb::NON_LAST_LEVEL_READ_BYTES);
+    }
+    return sample;
+}
+
+uint64_t StrategyDBManager::MemoryUsageSample::rocksdb_bytes() const {
+    uint64_t total = 0;
+    for (const auto& db : dbs) {
+        total += db.memtable_total + db.table_readers + db.cache_total;
+    }
+    return total;
+}
+
+uint64_t StrategyDBManager::MemoryUsageSample::components_bytes() const {
+    uint64_t total = 0;
+    for (const auto& [name, bytes] : components) {
+        total += bytes;
+    }
+    return total;
+}
+
+StrategyDBManager::MemoryUsageSample StrategyDBManager::sample_memory_usage() const {
+    MemoryUsageSample sample;
+    if (is_open_ && db_) {
+        std::unordered_set<const rocksdb::Cache*> counted_caches;
+        sample.dbs.push_back(sample_db_memory("main", db_.get(), counted_caches));
+        for (const auto& [name, db] : strategy_->get_strategy_dbs()) {
+            if (db) {
+                sample.dbs.push_back(sample_db_memory(name, db, counted_caches));
+            }
+        }
+        sample.components = strategy_->get_memory_usage();
+    }
+    auto process = utils::read_process_memory();
+    sample.rss_bytes = process.rss_bytes;
+    sample.peak_rss_bytes = process.peak_rss_bytes;
+    return sample;
+}
+
+StrategyDBManager::DBMemoryUsage StrategyDBManager::sample_db_memory(
+    const std::string& name, rocksdb::DB* db, std::unordered_set<const rocksdb::Cache*>& counted_caches) {
+    DBMemoryUsage usage;
+    usage.name = name;
+
+    // 该DB使用的cache：row cache以及block-based table的block cache
+    std::unordered_set<const rocksdb::Cache*> caches;
+    auto add_cache = [&](const rocksdb::Cache* cache) {
+        if (cache && counted_caches.insert(cache).second) {
+            caches.insert(cache);
+        }
+    };
+    auto options = db->GetOptions();
+    add_cache(options.row_cache.get());
+    if (options.table_factory) {
+        const auto* table_options = options.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>();
+        if (table_options) {
+            add_cache(table_options->block_cache.get());
+        }
+    }
+
+    std::map<rocksdb::MemoryUtil::UsageType, uint64_t> by_type;
+    rocksdb::Status status = rocksdb::MemoryUtil::GetApproximateMemoryUsageByType({db}, caches, &by_type);
+    if (!status.ok()) {
+        utils::log_debug("GetApproximateMemoryUsageByType failed for {}: {}", name, status.ToString());
+        return usage;
+    }
+    usage.memtable_total = by_type[rocksdb::MemoryUtil::kMemTableTotal];
+    usage.memtable_unflushed = by_type[rocksdb::MemoryUtil::kMemTableUnFlushed];
+    usage.table_readers = by_type[rocksdb::MemoryUtil::kTableReadersTotal];
+    usage.cache_total = by_type[rocksdb::MemoryUtil::kCacheTotal];
+    return usage;
+}
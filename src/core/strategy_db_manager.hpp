@@ -1,10 +1,12 @@
 #pragma once
 #include "storage_strategy.hpp"
 #include "types.hpp"
+#include "db_event_log.hpp"
 #include <rocksdb/db.h>
 #include <rocksdb/statistics.h>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
 class StrategyDBManager {
 public:
@@ -23,9 +25,14 @@ public:
     // 新的统一接口
     bool write_batch(const std::vector<DataRecord>& records);
     std::optional<Value> query_latest_value(const std::string& addr_slot);
+    // 批量查询最新值，结果与addr_slots一一对应（策略支持时使用MultiGet）
+    std::vector<std::optional<Value>> query_latest_values(const std::vector<std::string>& addr_slots);
     
     // 历史版本查询接口 - 用于苛刻测试
     std::optional<Value> query_historical_version(const std::string& addr_slot, BlockNum target_version);
+    // 版本历史扫描：[from_block, to_block]内的版本，按block升序，最多limit个
+    std::vector<std::pair<BlockNum, Value>> scan_version_history(const std::string& addr_slot, BlockNum from_block,
+                                                                 BlockNum to_block, size_t limit);
     
     // Initial Load专用接口 - 优化首次导入性能
     bool write_initial_load_batch(const std::vector<DataRecord>& records);
@@ -40,6 +47,15 @@ public:
 
     void flush_all_batches();
     
+    // 对主DB和策略DB依次做整个key空间的手动compaction（含最底层），全部成功时返回true
+    bool compact_all();
+    
+    // Initial load阶段的策略内部耗时分解
+    std::optional<InitialLoadStats> get_initial_load_stats() const { return strategy_->get_initial_load_stats(); }
+    
+    // 当前线程最近一次write_batch的阶段耗时（仅多DB策略提供）
+    std::optional<WriteStageTiming> get_last_write_timing() const { return strategy_->get_last_write_timing(); }
+    
     // Get RocksDB statistics
     uint64_t get_bloom_filter_hits() const;
     uint64_t get_bloom_filter_misses() const;
@@ -70,13 +86,73 @@ public:
     
     BloomFilterStats get_bloom_filter_stats() const;
     CompactionStats get_compaction_stats() const;
+    
+    // 单个DB的运行时状态采样：property为当前值，ticker为累计值
+    struct DBRuntimeSample {
+        std::string name;
+        uint64_t pending_compaction_bytes = 0;
+        uint64_t l0_files = 0;
+        uint64_t memtable_bytes = 0;
+        uint64_t immutable_memtables = 0;
+        uint64_t running_compactions = 0;
+        uint64_t running_flushes = 0;
+        uint64_t delayed_write_rate = 0;
+        uint64_t write_stopped = 0;
+        uint64_t stall_micros = 0;
+        uint64_t bytes_written = 0;
+        uint64_t flush_write_bytes = 0;
+        uint64_t compact_write_bytes = 0;
+        uint64_t block_cache_hits = 0;
+        uint64_t block_cache_misses = 0;
+        // 放大统计：ticker为打开DB以来的累计值，property为当前值
+        uint64_t wal_bytes = 0;
+        uint64_t logical_read_bytes = 0;     // Get/MultiGet返回的value字节 + 迭代器读取的key/value字节
+        uint64_t file_read_bytes = 0;        // 用户读取从SST文件读出的字节（不含compaction）
+        uint64_t live_sst_bytes = 0;
+        uint64_t live_blob_bytes = 0;
+        uint64_t estimate_live_data_bytes = 0;
+    };
+    
+    // 采样主DB以及策略自己打开的所有DB
+    std::vector<DBRuntimeSample> sample_runtime_metrics() const;
+    
+    // 单个DB的内存占用（MemoryUtil::GetApproximateMemoryUsageByType）
+    struct DBMemoryUsage {
+        std::string name;
+        uint64_t memtable_total = 0;       // 所有memtable（含已写满等待flush的）
+        uint64_t memtable_unflushed = 0;
+        uint64_t table_readers = 0;        // SST的index/filter等（未放入block cache时）
+        uint64_t cache_total = 0;          // 该DB使用的block cache和row cache（共享的cache只计入第一个DB）
+    };
+    
+    // 内存占用采样：各DB的RocksDB内存、策略内结构，以及进程RSS
+    struct MemoryUsageSample {
+        std::vector<DBMemoryUsage> dbs;
+        std::vector<std::pair<std::string, uint64_t>> components;
+        uint64_t rss_bytes = 0;
+        uint64_t peak_rss_bytes = 0;
+        
+        uint64_t rocksdb_bytes() const;
+        uint64_t components_bytes() const;
+    };
+    
+    MemoryUsageSample sample_memory_usage() const;
+    
+    // 主DB和策略DB共享的flush/compaction/写停顿事件时间线
+    std::shared_ptr<DBEventLog> get_event_log() const { return event_log_; }
 
 private:
     std::string db_path_;
     std::unique_ptr<rocksdb::DB> db_;
     std::unique_ptr<IStorageStrategy> strategy_;
     std::shared_ptr<rocksdb::Statistics> statistics_;
+    std::shared_ptr<DBEventLog> event_log_;
     bool is_open_ = false;
     
     rocksdb::Options get_db_options();
+    
+    static DBRuntimeSample sample_db(const std::string& name, rocksdb::DB* db);
+    // counted_caches：已计入其他DB的cache，多个DB共享同一cache时只计一次
+    static DBMemoryUsage sample_db_memory(const std::string& name, rocksdb::DB* db,
+                                          std::unordered_set<const rocksdb::Cache*>& counted_caches);
 };
\ No newline at end of file
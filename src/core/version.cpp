@@ -2,38 +2,46 @@
 #include <fmt/core.h>
 #include <iostream>
 
-void print_version_info() {
-    std::cout << fmt::format(R"(
-RocksDB Benchmark Tool
-=======================
-Version: 1.0.0
-Git Commit: {}
-Git Branch: {}
-Git Date: {}
-Build Time: {}
-
-Build System: CMake + vcpkg
-Compiler: C++23
-)",
+BuildInfo get_build_info() {
+    BuildInfo info;
+    info.version = "1.0.0";
 #ifdef GIT_COMMIT_HASH
-        GIT_COMMIT_HASH,
+    info.git_commit = GIT_COMMIT_HASH;
 #else
-        "unknown",
+    info.git_commit = "unknown";
 #endif
 #ifdef GIT_BRANCH
-        GIT_BRANCH,
+    info.git_branch = GIT_BRANCH;
 #else
-        "unknown", 
+    info.git_branch = "unknown";
 #endif
 #ifdef GIT_COMMIT_DATE
-        GIT_COMMIT_DATE,
+    info.git_date = GIT_COMMIT_DATE;
 #else
-        "unknown",
+    info.git_date = "unknown";
 #endif
 #ifdef BUILD_TIME
-        BUILD_TIME
+    info.build_time = BUILD_TIME;
 #else
-        "unknown"
+    info.build_time = "unknown";
 #endif
+    return info;
+}
+
+void print_version_info() {
+    BuildInfo info = get_build_info();
+    std::cout << fmt::format(R"(
+RocksDB Benchmark Tool
+=======================
+Version: {}
+Git Commit: {}
+Git Branch: {}
+Git Date: {}
+Build Time: {}
+
+Build System: CMake + vcpkg
+Compiler: C++23
+)",
+        info.version, info.git_commit, info.git_branch, info.git_date, info.build_time
     );
 }
\ No newline at end of file
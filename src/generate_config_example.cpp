@@ -1,11 +1,21 @@
 #include <CLI/CLI.hpp>
 #include <nlohmann/json.hpp>
+#include "benchmark/scenario.hpp"
 #include <iostream>
 #include <fstream>
 
 using json = nlohmann::json;
 
-int main() {
+int main(int argc, char* argv[]) {
+    CLI::App app{"Print an example configuration"};
+    bool scenario = false;
+    app.add_flag("--scenario", scenario, "Print an example multi-phase scenario file (for --scenario) instead");
+    CLI11_PARSE(app, argc, argv);
+    
+    if (scenario) {
+        std::cout << example_scenario_json().dump(4) << std::endl;
+        return 0;
+    }
     
     // 创建JSON配置示例
     json config_json;
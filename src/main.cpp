@@ -2,11 +2,17 @@
 #include "core/strategy_db_manager.hpp"
 #include "benchmark/strategy_scenario_runner.hpp"
 #include "benchmark/metrics_collector.hpp"
+#include "benchmark/trace_replayer.hpp"
+#include "benchmark/workload_preset.hpp"
+#include "benchmark/scenario.hpp"
+#include "benchmark/result_document.hpp"
 #include "utils/logger.hpp"
+#include "utils/instrumented_mutex.hpp"
 #include "strategies/strategy_factory.hpp"
 #include <iostream>
 #include <string>
 #include <memory>
+#include <optional>
 
 bool handle_existing_data(const std::string& db_path) {
     utils::log_error("Database data already exists at: {}", db_path);
@@ -37,6 +43,25 @@ int main(int argc, char* argv[]) {
         
         utils::log_info("RocksDB Historical Version Query Test Tool Starting...");
         config.print_config();
+        LockStatsRegistry::set_enabled(config.lock_stats);
+        
+        // 预设名称和场景文件在打开数据库之前检查
+        std::vector<std::string> workload_presets;
+        if (!config.workload_suite.empty()) {
+            try {
+                workload_presets = parse_workload_suite(config.workload_suite);
+            } catch (const std::invalid_argument& e) {
+                throw ConfigError(e.what());
+            }
+        }
+        std::optional<Scenario> scenario;
+        if (!config.scenario_file.empty()) {
+            try {
+                scenario = load_scenario(config.scenario_file);
+            } catch (const std::exception& e) {
+                throw ConfigError(e.what());
+            }
+        }
         
         // Create the storage strategy based on configuration
         auto strategy = StorageStrategyFactory::create_strategy(config.storage_strategy, config);
@@ -63,9 +88,42 @@ int main(int argc, char* argv[]) {
         utils::log_info("Database opened successfully at: {} with strategy: {}", 
                        config.db_path, config.storage_strategy);
         
+        // 重放trace：用录制的负载代替合成负载，不创建key表，也不运行initial load
+        if (!config.trace_replay_file.empty()) {
+            TraceReplayer::Options options;
+            options.speed = config.replay_speed;
+            options.query_threads = config.replay_query_threads;
+            TraceReplayer replayer(db_manager, options);
+            auto result = replayer.replay(config.trace_replay_file);
+            result->print();
+
+            if (!config.result_file.empty()) {
+                nlohmann::ordered_json document;
+                document["schema_version"] = result_document::kSchemaVersion;
+                document["tool"] = "rocksdb_bench_app";
+                document["build"] = result_document::build_info_json();
+                document["hardware"] = result_document::hardware_info_json();
+                document["config"] = config.to_json();
+                document["strategy"] = db_manager->get_strategy_name();
+                document.update(result->to_json());
+                if (result_document::write_file(config.result_file, document)) {
+                    utils::log_info("Replay results written to {}", config.result_file);
+                }
+            }
+            return result->completed ? 0 : 1;
+        }
+
         // Create scenario runner with simplified config
         StrategyScenarioRunner runner(db_manager, metrics_collector, config);
         
+        // 场景文件：按场景定义的阶段运行，代替下面固定的两个阶段
+        if (scenario) {
+            auto results = runner.run_scenario(*scenario);
+            bool completed = results.size() == scenario->phases.size() && results.back().success;
+            utils::log_info("Scenario {}", completed ? "completed successfully!" : "stopped early");
+            return completed ? 0 : 1;
+        }
+        
         utils::log_info("Starting historical version query test...");
         utils::log_info("Test will run for {} minutes with {} keys", 
                        config.continuous_duration_minutes, config.total_keys);
@@ -75,9 +133,17 @@ int main(int argc, char* argv[]) {
         runner.run_initial_load_phase();
         utils::log_info("Initial load phase completed!");
         
-        // 第二步：运行连续更新查询循环
-        utils::log_info("Phase 2: Running continuous update-query loop...");
-        runner.run_continuous_update_query_loop(config.continuous_duration_minutes);
+        // 第二步：运行连续更新查询循环（或开环SLO扫描、标准工作负载预设）
+        if (!workload_presets.empty()) {
+            utils::log_info("Phase 2: Running workload suite...");
+            runner.run_workload_suite(workload_presets);
+        } else if (config.slo_sweep) {
+            utils::log_info("Phase 2: Running open-loop SLO sweep...");
+            runner.run_slo_sweep();
+        } else {
+            utils::log_info("Phase 2: Running continuous update-query loop...");
+            runner.run_continuous_update_query_loop(config.continuous_duration_minutes);
+        }
         
         utils::log_info("Historical version query test completed successfully!");
         
@@ -0,0 +1,89 @@
+#pragma once
+#include "../utils/cpu_time.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 小型提交执行器 - 固定数量的常驻线程，用于把同一个block的多路db->Write并发发出
+// 避免每次写入都创建线程；submit返回future，调用方在返回前join。
+// 提交线程上有ThreadCpuMeter时，任务消耗的CPU计入同一个计数器（例如写线程的CPU包含并发的data写入）
+class CommitExecutor {
+public:
+    explicit CommitExecutor(size_t thread_count) {
+        if (thread_count == 0) thread_count = 1;
+        workers_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            workers_.emplace_back(&CommitExecutor::worker_loop, this);
+        }
+    }
+
+    ~CommitExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    CommitExecutor(const CommitExecutor&) = delete;
+    CommitExecutor& operator=(const CommitExecutor&) = delete;
+
+    template <typename Fn>
+    auto submit(Fn&& fn) -> std::future<std::invoke_result_t<Fn>> {
+        using Result = std::invoke_result_t<Fn>;
+        auto* cpu_sink = utils::ThreadCpuMeter::current_sink();
+        // meter在任务返回后、future就绪前析构，调用方拿到结果时CPU已经计入
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            [fn = std::forward<Fn>(fn), cpu_sink]() mutable -> Result {
+                std::optional<utils::ThreadCpuMeter> cpu_meter;
+                if (cpu_sink) {
+                    cpu_meter.emplace(*cpu_sink);
+                }
+                return fn();
+            });
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace_back([task]() { (*task)(); });
+        }
+        cv_.notify_one();
+        return future;
+    }
+
+    size_t thread_count() const { return workers_.size(); }
+
+private:
+    void worker_loop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;  // stopping_ 且队列已清空
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
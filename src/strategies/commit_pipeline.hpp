@@ -0,0 +1,172 @@
+#pragma once
+#include "../utils/logger.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 提交流水线统计 - 用于判断瓶颈在数据生成侧还是RocksDB写入侧
+struct CommitPipelineStats {
+    uint64_t buffers_committed = 0;
+    uint64_t commit_failures = 0;
+    double producer_blocked_ms = 0.0;   // 生产者因所有buffer都在等待提交而阻塞的时间
+    double committer_busy_ms = 0.0;     // 提交线程执行db->Write的时间
+    double elapsed_ms = 0.0;            // 从第一次submit到最近一次提交完成的时间
+
+    double committer_utilization() const {
+        return elapsed_ms > 0 ? committer_busy_ms / elapsed_ms : 0.0;
+    }
+    double producer_blocked_ratio() const {
+        return elapsed_ms > 0 ? producer_blocked_ms / elapsed_ms : 0.0;
+    }
+};
+
+// N缓冲提交流水线：生产者填充active buffer，专用提交线程按FIFO顺序写入已提交的buffer。
+// 所有buffer都在等待提交时，submit()阻塞生产者（背压）。buffer_count=1时退化为同步写入。
+// 只有一个提交线程，保证batch按提交顺序落盘。
+template <typename Buffer>
+class CommitPipeline {
+public:
+    using CommitFn = std::function<bool(Buffer&)>;
+    using ResetFn = std::function<void(Buffer&)>;
+
+    CommitPipeline(std::string name, size_t buffer_count, CommitFn commit_fn, ResetFn reset_fn)
+        : name_(std::move(name)), commit_fn_(std::move(commit_fn)), reset_fn_(std::move(reset_fn)) {
+        if (buffer_count == 0) buffer_count = 1;
+        buffers_.reserve(buffer_count);
+        for (size_t i = 0; i < buffer_count; ++i) {
+            buffers_.push_back(std::make_unique<Buffer>());
+        }
+        active_ = 0;
+        for (size_t i = 1; i < buffer_count; ++i) {
+            free_.push_back(i);
+        }
+        committer_ = std::thread(&CommitPipeline::committer_loop, this);
+        utils::log_info("CommitPipeline [{}] started with {} buffers", name_, buffer_count);
+    }
+
+    ~CommitPipeline() {
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_cv_.notify_all();
+        if (committer_.joinable()) {
+            committer_.join();
+        }
+    }
+
+    CommitPipeline(const CommitPipeline&) = delete;
+    CommitPipeline& operator=(const CommitPipeline&) = delete;
+
+    // 生产者当前填充的buffer；调用方需自行保证只有一个生产者（例如持有batch_mutex_）
+    Buffer& active() { return *buffers_[active_]; }
+
+    // 将active buffer交给提交线程，并换入一个空闲buffer；没有空闲buffer时阻塞
+    void submit() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!started_) {
+            started_ = true;
+            first_submit_time_ = std::chrono::steady_clock::now();
+        }
+        ready_.push_back(active_);
+        ready_cv_.notify_one();
+
+        if (free_.empty()) {
+            auto wait_start = std::chrono::steady_clock::now();
+            free_cv_.wait(lock, [this] { return !free_.empty(); });
+            stats_.producer_blocked_ms += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - wait_start).count();
+        }
+        active_ = free_.front();
+        free_.pop_front();
+    }
+
+    // 等待所有已提交的buffer写入完成
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        free_cv_.wait(lock, [this] { return ready_.empty() && !committing_; });
+    }
+
+    bool has_failed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_.commit_failures > 0;
+    }
+
+    CommitPipelineStats get_stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void log_stats() const {
+        auto stats = get_stats();
+        utils::log_info("CommitPipeline [{}]: {} buffers committed, {} failures, elapsed {:.1f} ms",
+                        name_, stats.buffers_committed, stats.commit_failures, stats.elapsed_ms);
+        utils::log_info("CommitPipeline [{}]: producer blocked {:.1f} ms ({:.1f}%), committer busy {:.1f} ms (utilization {:.1f}%)",
+                        name_, stats.producer_blocked_ms, stats.producer_blocked_ratio() * 100.0,
+                        stats.committer_busy_ms, stats.committer_utilization() * 100.0);
+        if (stats.buffers_committed > 0) {
+            utils::log_info("CommitPipeline [{}]: bottleneck looks like {}", name_,
+                            stats.producer_blocked_ratio() > 0.1 ? "RocksDB write path (producers waiting on commits)"
+                                                                 : "block generation (committer waiting on producers)");
+        }
+    }
+
+private:
+    void committer_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            ready_cv_.wait(lock, [this] { return stopping_ || !ready_.empty(); });
+            if (ready_.empty()) {
+                break;  // stopping_ 且没有剩余工作
+            }
+            size_t index = ready_.front();
+            ready_.pop_front();
+            committing_ = true;
+            lock.unlock();
+
+            auto commit_start = std::chrono::steady_clock::now();
+            bool ok = commit_fn_(*buffers_[index]);
+            auto commit_end = std::chrono::steady_clock::now();
+            reset_fn_(*buffers_[index]);
+
+            lock.lock();
+            committing_ = false;
+            stats_.committer_busy_ms += std::chrono::duration<double, std::milli>(commit_end - commit_start).count();
+            stats_.elapsed_ms = std::chrono::duration<double, std::milli>(commit_end - first_submit_time_).count();
+            stats_.buffers_committed++;
+            if (!ok) {
+                stats_.commit_failures++;
+                utils::log_error("CommitPipeline [{}]: commit of buffer {} failed", name_, index);
+            }
+            free_.push_back(index);
+            free_cv_.notify_all();
+        }
+    }
+
+    std::string name_;
+    CommitFn commit_fn_;
+    ResetFn reset_fn_;
+
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+    size_t active_ = 0;
+    std::deque<size_t> free_;
+    std::deque<size_t> ready_;
+    bool committing_ = false;
+    bool stopping_ = false;
+    bool started_ = false;
+    std::chrono::steady_clock::time_point first_submit_time_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_cv_;
+    std::condition_variable free_cv_;
+    std::thread committer_;
+
+    CommitPipelineStats stats_;
+};
@@ -1,9 +1,11 @@
 #include "direct_version_strategy.hpp"
 #include "../utils/logger.hpp"
+#include "../core/query_perf_context.hpp"
 #include <rocksdb/write_batch.h>
 #include <rocksdb/iterator.h>
 #include <rocksdb/slice.h>
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <sstream>
 
@@ -21,9 +23,13 @@ bool DirectVersionStrategy::initialize(rocksdb::DB* db) {
     // 保存数据库引用用于flush_all_batches
     db_ref_ = db;
     
+    // 启动initial load提交流水线
+    start_initial_load_pipeline(db);
+    
     utils::log_info("DirectVersionStrategy initialized - using key prefixes instead of column families");
-    utils::log_info("Batch configuration: {} blocks per batch, {} MB max", 
-                    config_.batch_size_blocks, config_.max_batch_size_bytes / (1024 * 1024));
+    utils::log_info("Batch configuration: {} blocks per batch, {} MB max, {} commit buffers", 
+                    config_.batch_size_blocks, config_.max_batch_size_bytes / (1024 * 1024),
+                    config_.commit_buffers);
     utils::log_info("Using storage strategy: {}", get_strategy_name());
     return true;
 }
@@ -65,7 +71,15 @@ bool DirectVersionStrategy::write_initial_load_batch(rocksdb::DB* db, const std:
     utils::log_info("DirectVersion batch config: batch_size_blocks={}, max_batch_size_bytes={} MB", 
                     config_.batch_size_blocks, config_.max_batch_size_bytes / (1024 * 1024));
     
-    std::lock_guard<std::mutex> lock(batch_mutex_);
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
+    
+    // 提交线程写入失败时向上层报告
+    if (initial_load_pipeline_->has_failed()) {
+        utils::log_error("write_initial_load_batch: commit pipeline reported a failed write");
+        return false;
+    }
+    
+    auto encode_start = std::chrono::steady_clock::now();
     
     // 计算这个block的大小
     size_t block_size = calculate_block_size(records);
@@ -76,6 +90,8 @@ bool DirectVersionStrategy::write_initial_load_batch(rocksdb::DB* db, const std:
     // 更新统计
     current_batch_blocks_++;
     total_writes_ += records.size();
+    initial_load_encode_ms_ += std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - encode_start).count();
     
     utils::log_debug("write_initial_load_batch: Added block, batch now has {} blocks, {} bytes", 
                      current_batch_blocks_, current_batch_size_);
@@ -91,7 +107,7 @@ bool DirectVersionStrategy::write_initial_load_batch(rocksdb::DB* db, const std:
 
 bool DirectVersionStrategy::write_batch_with_processor(rocksdb::DB* db, const std::vector<DataRecord>& records, 
                                                        std::function<void(const DataRecord&)> processor) {
-    std::lock_guard<std::mutex> lock(batch_mutex_);
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
     
     // 处理每个记录
     for (const auto& record : records) {
@@ -144,7 +160,11 @@ std::optional<Value> DirectVersionStrategy::query_historical_version(rocksdb::DB
     
     // 第一步：尝试查找≤target_version的最新版本，同时获取实际的block_num
     std::string target_key = build_version_key(addr_slot, target_version);
-    auto result_with_block = find_value_by_version_with_block(db, target_key, addr_slot);
+    std::optional<Value> result_with_block;
+    {
+        query_perf::StageScope stage("version_seek");
+        result_with_block = find_value_by_version_with_block(db, target_key, addr_slot);
+    }
     
     if (result_with_block.has_value()) {
         // 找到了≤target_version的版本，返回"block_num:value"格式
@@ -156,6 +176,36 @@ std::optional<Value> DirectVersionStrategy::query_historical_version(rocksdb::DB
     return std::nullopt;
 }
 
+std::vector<std::pair<BlockNum, Value>> DirectVersionStrategy::scan_version_history(rocksdb::DB* db,
+                                                                                   const std::string& addr_slot,
+                                                                                   BlockNum from_block,
+                                                                                   BlockNum to_block,
+                                                                                   size_t limit) {
+    std::vector<std::pair<BlockNum, Value>> versions;
+    if (from_block > to_block || limit == 0) {
+        return versions;
+    }
+    query_perf::StageScope stage("history_scan");
+
+    // 上界是to_block的下一个版本key，让RocksDB在区间末尾直接停止
+    std::string prefix = "VERSION|" + addr_slot + ":";
+    std::string upper_key = to_block < UINT64_MAX ? build_version_key(addr_slot, to_block + 1) : prefix + "~";
+    rocksdb::Slice upper_bound(upper_key);
+    rocksdb::ReadOptions read_options;
+    read_options.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(read_options));
+
+    for (it->Seek(build_version_key(addr_slot, from_block)); it->Valid() && versions.size() < limit; it->Next()) {
+        rocksdb::Slice key = it->key();
+        if (!key.starts_with(prefix)) {
+            break;
+        }
+        BlockNum block_num = std::stoull(std::string(key.data() + prefix.size(), key.size() - prefix.size()));
+        versions.emplace_back(block_num, it->value().ToString());
+    }
+    return versions;
+}
+
 
 std::string DirectVersionStrategy::build_version_key(const std::string& addr_slot, BlockNum version) const {
     // 构建版本索引key: VERSION|address_slot:version
@@ -269,10 +319,15 @@ void DirectVersionStrategy::add_to_batch(const DataRecord& record) {
 
 bool DirectVersionStrategy::cleanup(rocksdb::DB* db) {
     // 刷写所有待写入的批次
-    std::lock_guard<std::mutex> lock(batch_mutex_);
-    if (batch_dirty_ && current_batch_blocks_ > 0) {
-        flush_pending_batches(db);
+    {
+        std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
+        if (batch_dirty_ && current_batch_blocks_ > 0) {
+            flush_pending_batches(db);
+        }
     }
+    
+    // 等待提交线程写完并停止，必须在DB关闭之前
+    stop_initial_load_pipeline();
 
     utils::log_info("=== DirectVersionStrategy Database Property Statistics ===");
 
@@ -365,23 +420,18 @@ void DirectVersionStrategy::flush_pending_batches(rocksdb::DB* db) {
         return;
     }
     
-    // 保存批次统计信息用于日志
-    uint32_t blocks_to_flush = current_batch_blocks_;
-    size_t size_to_flush = current_batch_size_;
+    // 保存批次统计信息，交给提交线程写入
+    auto& buffer = initial_load_pipeline_->active();
+    buffer.blocks = current_batch_blocks_;
+    buffer.size_bytes = current_batch_size_;
     
-    utils::log_info("Flushing DirectVersion batch: {} blocks, {} bytes", blocks_to_flush, size_to_flush);
-    
-    rocksdb::WriteOptions write_options;
-    write_options.sync = false;
+    utils::log_info("Submitting DirectVersion batch to commit pipeline: {} blocks, {} bytes", 
+                    buffer.blocks, buffer.size_bytes);
     
-    // 写入到数据库
-    auto status = db->Write(write_options, &pending_batch_initial_);
-    if (!status.ok()) {
-        utils::log_error("Failed to flush DirectVersion batch: {}", status.ToString());
-    }
+    // 所有buffer都在等待提交时这里会阻塞（背压）
+    initial_load_pipeline_->submit();
     
     // 重置批次状态
-    pending_batch_initial_.Clear();
     current_batch_size_ = 0;
     current_batch_blocks_ = 0;
     batch_dirty_ = false;
@@ -402,7 +452,7 @@ void DirectVersionStrategy::add_block_to_pending_batch(const std::vector<DataRec
     // 将整个block添加到pending batch
     for (const auto& record : records) {
         std::string version_key = build_version_key(record.addr_slot, record.block_num);
-        pending_batch_initial_.Put(version_key, record.value);
+        initial_load_pipeline_->active().batch.Put(version_key, record.value);
     }
     
     // 更新批次统计
@@ -415,8 +465,12 @@ void DirectVersionStrategy::flush_all_batches() {
         utils::log_error("DirectVersionStrategy::flush_all_batches called but db_ref_ is null!");
         return;
     }
+    if (!initial_load_pipeline_) {
+        utils::log_error("DirectVersionStrategy::flush_all_batches called after cleanup");
+        return;
+    }
     
-    std::lock_guard<std::mutex> lock(batch_mutex_);
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
     
     if (batch_dirty_ && current_batch_blocks_ > 0) {
         // 保存批次统计信息用于日志
@@ -429,15 +483,17 @@ void DirectVersionStrategy::flush_all_batches() {
         rocksdb::WriteOptions write_options;
         write_options.sync = false;
         
-        // 写入初始加载的pending batch
-        if (pending_batch_initial_.Count() > 0) {
-            utils::log_info("Flushing initial load batch with {} operations", pending_batch_initial_.Count());
-            auto status = db_ref_->Write(write_options, &pending_batch_initial_);
-            if (!status.ok()) {
-                utils::log_error("Failed to flush initial load batch: {}", status.ToString());
-            } else {
-                utils::log_info("Initial load batch flushed successfully");
-            }
+        // 提交初始加载的pending batch，并等待提交线程写完
+        if (initial_load_pipeline_->active().batch.Count() > 0) {
+            utils::log_info("Flushing initial load batch with {} operations", 
+                            initial_load_pipeline_->active().batch.Count());
+            flush_pending_batches(db_ref_);
+        }
+        initial_load_pipeline_->drain();
+        if (initial_load_pipeline_->has_failed()) {
+            utils::log_error("Failed to flush initial load batch");
+        } else {
+            utils::log_info("Initial load batch flushed successfully");
         }
         
         // 写入常规pending batch
@@ -453,15 +509,64 @@ void DirectVersionStrategy::flush_all_batches() {
         
         // 重置批次状态
         pending_batch_.Clear();
-        pending_batch_initial_.Clear();
         current_batch_size_ = 0;
         current_batch_blocks_ = 0;
         batch_dirty_ = false;
         
         utils::log_info("All DirectVersion batches flushed successfully");
     } else {
+        initial_load_pipeline_->drain();
         utils::log_info("No pending DirectVersion batches to flush");
     }
+    
+    initial_load_pipeline_->log_stats();
+}
+
+std::optional<InitialLoadStats> DirectVersionStrategy::get_initial_load_stats() const {
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
+    if (!initial_load_pipeline_) {
+        return std::nullopt;
+    }
+    
+    auto pipeline_stats = initial_load_pipeline_->get_stats();
+    InitialLoadStats stats;
+    stats.encode_ms = initial_load_encode_ms_;
+    stats.backpressure_ms = pipeline_stats.producer_blocked_ms;
+    stats.commit_ms = pipeline_stats.committer_busy_ms;
+    stats.batches_committed = pipeline_stats.buffers_committed;
+    return stats;
+}
+
+void DirectVersionStrategy::start_initial_load_pipeline(rocksdb::DB* db) {
+    initial_load_pipeline_ = std::make_unique<CommitPipeline<InitialLoadBuffer>>(
+        "direct_version initial load", config_.commit_buffers,
+        [db](InitialLoadBuffer& buffer) {
+            utils::log_info("Flushing DirectVersion batch: {} blocks, {} bytes", buffer.blocks, buffer.size_bytes);
+            
+            rocksdb::WriteOptions write_options;
+            write_options.sync = false;
+            
+            auto status = db->Write(write_options, &buffer.batch);
+            if (!status.ok()) {
+                utils::log_error("Failed to flush DirectVersion batch: {}", status.ToString());
+                return false;
+            }
+            return true;
+        },
+        [](InitialLoadBuffer& buffer) {
+            buffer.batch.Clear();
+            buffer.size_bytes = 0;
+            buffer.blocks = 0;
+        });
+}
+
+void DirectVersionStrategy::stop_initial_load_pipeline() {
+    if (!initial_load_pipeline_) {
+        return;
+    }
+    initial_load_pipeline_->drain();
+    initial_load_pipeline_->log_stats();
+    initial_load_pipeline_.reset();
 }
 
 // ===== 新增的历史版本查询辅助方法 =====
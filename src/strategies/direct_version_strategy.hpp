@@ -1,6 +1,8 @@
 #pragma once
 #include "../core/storage_strategy.hpp"
 #include "../utils/logger.hpp"
+#include "../utils/instrumented_mutex.hpp"
+#include "commit_pipeline.hpp"
 #include <rocksdb/db.h>
 #include <rocksdb/options.h>
 #include <rocksdb/table_properties.h>
@@ -19,6 +21,7 @@ public:
     struct Config {
         uint32_t batch_size_blocks = 5;  // 每个WriteBatch写入的块数（默认5个块）
         size_t max_batch_size_bytes = 4UL * 1024 * 1024 * 1024; // 最大批次大小4GB
+        size_t commit_buffers = 2;       // initial load提交流水线的buffer数（1=同步写入）
     };
     
     DirectVersionStrategy();  // 默认构造函数
@@ -37,12 +40,21 @@ public:
                                                const std::string& addr_slot, 
                                                BlockNum target_version) override;
     
+    // 版本key的block号定长，[from, to]内的版本在key空间中连续，一次迭代即可
+    std::vector<std::pair<BlockNum, Value>> scan_version_history(rocksdb::DB* db,
+                                                                 const std::string& addr_slot,
+                                                                 BlockNum from_block,
+                                                                 BlockNum to_block,
+                                                                 size_t limit) override;
+    
     std::string get_strategy_name() const override { return "direct_version"; }
     std::string get_description() const override { 
         return "Direct version storage: VERSION|addr_slot:block -> value"; 
     }
     
     bool cleanup(rocksdb::DB* db) override;
+    
+    std::optional<InitialLoadStats> get_initial_load_stats() const override;
 
 private:
     Config config_;
@@ -51,7 +63,7 @@ private:
     rocksdb::DB* db_ref_ = nullptr;
     
     // 批量写入缓存
-    mutable std::mutex batch_mutex_;
+    mutable InstrumentedMutex batch_mutex_{"direct.batch_mutex"};
     mutable rocksdb::WriteBatch pending_batch_;
     mutable size_t current_batch_size_ = 0;
     mutable uint32_t current_batch_blocks_ = 0;
@@ -60,8 +72,14 @@ private:
     // 统计信息
     std::atomic<uint64_t> total_writes_{0};
     
-    // 初始加载批量写入缓存
-    mutable rocksdb::WriteBatch pending_batch_initial_;
+    // 初始加载批量写入缓存 - 由提交流水线管理，生产者填充active buffer，提交线程写入其余buffer
+    struct InitialLoadBuffer {
+        rocksdb::WriteBatch batch;
+        size_t size_bytes = 0;
+        uint32_t blocks = 0;
+    };
+    std::unique_ptr<CommitPipeline<InitialLoadBuffer>> initial_load_pipeline_;
+    double initial_load_encode_ms_ = 0.0;  // 受batch_mutex_保护
     
     std::string build_version_key(const std::string& addr_slot, BlockNum version) const;
     
@@ -87,6 +105,9 @@ private:
     size_t calculate_block_size(const std::vector<DataRecord>& records) const;
     void add_block_to_pending_batch(const std::vector<DataRecord>& records, size_t block_size);
     
+    void start_initial_load_pipeline(rocksdb::DB* db);
+    void stop_initial_load_pipeline();
+    
     // 实现接口方法
     void flush_all_batches() override;
 };
\ No newline at end of file
@@ -1,13 +1,18 @@
 #include "dual_rocksdb_strategy.hpp"
 #include "../core/types.hpp"
+#include "../core/db_event_log.hpp"
+#include "../core/query_perf_context.hpp"
 #include <rocksdb/options.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/statistics.h>
 #include <algorithm>
 #include <chrono>
+#include <functional>
 
 using namespace utils;
 
+thread_local WriteStageTiming DualRocksDBStrategy::last_write_timing_;
+
 // ===== DualRocksDBStrategy 实现 =====
 
 DualRocksDBStrategy::DualRocksDBStrategy(const Config& config)
@@ -16,10 +21,17 @@ DualRocksDBStrategy::DualRocksDBStrategy(const Config& config)
     // 先不测试cache的情况了.
     utils::log_info("Dynamic cache optimization disabled - using direct database queries");
     range_cache_ = nullptr;
+
+    if (config_.parallel_commit) {
+        commit_executor_ = std::make_unique<CommitExecutor>(config_.commit_threads);
+        utils::log_info("Parallel range/data commit enabled with {} executor threads", 
+                        commit_executor_->thread_count());
+    }
 }
 
 DualRocksDBStrategy::~DualRocksDBStrategy() {
-    // 清理资源
+    // 清理资源 - 提交线程必须在DB关闭之前停止
+    stop_initial_load_pipeline();
     if (range_index_db_) range_index_db_->Close();
     if (data_storage_db_) data_storage_db_->Close();
 }
@@ -47,6 +59,9 @@ bool DualRocksDBStrategy::initialize(rocksdb::DB* main_db) {
         return false;
     }
     
+    // 启动initial load提交流水线
+    start_initial_load_pipeline();
+    
     // 只有启用缓存时才设置查询函数
     if (range_cache_) {
         range_cache_->set_query_function([this](const std::string& addr_slot) -> std::vector<uint32_t> {
@@ -73,6 +88,15 @@ bool DualRocksDBStrategy::write_batch(rocksdb::DB* db, const std::vector<DataRec
     RangeIndexUpdates range_updates = collect_range_updates_for_hotspot(records);
     add_data_to_batch(records, data_batch);
     
+    // 多个写线程可能同时为同一个key追加不同的range，读-改-写必须串行，否则会丢失range。
+    // 加锁后重新读取需要更新的key，合并其他线程在此期间追加的range，并持锁直到range index写入完成
+    std::unique_lock<InstrumentedMutex> range_lock(range_index_update_mutex_, std::defer_lock);
+    if (!range_updates.ranges_to_update.empty()) {
+        range_lock.lock();
+        range_index_lock_acquisitions_++;
+        refresh_range_updates(range_updates);
+    }
+    
     // 第二步：构建range index更新
     build_range_index_batch(range_updates, range_batch);
     
@@ -90,7 +114,15 @@ bool DualRocksDBStrategy::write_initial_load_batch(rocksdb::DB* db, const std::v
     // Initial load模式：积累多个blocks，达到batch限制后统一写入
     utils::log_debug("write_initial_load_batch: Processing {} records as 1 block", records.size());
     
-    std::lock_guard<std::mutex> lock(batch_mutex_);
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
+    
+    // 提交线程写入失败时向上层报告
+    if (initial_load_pipeline_->has_failed()) {
+        utils::log_error("write_initial_load_batch: commit pipeline reported a failed write");
+        return false;
+    }
+    
+    auto encode_start = std::chrono::steady_clock::now();
     
     // 计算这个block的大小
     size_t block_size = calculate_block_size(records);
@@ -101,6 +133,8 @@ bool DualRocksDBStrategy::write_initial_load_batch(rocksdb::DB* db, const std::v
     // 更新统计
     current_batch_blocks_++;
     total_writes_ += records.size();
+    initial_load_encode_ms_ += std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - encode_start).count();
     
     utils::log_debug("write_initial_load_batch: Added block, batch now has {} blocks, {} bytes", 
                      current_batch_blocks_, current_batch_size_);
@@ -127,13 +161,40 @@ std::optional<Value> DualRocksDBStrategy::query_latest_value(rocksdb::DB* db, co
         ranges = get_address_ranges(range_index_db_.get(), addr_slot);
     }
     
-    if (ranges.empty()) {
-        return std::nullopt;
+    return find_latest_in_ranges(std::move(ranges), addr_slot);
+}
+
+std::optional<Value> DualRocksDBStrategy::find_latest_in_ranges(std::vector<uint32_t> ranges,
+                                                                const std::string& addr_slot) const {
+    std::sort(ranges.begin(), ranges.end(), std::greater<uint32_t>());
+    for (uint32_t range_num : ranges) {
+        auto value = find_latest_block_in_range(data_storage_db_.get(), range_num, addr_slot);
+        if (value.has_value()) {
+            return value;
+        }
     }
-    
-    // 找到最新范围并搜索最新块
-    uint32_t latest_range = *std::max_element(ranges.begin(), ranges.end());
-    return find_latest_block_in_range(data_storage_db_.get(), latest_range, addr_slot);
+    return std::nullopt;
+}
+
+std::vector<std::optional<Value>> DualRocksDBStrategy::query_latest_values(rocksdb::DB* db,
+                                                                          const std::vector<std::string>& addr_slots) {
+    if (range_cache_) {
+        return IStorageStrategy::query_latest_values(db, addr_slots);
+    }
+    total_reads_ += addr_slots.size();
+
+    std::vector<rocksdb::Slice> keys(addr_slots.begin(), addr_slots.end());
+    std::vector<std::string> range_lists;
+    std::vector<rocksdb::Status> statuses = range_index_db_->MultiGet(rocksdb::ReadOptions(), keys, &range_lists);
+
+    std::vector<std::optional<Value>> values(addr_slots.size());
+    for (size_t i = 0; i < addr_slots.size(); ++i) {
+        if (!statuses[i].ok()) {
+            continue;
+        }
+        values[i] = find_latest_in_ranges(deserialize_range_list(range_lists[i]), addr_slots[i]);
+    }
+    return values;
 }
 
 std::optional<Value> DualRocksDBStrategy::query_historical_version(rocksdb::DB* db, 
@@ -149,6 +210,7 @@ std::optional<Value> DualRocksDBStrategy::query_historical_version(rocksdb::DB*
         ranges = range_cache_->get_address_ranges(addr_slot);
     } else {
         // 直接查询数据库
+        query_perf::StageScope stage("range_index_get");
         ranges = get_address_ranges(range_index_db_.get(), addr_slot);
     }
     
@@ -165,7 +227,11 @@ std::optional<Value> DualRocksDBStrategy::query_historical_version(rocksdb::DB*
     for (uint32_t range_num : ranges) {
         if (range_num > target_range) continue; // 跳过>target_range的范围
         
-        auto result = find_latest_block_in_range_with_block(data_storage_db_.get(), range_num, addr_slot, target_version);
+        std::optional<std::pair<BlockNum, Value>> result;
+        {
+            query_perf::StageScope stage("data_seek");
+            result = find_latest_block_in_range_with_block(data_storage_db_.get(), range_num, addr_slot, target_version);
+        }
         if (result.has_value()) {
             if (!best_result.has_value() || result->first > best_result->first) {
                 best_result = result.value();
@@ -183,16 +249,68 @@ std::optional<Value> DualRocksDBStrategy::query_historical_version(rocksdb::DB*
     return std::nullopt;
 }
 
+std::vector<std::pair<BlockNum, Value>> DualRocksDBStrategy::scan_version_history(rocksdb::DB* db,
+                                                                                 const std::string& addr_slot,
+                                                                                 BlockNum from_block,
+                                                                                 BlockNum to_block,
+                                                                                 size_t limit) {
+    std::vector<std::pair<BlockNum, Value>> versions;
+    if (from_block > to_block || limit == 0) {
+        return versions;
+    }
+    total_reads_++;
+
+    std::vector<uint32_t> ranges;
+    if (range_cache_) {
+        ranges = range_cache_->get_address_ranges(addr_slot);
+    } else {
+        query_perf::StageScope stage("range_index_get");
+        ranges = get_address_ranges(range_index_db_.get(), addr_slot);
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    query_perf::StageScope stage("history_scan");
+    uint32_t first_range = calculate_range(from_block);
+    uint32_t last_range = calculate_range(to_block);
+    for (uint32_t range_num : ranges) {
+        if (range_num < first_range || range_num > last_range) {
+            continue;
+        }
+        std::string prefix = "R" + std::to_string(range_num) + "|" + addr_slot + "|";
+        BlockNum range_start = static_cast<BlockNum>(range_num) * config_.range_size;
+        std::unique_ptr<rocksdb::Iterator> it(data_storage_db_->NewIterator(rocksdb::ReadOptions()));
+        for (it->Seek(prefix + format_block_number(std::max(from_block, range_start)));
+             it->Valid() && versions.size() < limit; it->Next()) {
+            rocksdb::Slice key = it->key();
+            if (!key.starts_with(prefix)) {
+                break;
+            }
+            BlockNum block_num = extract_block_from_key(key.ToString());
+            if (block_num > to_block) {
+                break;
+            }
+            versions.emplace_back(block_num, it->value().ToString());
+        }
+        if (versions.size() >= limit) {
+            break;
+        }
+    }
+    return versions;
+}
 
 bool DualRocksDBStrategy::cleanup(rocksdb::DB* db) {
     // 刷写所有待写入的批次
     flush_all_batches();
+    stop_initial_load_pipeline();
 
     // 清理新的缓存系统
     if (range_cache_) {
         range_cache_->clear_cache();
     }
 
+    utils::log_info("DualRocksDBStrategy: range index update lock acquired for {} hotspot blocks",
+                    range_index_lock_acquisitions_.load());
+
     // 打印详细的RocksDB Map Properties - Range Index DB
     if (range_index_db_) {
         auto range_options = range_index_db_->GetOptions();
@@ -499,6 +617,14 @@ std::string DualRocksDBStrategy::serialize_range_list(const std::vector<uint32_t
 }
 
 
+std::vector<std::pair<std::string, uint64_t>> DualRocksDBStrategy::get_memory_usage() const {
+    std::vector<std::pair<std::string, uint64_t>> usage;
+    if (range_cache_) {
+        usage.emplace_back("range_cache", range_cache_->get_query_stats().cache_memory_bytes);
+    }
+    return usage;
+}
+
 rocksdb::Options DualRocksDBStrategy::get_rocksdb_options(bool is_range_index) const {
     rocksdb::Options options;
     options.create_if_missing = true;
@@ -516,6 +642,11 @@ rocksdb::Options DualRocksDBStrategy::get_rocksdb_options(bool is_range_index) c
     auto statistics = rocksdb::CreateDBStatistics();
     options.statistics = statistics;
     
+    if (event_log_) {
+        options.listeners.push_back(std::make_shared<DBEventListener>(
+            is_range_index ? "range_index" : "data_storage", event_log_));
+    }
+    
     // === 内存优化配置（针对400G内存） ===
     // MemTable配置 - 利用大内存
     options.write_buffer_size = 2ULL * 1024 * 1024 * 1024;      // 2GB per memtable
@@ -553,11 +684,44 @@ rocksdb::Options DualRocksDBStrategy::get_rocksdb_options(bool is_range_index) c
 
 bool DualRocksDBStrategy::execute_batch_write(rocksdb::WriteBatch& range_batch, rocksdb::WriteBatch& data_batch, const char* operation_name) {
     // 写入两个数据库
+    // 可见性：range index只会为key追加新的range，data batch整体原子可见。并发提交时读线程可能看到
+    // 新range已经在range index中、而该range的data行还不可见：
+    //  - 历史版本查询遍历所有<=target的range取最新，新range中没有结果时自然用旧range的版本；
+    //  - 最新值查询（find_latest_in_ranges）从最新range往旧range依次查，新range未命中时回退到旧range，
+    //    得到写入前的最新值，不会误报不存在。
+    // 反过来data先可见、range index后可见时，读线程只看到旧range，同样得到写入前的结果。
+    // 因此两路写入可以并发；串行模式下先写data再写range index，data先于index可见。
     rocksdb::WriteOptions write_options;
     write_options.sync = false;
     
-    auto range_status = range_index_db_->Write(write_options, &range_batch);
-    auto data_status = data_storage_db_->Write(write_options, &data_batch);
+    WriteStageTiming timing;
+    rocksdb::Status range_status;
+    rocksdb::Status data_status;
+    auto start = std::chrono::steady_clock::now();
+    
+    auto timed_write = [&write_options](rocksdb::DB* db, rocksdb::WriteBatch* batch, double& elapsed_ms) {
+        auto write_start = std::chrono::steady_clock::now();
+        auto status = db->Write(write_options, batch);
+        elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - write_start).count();
+        return status;
+    };
+    
+    if (commit_executor_) {
+        // data写入交给执行器，range index写入在当前线程，返回前join
+        auto data_future = commit_executor_->submit([&]() {
+            return timed_write(data_storage_db_.get(), &data_batch, timing.data_ms);
+        });
+        range_status = timed_write(range_index_db_.get(), &range_batch, timing.range_ms);
+        data_status = data_future.get();
+    } else {
+        data_status = timed_write(data_storage_db_.get(), &data_batch, timing.data_ms);
+        range_status = timed_write(range_index_db_.get(), &range_batch, timing.range_ms);
+    }
+    
+    timing.total_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    last_write_timing_ = timing;
     
     if (!range_status.ok() || !data_status.ok()) {
         log_error("Failed to {} to DualRocksDB: range={} data={}", 
@@ -582,10 +746,20 @@ void DualRocksDBStrategy::process_record_for_batch(const DataRecord& record, roc
 
 
 void DualRocksDBStrategy::flush_all_batches() {
-    std::lock_guard<std::mutex> lock(batch_mutex_);
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
+    if (!initial_load_pipeline_) {
+        return;
+    }
     if (batch_dirty_) {
         flush_pending_batches();
     }
+    
+    // 等待提交线程写完所有已提交的batch
+    initial_load_pipeline_->drain();
+    if (initial_load_pipeline_->has_failed()) {
+        log_error("Failed to flush pending batches");
+    }
+    initial_load_pipeline_->log_stats();
 }
 
 
@@ -614,16 +788,18 @@ void DualRocksDBStrategy::flush_pending_batches() {
         return;
     }
     
-    utils::log_info("Flushing batch: {} blocks, {} MB", current_batch_blocks_, 
-                   current_batch_size_ / (1024 * 1024));
+    // 保存批次统计信息，交给提交线程写入
+    auto& buffer = initial_load_pipeline_->active();
+    buffer.blocks = current_batch_blocks_;
+    buffer.size_bytes = current_batch_size_;
     
-    if (!execute_batch_write(pending_range_batch_, pending_data_batch_, "pending_batch")) {
-        log_error("Failed to flush pending batches");
-    }
+    utils::log_info("Submitting batch to commit pipeline: {} blocks, {} MB", buffer.blocks, 
+                   buffer.size_bytes / (1024 * 1024));
+    
+    // 所有buffer都在等待提交时这里会阻塞（背压）
+    initial_load_pipeline_->submit();
     
     // 重置批次状态
-    pending_range_batch_.Clear();
-    pending_data_batch_.Clear();
     current_batch_size_ = 0;
     current_batch_blocks_ = 0;
     batch_dirty_ = false;
@@ -632,6 +808,57 @@ void DualRocksDBStrategy::flush_pending_batches() {
     batch_range_cache_.clear();
 }
 
+std::optional<InitialLoadStats> DualRocksDBStrategy::get_initial_load_stats() const {
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
+    if (!initial_load_pipeline_) {
+        return std::nullopt;
+    }
+    
+    auto pipeline_stats = initial_load_pipeline_->get_stats();
+    InitialLoadStats stats;
+    stats.encode_ms = initial_load_encode_ms_;
+    stats.backpressure_ms = pipeline_stats.producer_blocked_ms;
+    stats.commit_ms = pipeline_stats.committer_busy_ms;
+    stats.batches_committed = pipeline_stats.buffers_committed;
+    return stats;
+}
+
+std::vector<std::pair<std::string, rocksdb::DB*>> DualRocksDBStrategy::get_strategy_dbs() const {
+    std::vector<std::pair<std::string, rocksdb::DB*>> dbs;
+    if (range_index_db_) {
+        dbs.emplace_back("range_index", range_index_db_.get());
+    }
+    if (data_storage_db_) {
+        dbs.emplace_back("data_storage", data_storage_db_.get());
+    }
+    return dbs;
+}
+
+void DualRocksDBStrategy::start_initial_load_pipeline() {
+    initial_load_pipeline_ = std::make_unique<CommitPipeline<InitialLoadBuffer>>(
+        "dual_rocksdb initial load", config_.commit_buffers,
+        [this](InitialLoadBuffer& buffer) {
+            utils::log_info("Flushing batch: {} blocks, {} MB", buffer.blocks, 
+                           buffer.size_bytes / (1024 * 1024));
+            return execute_batch_write(buffer.range_batch, buffer.data_batch, "pending_batch");
+        },
+        [](InitialLoadBuffer& buffer) {
+            buffer.range_batch.Clear();
+            buffer.data_batch.Clear();
+            buffer.size_bytes = 0;
+            buffer.blocks = 0;
+        });
+}
+
+void DualRocksDBStrategy::stop_initial_load_pipeline() {
+    std::lock_guard<InstrumentedMutex> lock(batch_mutex_);
+    if (!initial_load_pipeline_) {
+        return;
+    }
+    initial_load_pipeline_->drain();
+    initial_load_pipeline_.reset();
+}
+
 // ===== 重构后的写入辅助方法实现 =====
 
 DualRocksDBStrategy::RangeIndexUpdates 
@@ -666,6 +893,19 @@ DualRocksDBStrategy::collect_range_updates_for_hotspot(const std::vector<DataRec
     return updates;
 }
 
+void DualRocksDBStrategy::refresh_range_updates(RangeIndexUpdates& updates) {
+    // range只会追加，因此以数据库中的最新列表为基础，补上本次需要的range即可
+    for (auto& [addr_slot, ranges] : updates.ranges_to_update) {
+        std::vector<uint32_t> merged = get_address_ranges(range_index_db_.get(), addr_slot);
+        for (uint32_t range_num : ranges) {
+            if (std::find(merged.begin(), merged.end(), range_num) == merged.end()) {
+                merged.push_back(range_num);
+            }
+        }
+        ranges = std::move(merged);
+    }
+}
+
 void DualRocksDBStrategy::add_data_to_batch(const std::vector<DataRecord>& records, 
                                            rocksdb::WriteBatch& data_batch) {
     // 将所有数据添加到data_batch
@@ -699,8 +939,9 @@ size_t DualRocksDBStrategy::calculate_block_size(const std::vector<DataRecord>&
 void DualRocksDBStrategy::add_block_to_pending_batch(const std::vector<DataRecord>& records, 
                                                     size_t block_size) {
     // 将整个block添加到pending batches
+    auto& buffer = initial_load_pipeline_->active();
     for (const auto& record : records) {
-        process_record_for_batch(record, pending_range_batch_, pending_data_batch_, true);
+        process_record_for_batch(record, buffer.range_batch, buffer.data_batch, true);
     }
     
     // 更新批次统计
@@ -1,7 +1,10 @@
 #pragma once
 #include "../core/storage_strategy.hpp"
 #include "../utils/logger.hpp"
+#include "../utils/instrumented_mutex.hpp"
 #include "dual_rocksdb_cache_interface.hpp"
+#include "commit_pipeline.hpp"
+#include "commit_executor.hpp"
 #include <rocksdb/db.h>
 #include <rocksdb/statistics.h>
 #include <memory>
@@ -45,6 +48,11 @@ private:
         // 批量写入配置
         uint32_t batch_size_blocks = 5;  // 每个WriteBatch写入的块数（默认5个块）
         size_t max_batch_size_bytes = 128 * 1024 * 1024; // 最大批次大小128MB
+        size_t commit_buffers = 2;       // initial load提交流水线的buffer数（1=同步写入）
+        
+        // 并发提交配置：range index和data两路写入并发执行
+        bool parallel_commit = true;
+        size_t commit_threads = 2;       // 提交执行器线程数
     };
     
 private:
@@ -58,14 +66,34 @@ private:
     // 复用DBManager的SST合并效率统计
     // 通过主数据库的statistics_获取compaction指标
     
-    // 批量写入缓存
-    mutable std::mutex batch_mutex_;
-    mutable rocksdb::WriteBatch pending_range_batch_;
-    mutable rocksdb::WriteBatch pending_data_batch_;
+    // 批量写入缓存 - 由提交流水线管理，生产者填充active buffer，提交线程写入其余buffer
+    struct InitialLoadBuffer {
+        rocksdb::WriteBatch range_batch;
+        rocksdb::WriteBatch data_batch;
+        size_t size_bytes = 0;
+        uint32_t blocks = 0;
+    };
+    mutable InstrumentedMutex batch_mutex_{"dual.batch_mutex"};
+    std::unique_ptr<CommitPipeline<InitialLoadBuffer>> initial_load_pipeline_;
+    double initial_load_encode_ms_ = 0.0;  // 受batch_mutex_保护
     mutable size_t current_batch_size_ = 0;
     mutable uint32_t current_batch_blocks_ = 0;
     mutable bool batch_dirty_ = false;
     
+    // 并发提交执行器 - data写入在执行器上，range index写入在调用线程上
+    std::unique_ptr<CommitExecutor> commit_executor_;
+    
+    // range index的读-改-写在多个写线程间串行化。只有key首次进入新range时才需要更新，
+    // 稳态下大部分block不需要加锁
+    InstrumentedMutex range_index_update_mutex_{"dual.range_index_update_mutex"};
+    std::atomic<uint64_t> range_index_lock_acquisitions_{0};
+    
+    // flush/compaction/写停顿事件时间线，由StrategyDBManager在initialize前设置
+    std::shared_ptr<DBEventLog> event_log_;
+    
+    // 当前线程最近一次execute_batch_write的阶段耗时
+    thread_local static WriteStageTiming last_write_timing_;
+    
     // 批量写入期间的range索引缓存，避免重复查询
     mutable std::unordered_map<std::string, std::vector<uint32_t>> batch_range_cache_;
     
@@ -77,12 +105,22 @@ public:
     bool initialize(rocksdb::DB* main_db) override;
     bool write_batch(rocksdb::DB* db, const std::vector<DataRecord>& records) override;
     std::optional<Value> query_latest_value(rocksdb::DB* db, const std::string& addr_slot) override;
+    // 未启用range缓存时，range index的点查用一次MultiGet完成
+    std::vector<std::optional<Value>> query_latest_values(rocksdb::DB* db,
+                                                          const std::vector<std::string>& addr_slots) override;
     
   // 历史版本查询 - 实现复杂语义：≤target_version找最新，找不到则找≥的最小值
   std::optional<Value> query_historical_version(rocksdb::DB* db, 
                                                const std::string& addr_slot, 
                                                BlockNum target_version) override;
     
+    // 按range升序逐个扫描data DB中与[from, to]相交的range
+    std::vector<std::pair<BlockNum, Value>> scan_version_history(rocksdb::DB* db,
+                                                                 const std::string& addr_slot,
+                                                                 BlockNum from_block,
+                                                                 BlockNum to_block,
+                                                                 size_t limit) override;
+    
     // Initial Load专用接口 - 优化首次导入性能
     bool write_initial_load_batch(rocksdb::DB* db, const std::vector<DataRecord>& records) override;
     
@@ -93,6 +131,12 @@ public:
     
     bool cleanup(rocksdb::DB* db) override;
     
+    std::optional<WriteStageTiming> get_last_write_timing() const override { return last_write_timing_; }
+    std::optional<InitialLoadStats> get_initial_load_stats() const override;
+    std::vector<std::pair<std::string, rocksdb::DB*>> get_strategy_dbs() const override;
+    void set_event_log(std::shared_ptr<DBEventLog> event_log) override { event_log_ = std::move(event_log); }
+    std::vector<std::pair<std::string, uint64_t>> get_memory_usage() const override;
+    
     // 配置接口
     void set_config(const Config& config);
     const Config& get_config() const { return config_; }
@@ -128,6 +172,9 @@ private:
                                                      const std::string& addr_slot, 
                                                      BlockNum max_block = UINT64_MAX) const;
     
+    // 按range从新到旧查找最新值：并发提交时最新的range可能先于其data行可见，此时回退到上一个range
+    std::optional<Value> find_latest_in_ranges(std::vector<uint32_t> ranges, const std::string& addr_slot) const;
+    
     // 新增：查找<=target_version的最新block（返回block_num和value）
     std::optional<std::pair<BlockNum, Value>> find_latest_block_in_range_with_block(rocksdb::DB* db, 
                                                                                     uint32_t range_num, 
@@ -164,6 +211,8 @@ private:
     
     // 批量写入管理
     void flush_pending_batches();
+    void start_initial_load_pipeline();
+    void stop_initial_load_pipeline();
     bool should_flush_batch(size_t record_size) const;
     
     // 批量写入通用方法
@@ -176,6 +225,8 @@ private:
     };
     
     RangeIndexUpdates collect_range_updates_for_hotspot(const std::vector<DataRecord>& records);
+    // 持有range_index_update_mutex_时调用：重新读取待更新key的range列表并合并
+    void refresh_range_updates(RangeIndexUpdates& updates);
     void add_data_to_batch(const std::vector<DataRecord>& records, rocksdb::WriteBatch& data_batch);
     void build_range_index_batch(const RangeIndexUpdates& updates, rocksdb::WriteBatch& range_batch);
     size_t calculate_block_size(const std::vector<DataRecord>& records) const;
@@ -8,7 +8,7 @@ std::vector<uint32_t> SimpleLRUSegment::get_or_load(
 ) {
     // 首先尝试从缓存获取
     {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
+        std::shared_lock<InstrumentedSharedMutex> lock(mutex_);
         auto it = cache_.find(key);
         if (it != cache_.end()) {
             // 缓存命中，更新统计
@@ -16,7 +16,7 @@ std::vector<uint32_t> SimpleLRUSegment::get_or_load(
 
             // 更新LRU位置
             lock.unlock();
-            std::unique_lock<std::shared_mutex> write_lock(mutex_);
+            std::unique_lock<InstrumentedSharedMutex> write_lock(mutex_);
 
             auto res_find = cache_.find(key);
             if (res_find != cache_.end()) {
@@ -31,7 +31,7 @@ std::vector<uint32_t> SimpleLRUSegment::get_or_load(
 
     // 缓存未命中，检查SingleFlight
     {
-        std::unique_lock<std::shared_mutex> lock(mutex_);
+        std::unique_lock<InstrumentedSharedMutex> lock(mutex_);
 
         // 定期清理超时的flight调用
         cleanup_stale_flights();
@@ -76,7 +76,7 @@ std::vector<uint32_t> SimpleLRUSegment::get_or_load(
 
                 // 清理flight调用
                 {
-                    std::unique_lock<std::shared_mutex> cleanup_lock(mutex_);
+                    std::unique_lock<InstrumentedSharedMutex> cleanup_lock(mutex_);
                     active_flights_.erase(key);
                 }
 
@@ -87,7 +87,7 @@ std::vector<uint32_t> SimpleLRUSegment::get_or_load(
                 call_state->promise.set_exception(std::current_exception());
 
                 {
-                    std::unique_lock<std::shared_mutex> cleanup_lock(mutex_);
+                    std::unique_lock<InstrumentedSharedMutex> cleanup_lock(mutex_);
                     active_flights_.erase(key);
                 }
 
@@ -103,7 +103,7 @@ std::vector<uint32_t> SimpleLRUSegment::get_or_load(
 }
 
 void SimpleLRUSegment::put(const std::string& key, std::vector<uint32_t> ranges) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::unique_lock<InstrumentedSharedMutex> lock(mutex_);
 
     auto it = cache_.find(key);
     if (it != cache_.end()) {
@@ -138,12 +138,12 @@ void SimpleLRUSegment::update_lru(const std::string& key, LRUCacheEntry* entry)
 }
 
 size_t SimpleLRUSegment::size() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<InstrumentedSharedMutex> lock(mutex_);
     return cache_.size();
 }
 
 size_t SimpleLRUSegment::memory_usage() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<InstrumentedSharedMutex> lock(mutex_);
     size_t total = 0;
 
     for (const auto& [key, entry] : cache_) {
@@ -157,7 +157,7 @@ size_t SimpleLRUSegment::memory_usage() const {
 }
 
 size_t SimpleLRUSegment::active_flight_count() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<InstrumentedSharedMutex> lock(mutex_);
     return active_flights_.size();
 }
 
@@ -184,12 +184,12 @@ void SimpleLRUSegment::cleanup_stale_flights() {
 
 
 SimpleLRUSegment::SegmentStats SimpleLRUSegment::get_stats() const {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::shared_lock<InstrumentedSharedMutex> lock(mutex_);
     return {cache_hits_, cache_misses_};
 }
 
 void SimpleLRUSegment::clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::unique_lock<InstrumentedSharedMutex> lock(mutex_);
     cache_.clear();
     lru_list_.clear();
     active_flights_.clear();
@@ -1,4 +1,5 @@
 #pragma once
+#include "../utils/instrumented_mutex.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -90,7 +91,7 @@ public:
     void clear();
 
 private:
-    mutable std::shared_mutex mutex_;
+    mutable InstrumentedSharedMutex mutex_{"lru_segment.mutex"};
     std::unordered_map<std::string, std::unique_ptr<LRUCacheEntry>> cache_;
     std::list<std::string> lru_list_;  // 最近使用的在前面
     size_t max_size_;
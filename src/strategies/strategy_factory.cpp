@@ -32,9 +32,11 @@ std::unique_ptr<IStorageStrategy> StorageStrategyFactory::create_direct_version_
     // 从BenchmarkConfig中读取batch配置
     strategy_config.batch_size_blocks = config.batch_size_blocks;
     strategy_config.max_batch_size_bytes = config.max_batch_size_bytes;
+    strategy_config.commit_buffers = config.commit_buffers;
     
-    utils::log_info("Creating DirectVersionStrategy with config: batch_size_blocks={}, max_batch_size_bytes={}", 
-                    strategy_config.batch_size_blocks, strategy_config.max_batch_size_bytes);
+    utils::log_info("Creating DirectVersionStrategy with config: batch_size_blocks={}, max_batch_size_bytes={}, commit_buffers={}", 
+                    strategy_config.batch_size_blocks, strategy_config.max_batch_size_bytes,
+                    strategy_config.commit_buffers);
     
     return std::make_unique<DirectVersionStrategy>(strategy_config);
 }
@@ -54,6 +56,10 @@ std::unique_ptr<IStorageStrategy> StorageStrategyFactory::create_dual_rocksdb_st
     // 从BenchmarkConfig中读取batch配置
     config.batch_size_blocks = benchmark_config.batch_size_blocks;
     config.max_batch_size_bytes = benchmark_config.max_batch_size_bytes;
+    config.commit_buffers = benchmark_config.commit_buffers;
+    config.parallel_commit = benchmark_config.parallel_commit;
+    // 每个写线程同时最多有一个data写入在执行器上
+    config.commit_threads = std::max<size_t>(config.commit_threads, benchmark_config.writer_threads);
     
     utils::log_info("Creating DualRocksDB strategy with config:");
     utils::log_info("  Range Size: {}", config.range_size);
@@ -62,6 +68,9 @@ std::unique_ptr<IStorageStrategy> StorageStrategyFactory::create_dual_rocksdb_st
     utils::log_info("  Medium Cache Ratio: {:.2f}%", config.medium_cache_ratio * 100);
     utils::log_info("  Compression: {}", config.enable_compression ? "enabled" : "disabled");
     utils::log_info("  Bloom Filters: enabled");
+    utils::log_info("  Commit Buffers: {}", config.commit_buffers);
+    utils::log_info("  Parallel Commit: {} ({} commit threads)", config.parallel_commit ? "enabled" : "disabled",
+                    config.commit_threads);
     
     return std::make_unique<DualRocksDBStrategy>(config);
 }
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+// Block内写入合并 - 同一个block中同一addr_slot只保留最后一次写入
+// 使用可复用的开放寻址哈希表（线性探测），通过generation标记清空，避免每个block重新分配或memset
+// 不是线程安全的，每个写线程持有一个实例
+class BlockCoalescer {
+public:
+    // 原地合并records，保留每个key首次出现的位置和最后一次写入的value；返回被合并掉的记录数
+    // Record需要有addr_slot、value和block_num成员（例如DataRecord）
+    template <typename Record>
+    size_t coalesce(std::vector<Record>& records) {
+        size_t count = records.size();
+        if (count < 2) {
+            return 0;
+        }
+        prepare(count);
+
+        size_t out = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t hash = std::hash<std::string_view>{}(records[i].addr_slot);
+            size_t pos = hash & mask_;
+            while (true) {
+                Slot& slot = slots_[pos];
+                if (slot.generation != generation_) {
+                    slot.generation = generation_;
+                    slot.index = static_cast<uint32_t>(out);
+                    slot.hash = hash;
+                    if (i != out) {
+                        records[out] = std::move(records[i]);
+                    }
+                    out++;
+                    break;
+                }
+                if (slot.hash == hash && records[slot.index].addr_slot == records[i].addr_slot) {
+                    records[slot.index].value = std::move(records[i].value);
+                    records[slot.index].block_num = records[i].block_num;
+                    break;
+                }
+                pos = (pos + 1) & mask_;
+            }
+        }
+
+        records.resize(out);
+        return count - out;
+    }
+
+    size_t capacity() const { return slots_.size(); }
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        uint32_t index = 0;
+        uint32_t generation = 0;
+    };
+
+    // 保证负载因子不超过0.5；generation回绕时才真正清空
+    void prepare(size_t count) {
+        size_t required = 16;
+        while (required < count * 2) {
+            required <<= 1;
+        }
+        if (required > slots_.size()) {
+            slots_.assign(required, Slot{});
+            mask_ = required - 1;
+            generation_ = 0;
+        }
+        if (++generation_ == 0) {
+            std::fill(slots_.begin(), slots_.end(), Slot{});
+            generation_ = 1;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    uint32_t generation_ = 0;
+};
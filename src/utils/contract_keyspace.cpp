@@ -0,0 +1,88 @@
+#include "contract_keyspace.hpp"
+#include "hash_utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+using utils::append_hex;
+using utils::fmix64;
+
+ContractKeyspace::ContractKeyspace(const Config& config) : config_(config) {
+    if (config_.total_keys == 0) {
+        throw std::invalid_argument("Contract keyspace needs at least one key");
+    }
+    if (config_.slot_alpha <= 0.0) {
+        throw std::invalid_argument("Contract slot alpha must be positive");
+    }
+    if (config_.max_slots == 0) {
+        config_.max_slots = std::max<size_t>(1, config_.total_keys / 20);
+    }
+
+    // 截断Pareto(x_min=1)：slots = floor(U^(-1/α))，U∈(0,1]
+    std::mt19937_64 rng(fmix64(config_.seed ^ 0x5DEECE66DULL));
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double max_slots = static_cast<double>(config_.max_slots);
+    uint64_t next_start = 0;
+    while (next_start < config_.total_keys) {
+        double u = 1.0 - uniform(rng);
+        double draw = std::floor(std::pow(u, -1.0 / config_.slot_alpha));
+        size_t slots = static_cast<size_t>(std::clamp(draw, 1.0, max_slots));
+        slots = std::min<size_t>(slots, config_.total_keys - next_start);
+        contract_starts_.push_back(next_start);
+        largest_slots_ = std::max(largest_slots_, slots);
+        next_start += slots;
+    }
+    contract_starts_.shrink_to_fit();
+}
+
+size_t ContractKeyspace::contract_slots(size_t contract) const {
+    uint64_t end = contract + 1 < contract_starts_.size() ? contract_starts_[contract + 1] : config_.total_keys;
+    return static_cast<size_t>(end - contract_starts_[contract]);
+}
+
+size_t ContractKeyspace::contract_of(size_t index) const {
+    auto it = std::upper_bound(contract_starts_.begin(), contract_starts_.end(), static_cast<uint64_t>(index));
+    return static_cast<size_t>(it - contract_starts_.begin()) - 1;
+}
+
+void ContractKeyspace::fill_key(size_t index, std::string& key) const {
+    size_t contract = contract_of(index);
+    uint64_t slot = index - contract_starts_[contract];
+
+    // 地址的前16位hex是合约号的双射，保证不同合约地址不同
+    uint64_t address = fmix64(contract ^ fmix64(config_.seed));
+    uint64_t address_tail1 = fmix64(address ^ 0x9E3779B97F4A7C15ULL);
+    uint64_t address_tail2 = fmix64(address ^ 0xD1B54A32D192ED03ULL);
+    // slot hash的前16位hex是slot号的双射（以地址为key），同一合约内slot互不相同
+    uint64_t slot_hash = fmix64(slot ^ address);
+
+    key.resize(2 + 40 + 3 + 64);
+    char* out = key.data();
+    std::memcpy(out, "0x", 2);
+    append_hex(out + 2, address, 16);
+    append_hex(out + 18, address_tail1, 16);
+    append_hex(out + 34, address_tail2, 8);
+    std::memcpy(out + 42, "#0x", 3);
+    append_hex(out + 45, slot_hash, 16);
+    append_hex(out + 61, fmix64(slot_hash ^ 1), 16);
+    append_hex(out + 77, fmix64(slot_hash ^ 2), 16);
+    append_hex(out + 93, fmix64(slot_hash ^ 3), 16);
+}
+
+size_t ContractKeyDistribution::pick_slot(size_t contract, std::mt19937& rng) const {
+    size_t slots = keyspace_.contract_slots(contract);
+    size_t offset = slots > 1 ? std::uniform_int_distribution<size_t>(0, slots - 1)(rng) : 0;
+    return keyspace_.contract_start(contract) + offset;
+}
+
+size_t ContractKeyDistribution::next(std::mt19937& rng) const {
+    return pick_slot(contracts_->next(rng), rng);
+}
+
+void ContractKeyDistribution::fill(size_t count, std::mt19937& rng, std::vector<size_t>& out) const {
+    contracts_->fill(count, rng, out);
+    for (auto& index : out) {
+        index = pick_slot(index, rng);
+    }
+}
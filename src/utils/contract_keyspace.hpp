@@ -0,0 +1,60 @@
+#pragma once
+#include "key_distribution.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 按合约聚集的keyspace：key索引[0, total_keys)按合约连续划分，每个合约的slot数服从截断的
+// Pareto幂律（少数大合约占大量slot，长尾小合约只有几个slot）。同一合约的所有key共享地址前缀，
+// 排序后相邻。key格式："0x" + 40位hex地址 + "#0x" + 64位hex（32字节hash后的slot）
+class ContractKeyspace {
+public:
+    struct Config {
+        size_t total_keys = 0;
+        double slot_alpha = 1.0;     // Pareto指数，越小大合约越多
+        size_t max_slots = 0;        // 单个合约的slot上限（0=total_keys/20）
+        uint64_t seed = 0;           // 决定合约大小和地址，相同seed得到相同keyspace
+    };
+
+    explicit ContractKeyspace(const Config& config);
+
+    size_t key_count() const { return config_.total_keys; }
+    size_t contract_count() const { return contract_starts_.size(); }
+    size_t contract_start(size_t contract) const { return contract_starts_[contract]; }
+    size_t contract_slots(size_t contract) const;
+    size_t largest_contract_slots() const { return largest_slots_; }
+
+    // key索引所属的合约（二分查找）
+    size_t contract_of(size_t index) const;
+
+    void fill_key(size_t index, std::string& key) const;
+
+    // 合约起点表的内存占用
+    uint64_t memory_bytes() const { return contract_starts_.capacity() * sizeof(uint64_t); }
+
+private:
+    Config config_;
+    std::vector<uint64_t> contract_starts_;
+    size_t largest_slots_ = 0;
+};
+
+// 先按内层分布选合约，再在合约内均匀选slot。内层分布的索引空间是[0, contract_count)
+class ContractKeyDistribution : public KeyDistribution {
+public:
+    ContractKeyDistribution(std::unique_ptr<KeyDistribution> contract_distribution,
+                            const ContractKeyspace& keyspace)
+        : contracts_(std::move(contract_distribution)), keyspace_(keyspace) {}
+
+    size_t next(std::mt19937& rng) const override;
+    void fill(size_t count, std::mt19937& rng, std::vector<size_t>& out) const override;
+    std::string name() const override { return "contract+" + contracts_->name(); }
+    // 转换成合约索引后交给内层分布
+    void observe_write(size_t index) override { contracts_->observe_write(keyspace_.contract_of(index)); }
+
+private:
+    size_t pick_slot(size_t contract, std::mt19937& rng) const;
+
+    std::unique_ptr<KeyDistribution> contracts_;
+    const ContractKeyspace& keyspace_;
+};
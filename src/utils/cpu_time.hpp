@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <sys/resource.h>
+
+namespace utils {
+
+// 当前线程消耗的CPU时间（用户态+内核态）
+inline uint64_t thread_cpu_ns() {
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// 整个进程（所有线程，包括RocksDB的flush/compaction后台线程）消耗的CPU时间
+struct ProcessCpuTime {
+    uint64_t user_ns = 0;
+    uint64_t system_ns = 0;
+
+    uint64_t total_ns() const { return user_ns + system_ns; }
+};
+
+inline ProcessCpuTime read_process_cpu_time() {
+    ProcessCpuTime cpu;
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        cpu.user_ns = static_cast<uint64_t>(usage.ru_utime.tv_sec) * 1000000000ULL +
+                      static_cast<uint64_t>(usage.ru_utime.tv_usec) * 1000ULL;
+        cpu.system_ns = static_cast<uint64_t>(usage.ru_stime.tv_sec) * 1000000000ULL +
+                        static_cast<uint64_t>(usage.ru_stime.tv_usec) * 1000ULL;
+    }
+    return cpu;
+}
+
+// 把当前线程的CPU时间增量累加到共享计数器：publish()可周期调用（让采样线程看到区间值），
+// 析构时补上最后一段。必须在被计量的线程上构造和使用。
+// 存活期间current_sink()返回本线程的计数器，代替本线程执行工作的线程（如CommitExecutor）可以计入同一个计数器
+class ThreadCpuMeter {
+public:
+    explicit ThreadCpuMeter(std::atomic<uint64_t>& sink)
+        : sink_(sink), last_ns_(thread_cpu_ns()), previous_sink_(current_sink_slot()) {
+        current_sink_slot() = &sink_;
+    }
+    ~ThreadCpuMeter() {
+        publish();
+        current_sink_slot() = previous_sink_;
+    }
+
+    ThreadCpuMeter(const ThreadCpuMeter&) = delete;
+    ThreadCpuMeter& operator=(const ThreadCpuMeter&) = delete;
+
+    void publish() {
+        uint64_t now_ns = thread_cpu_ns();
+        if (now_ns > last_ns_) {
+            sink_.fetch_add(now_ns - last_ns_, std::memory_order_relaxed);
+            last_ns_ = now_ns;
+        }
+    }
+
+    // 当前线程上最内层ThreadCpuMeter的计数器，没有时为nullptr
+    static std::atomic<uint64_t>* current_sink() { return current_sink_slot(); }
+
+private:
+    static std::atomic<uint64_t>*& current_sink_slot() {
+        thread_local std::atomic<uint64_t>* sink = nullptr;
+        return sink;
+    }
+
+    std::atomic<uint64_t>& sink_;
+    uint64_t last_ns_;
+    std::atomic<uint64_t>* previous_sink_;
+};
+
+}  // namespace utils
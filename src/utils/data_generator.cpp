@@ -1,4 +1,5 @@
 #include "data_generator.hpp"
+#include "hash_utils.hpp"
 #include <random>
 #include <sstream>
 #include <iomanip>
@@ -7,13 +8,27 @@
 #include <mutex>
 #include <cstring>
 
-DataGenerator::DataGenerator(const Config& config) : config_(config), rng_(std::random_device{}()) {
-    generate_initial_keys_parallel();
+using utils::append_hex;
+using utils::fmix64;
+
+DataGenerator::DataGenerator(const Config& config)
+    : config_(config), rng_(std::random_device{}()), value_generator_(make_value_generator(config.values)) {
+    if (config_.contract_keys) {
+        ContractKeyspace::Config keyspace_config;
+        keyspace_config.total_keys = config_.total_keys;
+        keyspace_config.slot_alpha = config_.contract_slot_alpha;
+        keyspace_config.max_slots = config_.contract_max_slots;
+        keyspace_config.seed = config_.key_seed;
+        contract_keyspace_ = std::make_unique<ContractKeyspace>(keyspace_config);
+    } else if (!config_.derived_keys) {
+        generate_initial_keys_parallel();
+    }
 }
 
 // 新的构造函数：从外部keys初始化（用于recovery test）
 DataGenerator::DataGenerator(std::vector<std::string> external_keys, const Config& config) 
-    : config_(config), all_keys_(std::move(external_keys)), rng_(std::random_device{}()) {
+    : config_(config), rng_(std::random_device{}()), all_keys_(std::move(external_keys)),
+      value_generator_(make_value_generator(config.values)) {
     // 验证外部keys数量与配置匹配
     if (all_keys_.size() != config.total_keys) {
         // 如果不匹配，调整config
@@ -61,6 +76,10 @@ void DataGenerator::generate_initial_keys_parallel() {
 }
 
 std::vector<size_t> DataGenerator::generate_hotspot_update_indices(size_t batch_size) {
+    return generate_hotspot_update_indices(batch_size, rng_);
+}
+
+std::vector<size_t> DataGenerator::generate_hotspot_update_indices(size_t batch_size, std::mt19937& rng) const {
     std::vector<size_t> indices;
     indices.reserve(batch_size);
     
@@ -75,57 +94,36 @@ std::vector<size_t> DataGenerator::generate_hotspot_update_indices(size_t batch_
                                                    config_.total_keys - 1);
     
     for (size_t i = 0; i < hotspot_count; ++i) {
-        indices.push_back(hotspot_dist(rng_));
+        indices.push_back(hotspot_dist(rng));
     }
     
     for (size_t i = 0; i < medium_count; ++i) {
-        indices.push_back(medium_dist(rng_));
+        indices.push_back(medium_dist(rng));
     }
     
     for (size_t i = 0; i < tail_count; ++i) {
-        indices.push_back(tail_dist(rng_));
+        indices.push_back(tail_dist(rng));
     }
     
-    std::shuffle(indices.begin(), indices.end(), rng_);
+    std::shuffle(indices.begin(), indices.end(), rng);
     return indices;
 }
 
 std::string DataGenerator::generate_unique_random_value(uint64_t index) {
     std::string value;
-    value.resize(32);
-    
-    // 基于唯一索引生成确定性"随机"数据
-    // 使用多个不同的hash函数和黄金比例常数保证分布均匀
-    uint64_t base_index = index + 0x9E3779B97F4A7C15ULL; // 黄金比例常数
-    uint64_t hash1 = std::hash<uint64_t>{}(base_index);
-    uint64_t hash2 = std::hash<uint64_t>{}(base_index ^ 0x87654321FEDCBA98ULL);
-    uint64_t hash3 = std::hash<uint64_t>{}(base_index ^ 0x123456789ABCDEFULL);
-    uint64_t hash4 = std::hash<uint64_t>{}(base_index ^ 0xFEDCBA9876543210ULL);
-    
-    // 进一步打乱，避免hash函数的线性特性
-    hash1 = (hash1 ^ (hash1 >> 30)) * 0xBF58476D1CE4E5B9ULL;
-    hash2 = (hash2 ^ (hash2 >> 30)) * 0xBF58476D1CE4E5B9ULL;
-    hash3 = (hash3 ^ (hash3 >> 30)) * 0xBF58476D1CE4E5B9ULL;
-    hash4 = (hash4 ^ (hash4 >> 30)) * 0xBF58476D1CE4E5B9ULL;
-    
-    hash1 = (hash1 ^ (hash1 >> 27)) * 0x94D049BB133111EBULL;
-    hash2 = (hash2 ^ (hash2 >> 27)) * 0x94D049BB133111EBULL;
-    hash3 = (hash3 ^ (hash3 >> 27)) * 0x94D049BB133111EBULL;
-    hash4 = (hash4 ^ (hash4 >> 27)) * 0x94D049BB133111EBULL;
-    
-    hash1 = hash1 ^ (hash1 >> 31);
-    hash2 = hash2 ^ (hash2 >> 31);
-    hash3 = hash3 ^ (hash3 >> 31);
-    hash4 = hash4 ^ (hash4 >> 31);
-    
-    memcpy(&value[0], &hash1, 8);
-    memcpy(&value[8], &hash2, 8);
-    memcpy(&value[16], &hash3, 8);
-    memcpy(&value[24], &hash4, 8);
-    
+    fill_unique_random_value(index, value);
     return value;
 }
 
+uint64_t DataGenerator::reserve_value_indices(size_t count) {
+    return global_random_value_count_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void DataGenerator::fill_unique_random_value(uint64_t index, std::string& value) const {
+    // 长度和内容只取决于唯一索引，多个写线程可并发调用
+    value_generator_->fill(index, value);
+}
+
 std::string DataGenerator::generate_random_value() {
     uint64_t current_index = global_random_value_count_.fetch_add(1, std::memory_order_relaxed);
     return generate_unique_random_value(current_index);
@@ -170,4 +168,61 @@ std::string DataGenerator::generate_slot() {
 
 std::string DataGenerator::create_addr_slot(const std::string& addr, const std::string& slot) {
     return addr + "#" + slot;
-}
\ No newline at end of file
+}
+
+uint64_t DataGenerator::key_table_bytes() const {
+    uint64_t bytes = all_keys_.capacity() * sizeof(std::string);
+    if (contract_keyspace_) {
+        bytes += contract_keyspace_->memory_bytes();
+    }
+    const size_t inline_capacity = std::string().capacity();
+    for (const auto& key : all_keys_) {
+        if (key.capacity() > inline_capacity) {
+            bytes += key.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+void DataGenerator::format_derived_key(uint64_t seed, uint64_t index, std::string& key) {
+    // 固定seed下index -> permuted是双射；其余位数由permuted再派生，只影响外观
+    uint64_t permuted = fmix64(index ^ fmix64(seed));
+    uint64_t extra1 = fmix64(permuted ^ 0x9E3779B97F4A7C15ULL);
+    uint64_t extra2 = fmix64(permuted ^ 0xD1B54A32D192ED03ULL);
+    uint32_t slot = static_cast<uint32_t>((extra2 >> 32) % 1000000);
+
+    char slot_digits[8];
+    int slot_len = 0;
+    do {
+        slot_digits[slot_len++] = static_cast<char>('0' + slot % 10);
+        slot /= 10;
+    } while (slot > 0);
+
+    key.resize(2 + 40 + 5 + slot_len);
+    char* out = key.data();
+    out[0] = '0';
+    out[1] = 'x';
+    append_hex(out + 2, permuted, 16);
+    append_hex(out + 18, extra1, 16);
+    append_hex(out + 34, extra2, 8);
+    std::memcpy(out + 42, "#slot", 5);
+    for (int i = 0; i < slot_len; ++i) {
+        out[47 + i] = slot_digits[slot_len - 1 - i];
+    }
+}
+
+void DataGenerator::fill_key(size_t index, std::string& key) const {
+    if (contract_keyspace_) {
+        contract_keyspace_->fill_key(index, key);
+    } else if (config_.derived_keys) {
+        format_derived_key(config_.key_seed, index, key);
+    } else {
+        key.assign(all_keys_[index]);
+    }
+}
+
+std::string DataGenerator::key_at(size_t index) const {
+    std::string key;
+    fill_key(index, key);
+    return key;
+}
@@ -4,6 +4,9 @@
 #include <random>
 #include <algorithm>
 #include <atomic>
+#include <memory>
+#include "contract_keyspace.hpp"
+#include "value_generator.hpp"
 #include "../core/types.hpp"
 
 class DataGenerator {
@@ -14,6 +17,15 @@ public:
         size_t hotspot_count = 10000000;
         size_t medium_count = 20000000;
         size_t tail_count = 70000000;
+        // 派生key模式：key i由keyed双射hash按需计算，不生成key表（格式与随机key相同）
+        bool derived_keys = false;
+        uint64_t key_seed = 0;
+        // 合约聚集模式：key按合约分组，每个合约的slot数服从幂律（隐含派生key，不生成key表）
+        bool contract_keys = false;
+        double contract_slot_alpha = 1.0;
+        size_t contract_max_slots = 0;     // 0=total_keys/20
+        // value长度分布和可压缩性，默认固定32字节随机
+        ValueGeneratorParams values;
     };
 
     explicit DataGenerator(const Config& config);
@@ -21,16 +33,38 @@ public:
     // 新的构造函数：从外部keys初始化（用于recovery test）
     DataGenerator(std::vector<std::string> external_keys, const Config& config);
     
+    // 派生key模式下key表为空，应使用key_count()/fill_key()
     const std::vector<std::string>& get_all_keys() const { return all_keys_; }
+    size_t key_count() const { return derived_keys() ? config_.total_keys : all_keys_.size(); }
+    bool derived_keys() const { return config_.derived_keys || contract_keyspace_ != nullptr; }
+    // 合约聚集模式下的keyspace，其他模式返回nullptr
+    const ContractKeyspace* contract_keyspace() const { return contract_keyspace_.get(); }
+    // 把第index个key写入调用方复用的buffer
+    void fill_key(size_t index, std::string& key) const;
+    std::string key_at(size_t index) const;
+    // 派生key："0x" + 40位hex + "#slot" + [0, 999999]；前16位hex是index的双射，不同index的key必然不同
+    static void format_derived_key(uint64_t seed, uint64_t index, std::string& key);
     std::vector<size_t> generate_hotspot_update_indices(size_t batch_size);
+    // 使用调用方提供的RNG流，供多个写线程并发调用（内部rng_不是线程安全的）
+    std::vector<size_t> generate_hotspot_update_indices(size_t batch_size, std::mt19937& rng) const;
     std::string generate_random_value();
     std::vector<std::string> generate_random_values(size_t count);
+    
+    // 复用buffer的随机值生成：先批量预留全局唯一索引，再原地写入value，避免每条记录分配新string
+    uint64_t reserve_value_indices(size_t count);
+    void fill_unique_random_value(uint64_t index, std::string& value) const;
+    const ValueGenerator& value_generator() const { return *value_generator_; }
     void generate_initial_keys_parallel();
     
+    // key表的内存占用：vector本身 + 超出SSO的string堆分配；合约模式下为合约起点表
+    uint64_t key_table_bytes() const;
+    
 private:
     Config config_;
     std::mt19937 rng_;
     std::vector<std::string> all_keys_;
+    std::unique_ptr<ContractKeyspace> contract_keyspace_;
+    std::unique_ptr<ValueGenerator> value_generator_;
     
     // 全局随机值计数器，保证所有生成的随机值都是唯一的
     std::atomic<uint64_t> global_random_value_count_{0};
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+namespace utils {
+
+// murmur3 fmix64：xorshift和奇数乘法都可逆，整体是64位上的双射
+inline uint64_t fmix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// 把bits的低digits个16进制位写到out[0, digits)（小写，高位在前，不写结尾的'\0'）
+inline void append_hex(char* out, uint64_t bits, int digits) {
+    for (int i = digits - 1; i >= 0; --i) {
+        out[i] = "0123456789abcdef"[bits & 0xF];
+        bits >>= 4;
+    }
+}
+
+}  // namespace utils
@@ -0,0 +1,259 @@
+#pragma once
+#include "latency_histogram.hpp"
+#include "tsc_clock.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+// 按名称聚合的锁竞争统计。同名的多个锁实例（例如各个LRU分段）共享一份统计
+struct LockStats {
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};     // try_lock失败、需要等待的获取次数
+    LatencyHistogram wait_ns;               // 只记录竞争获取的等待时间
+    LatencyHistogram hold_ns;               // 独占持有时间（共享模式不记录）
+};
+
+// 全局锁统计注册表 - 运行时开关（--lock-stats），关闭时锁只多一次relaxed load
+class LockStatsRegistry {
+public:
+    struct Snapshot {
+        std::string name;
+        uint64_t acquisitions = 0;
+        uint64_t contended = 0;
+        uint64_t wait_total_ns = 0;
+        double wait_p50_us = 0.0;
+        double wait_p99_us = 0.0;
+        double wait_max_us = 0.0;
+        uint64_t hold_total_ns = 0;
+        double hold_p50_us = 0.0;
+        double hold_p99_us = 0.0;
+        double hold_max_us = 0.0;
+
+        double contention_rate() const {
+            return acquisitions > 0 ? static_cast<double>(contended) / acquisitions : 0.0;
+        }
+    };
+
+    static LockStatsRegistry& instance() {
+        static LockStatsRegistry registry;
+        return registry;
+    }
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    // 返回的引用在进程生命周期内有效
+    LockStats& get(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& stats = stats_[name];
+        if (!stats) {
+            stats = std::make_unique<LockStats>();
+        }
+        return *stats;
+    }
+
+    // 只能在没有线程持有被统计的锁时调用（例如测试开始前）
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, stats] : stats_) {
+            stats->acquisitions = 0;
+            stats->contended = 0;
+            stats->wait_ns.reset();
+            stats->hold_ns.reset();
+        }
+    }
+
+    // 按总等待时间从高到低排序，未被获取过的锁不输出
+    std::vector<Snapshot> snapshot() const {
+        std::vector<Snapshot> result;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, stats] : stats_) {
+            Snapshot s;
+            s.name = name;
+            s.acquisitions = stats->acquisitions.load(std::memory_order_relaxed);
+            if (s.acquisitions == 0) {
+                continue;
+            }
+            s.contended = stats->contended.load(std::memory_order_relaxed);
+            s.wait_total_ns = stats->wait_ns.sum();
+            s.wait_p50_us = stats->wait_ns.value_at_percentile(50.0) / 1e3;
+            s.wait_p99_us = stats->wait_ns.value_at_percentile(99.0) / 1e3;
+            s.wait_max_us = stats->wait_ns.max() / 1e3;
+            s.hold_total_ns = stats->hold_ns.sum();
+            s.hold_p50_us = stats->hold_ns.value_at_percentile(50.0) / 1e3;
+            s.hold_p99_us = stats->hold_ns.value_at_percentile(99.0) / 1e3;
+            s.hold_max_us = stats->hold_ns.max() / 1e3;
+            result.push_back(std::move(s));
+        }
+        std::sort(result.begin(), result.end(), [](const Snapshot& a, const Snapshot& b) {
+            return a.wait_total_ns > b.wait_total_ns;
+        });
+        return result;
+    }
+
+    void print_report() const {
+        auto rows = snapshot();
+        if (rows.empty()) {
+            return;
+        }
+        utils::log_info("=== Lock Contention ===");
+        utils::log_info("{:<36} {:>12} {:>10} {:>7} {:>11} {:>10} {:>10} {:>10} {:>11} {:>10} {:>10}",
+                       "lock", "acquisitions", "contended", "rate", "wait_ms", "wait_p50", "wait_p99",
+                       "wait_max", "hold_ms", "hold_p50", "hold_p99");
+        for (const auto& row : rows) {
+            utils::log_info("{:<36} {:>12} {:>10} {:>6.2f}% {:>11.3f} {:>8.1f}us {:>8.1f}us {:>8.1f}us {:>11.3f} {:>8.1f}us {:>8.1f}us",
+                           row.name, row.acquisitions, row.contended, row.contention_rate() * 100.0,
+                           row.wait_total_ns / 1e6, row.wait_p50_us, row.wait_p99_us, row.wait_max_us,
+                           row.hold_total_ns / 1e6, row.hold_p50_us, row.hold_p99_us);
+        }
+    }
+
+private:
+    LockStatsRegistry() = default;
+
+    inline static std::atomic<bool> enabled_{false};
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<LockStats>> stats_;
+};
+
+// 带统计的std::mutex替代品，满足Lockable，可直接用于std::lock_guard/std::unique_lock。
+// 先try_lock，失败才计时等待，未竞争的获取不读时钟（持有时间除外）
+class InstrumentedMutex {
+public:
+    explicit InstrumentedMutex(const std::string& name)
+        : stats_(&LockStatsRegistry::instance().get(name)) {}
+
+    InstrumentedMutex(const InstrumentedMutex&) = delete;
+    InstrumentedMutex& operator=(const InstrumentedMutex&) = delete;
+
+    void lock() {
+        if (!LockStatsRegistry::enabled()) {
+            mutex_.lock();
+            acquired_at_ = 0;
+            return;
+        }
+        if (!mutex_.try_lock()) {
+            uint64_t wait_start = TscClock::now();
+            mutex_.lock();
+            stats_->wait_ns.record(TscClock::elapsed_nanos(wait_start));
+            stats_->contended.fetch_add(1, std::memory_order_relaxed);
+        }
+        stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_at_ = TscClock::now();
+    }
+
+    bool try_lock() {
+        if (!mutex_.try_lock()) {
+            return false;
+        }
+        if (LockStatsRegistry::enabled()) {
+            stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+            acquired_at_ = TscClock::now();
+        } else {
+            acquired_at_ = 0;
+        }
+        return true;
+    }
+
+    void unlock() {
+        // acquired_at_只由持有者读写，释放前读取
+        if (acquired_at_ != 0) {
+            stats_->hold_ns.record(TscClock::elapsed_nanos(acquired_at_));
+        }
+        mutex_.unlock();
+    }
+
+    // 底层mutex：只用于必须是std::mutex的场合（例如测试直接加锁），经此加锁不计入统计
+    std::mutex& native() { return mutex_; }
+
+private:
+    std::mutex mutex_;
+    LockStats* stats_;
+    uint64_t acquired_at_ = 0;
+};
+
+// 带统计的std::shared_mutex替代品。独占和共享模式分别统计（共享模式名称加":shared"后缀），
+// 共享模式可能有多个持有者，只统计获取和等待
+class InstrumentedSharedMutex {
+public:
+    explicit InstrumentedSharedMutex(const std::string& name)
+        : exclusive_(&LockStatsRegistry::instance().get(name)),
+          shared_(&LockStatsRegistry::instance().get(name + ":shared")) {}
+
+    InstrumentedSharedMutex(const InstrumentedSharedMutex&) = delete;
+    InstrumentedSharedMutex& operator=(const InstrumentedSharedMutex&) = delete;
+
+    void lock() {
+        if (!LockStatsRegistry::enabled()) {
+            mutex_.lock();
+            acquired_at_ = 0;
+            return;
+        }
+        if (!mutex_.try_lock()) {
+            uint64_t wait_start = TscClock::now();
+            mutex_.lock();
+            exclusive_->wait_ns.record(TscClock::elapsed_nanos(wait_start));
+            exclusive_->contended.fetch_add(1, std::memory_order_relaxed);
+        }
+        exclusive_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_at_ = TscClock::now();
+    }
+
+    bool try_lock() {
+        if (!mutex_.try_lock()) {
+            return false;
+        }
+        if (LockStatsRegistry::enabled()) {
+            exclusive_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+            acquired_at_ = TscClock::now();
+        } else {
+            acquired_at_ = 0;
+        }
+        return true;
+    }
+
+    void unlock() {
+        if (acquired_at_ != 0) {
+            exclusive_->hold_ns.record(TscClock::elapsed_nanos(acquired_at_));
+        }
+        mutex_.unlock();
+    }
+
+    void lock_shared() {
+        if (!LockStatsRegistry::enabled()) {
+            mutex_.lock_shared();
+            return;
+        }
+        if (!mutex_.try_lock_shared()) {
+            uint64_t wait_start = TscClock::now();
+            mutex_.lock_shared();
+            shared_->wait_ns.record(TscClock::elapsed_nanos(wait_start));
+            shared_->contended.fetch_add(1, std::memory_order_relaxed);
+        }
+        shared_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool try_lock_shared() {
+        if (!mutex_.try_lock_shared()) {
+            return false;
+        }
+        if (LockStatsRegistry::enabled()) {
+            shared_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    void unlock_shared() { mutex_.unlock_shared(); }
+
+private:
+    std::shared_mutex mutex_;
+    LockStats* exclusive_;
+    LockStats* shared_;
+    uint64_t acquired_at_ = 0;
+};
@@ -0,0 +1,187 @@
+#include "key_distribution.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+double uniform01(std::mt19937& rng) {
+    return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+}
+
+size_t uniform_index(std::mt19937& rng, size_t first, size_t last) {
+    return std::uniform_int_distribution<size_t>(first, last)(rng);
+}
+
+// log1p(x)/x，x接近0时用泰勒展开避免精度损失
+double helper1(double x) {
+    return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+// expm1(x)/x
+double helper2(double x) {
+    return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+}
+
+uint64_t mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+}  // namespace
+
+size_t UniformKeyDistribution::next(std::mt19937& rng) const {
+    return uniform_index(rng, 0, key_count_ - 1);
+}
+
+TieredKeyDistribution::TieredKeyDistribution(size_t key_count, size_t hot_count, size_t medium_count)
+    : key_count_(key_count),
+      hot_count_(std::clamp<size_t>(hot_count, 1, key_count)),
+      medium_count_(std::min(medium_count, key_count - hot_count_)) {}
+
+size_t TieredKeyDistribution::next(std::mt19937& rng) const {
+    double tier = uniform01(rng);
+    size_t tail_start = hot_count_ + medium_count_;
+    if (tier < 0.8 || tail_start >= key_count_) {
+        return uniform_index(rng, 0, hot_count_ - 1);
+    }
+    if (tier < 0.9 && medium_count_ > 0) {
+        return uniform_index(rng, hot_count_, tail_start - 1);
+    }
+    return uniform_index(rng, tail_start, key_count_ - 1);
+}
+
+void TieredKeyDistribution::fill(size_t count, std::mt19937& rng, std::vector<size_t>& out) const {
+    out.clear();
+    out.reserve(count);
+    size_t hot = static_cast<size_t>(count * 0.8);
+    size_t medium = medium_count_ > 0 ? static_cast<size_t>(count * 0.1) : 0;
+    size_t tail_start = hot_count_ + medium_count_;
+    for (size_t i = 0; i < hot; ++i) {
+        out.push_back(uniform_index(rng, 0, hot_count_ - 1));
+    }
+    for (size_t i = 0; i < medium; ++i) {
+        out.push_back(uniform_index(rng, hot_count_, tail_start - 1));
+    }
+    for (size_t i = hot + medium; i < count; ++i) {
+        out.push_back(tail_start < key_count_ ? uniform_index(rng, tail_start, key_count_ - 1)
+                                              : uniform_index(rng, 0, hot_count_ - 1));
+    }
+    std::shuffle(out.begin(), out.end(), rng);
+}
+
+ZipfianKeyDistribution::ZipfianKeyDistribution(size_t key_count, double theta)
+    : key_count_(std::max<size_t>(key_count, 1)), theta_(theta) {
+    h_integral_x1_ = h_integral(1.5) - 1.0;
+    h_integral_n_ = h_integral(static_cast<double>(key_count_) + 0.5);
+    s_ = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+}
+
+// h(x) = x^-θ
+double ZipfianKeyDistribution::h(double x) const {
+    return std::exp(-theta_ * std::log(x));
+}
+
+// H(x) = ∫h，θ=1时退化为log(x)
+double ZipfianKeyDistribution::h_integral(double x) const {
+    double log_x = std::log(x);
+    return helper2((1.0 - theta_) * log_x) * log_x;
+}
+
+double ZipfianKeyDistribution::h_integral_inverse(double x) const {
+    double t = x * (1.0 - theta_);
+    if (t < -1.0) {
+        t = -1.0;   // 数值误差保护
+    }
+    return std::exp(helper1(t) * x);
+}
+
+uint64_t ZipfianKeyDistribution::sample_rank(std::mt19937& rng) const {
+    while (true) {
+        double u = h_integral_n_ + uniform01(rng) * (h_integral_x1_ - h_integral_n_);
+        double x = h_integral_inverse(u);
+        double k = std::floor(x + 0.5);
+        k = std::clamp(k, 1.0, static_cast<double>(key_count_));
+        // 大多数样本在第一个条件处直接接受
+        if (k - x <= s_ || u >= h_integral(k + 0.5) - h(k)) {
+            return static_cast<uint64_t>(k);
+        }
+    }
+}
+
+size_t ScrambledZipfianKeyDistribution::next(std::mt19937& rng) const {
+    return static_cast<size_t>(mix64(zipf_.sample_rank(rng)) % zipf_.key_count());
+}
+
+size_t LatestKeyDistribution::next(std::mt19937& rng) const {
+    size_t n = zipf_.key_count();
+    size_t latest = latest_.load(std::memory_order_relaxed) % n;
+    size_t back = static_cast<size_t>(zipf_.sample_rank(rng) - 1);
+    return (latest + n - back) % n;
+}
+
+MovingHotspotKeyDistribution::MovingHotspotKeyDistribution(size_t key_count, double fraction, double probability,
+                                                           double period_seconds)
+    : key_count_(std::max<size_t>(key_count, 1)),
+      window_size_(std::clamp<size_t>(static_cast<size_t>(key_count * fraction), 1, std::max<size_t>(key_count, 1))),
+      probability_(probability),
+      period_seconds_(period_seconds),
+      origin_(std::chrono::steady_clock::now()) {}
+
+size_t MovingHotspotKeyDistribution::window_start(double elapsed_seconds) const {
+    if (period_seconds_ <= 0.0 || elapsed_seconds <= 0.0) {
+        return 0;
+    }
+    auto moves = static_cast<uint64_t>(elapsed_seconds / period_seconds_);
+    return static_cast<size_t>((moves * window_size_) % key_count_);
+}
+
+size_t MovingHotspotKeyDistribution::next(std::mt19937& rng) const {
+    if (uniform01(rng) >= probability_) {
+        return uniform_index(rng, 0, key_count_ - 1);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - origin_).count();
+    size_t offset = uniform_index(rng, 0, window_size_ - 1);
+    return (window_start(elapsed) + offset) % key_count_;
+}
+
+const std::vector<std::string>& key_distribution_names() {
+    static const std::vector<std::string> names = {
+        "uniform", "tiered", "zipfian", "scrambled_zipfian", "latest", "hotspot",
+    };
+    return names;
+}
+
+bool is_key_distribution_name(const std::string& name) {
+    const auto& names = key_distribution_names();
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+std::unique_ptr<KeyDistribution> make_key_distribution(const std::string& name, size_t key_count,
+                                                       const KeyDistributionParams& params) {
+    if (key_count == 0) {
+        throw std::invalid_argument("Key distribution needs at least one key");
+    }
+    if (name == "uniform") {
+        return std::make_unique<UniformKeyDistribution>(key_count);
+    }
+    if (name == "tiered") {
+        return std::make_unique<TieredKeyDistribution>(key_count, params.hot_count, params.medium_count);
+    }
+    if (name == "zipfian") {
+        return std::make_unique<ZipfianKeyDistribution>(key_count, params.zipf_theta);
+    }
+    if (name == "scrambled_zipfian") {
+        return std::make_unique<ScrambledZipfianKeyDistribution>(key_count, params.zipf_theta);
+    }
+    if (name == "latest") {
+        return std::make_unique<LatestKeyDistribution>(key_count, params.zipf_theta);
+    }
+    if (name == "hotspot") {
+        return std::make_unique<MovingHotspotKeyDistribution>(key_count, params.hotspot_fraction,
+                                                              params.hotspot_probability,
+                                                              params.hotspot_period_seconds);
+    }
+    throw std::invalid_argument("Unknown key distribution: " + name);
+}
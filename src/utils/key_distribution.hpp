@@ -0,0 +1,145 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// key热度分布 - 在[0, key_count)中抽取key索引。除observe_write外实现只读（latest的最新位置是原子量），
+// 同一个实例可被多个线程共享，每个线程使用自己的RNG
+class KeyDistribution {
+public:
+    virtual ~KeyDistribution() = default;
+
+    virtual size_t next(std::mt19937& rng) const = 0;
+    virtual std::string name() const = 0;
+
+    // 一次抽取count个索引，默认逐个调用next
+    virtual void fill(size_t count, std::mt19937& rng, std::vector<size_t>& out) const {
+        out.clear();
+        out.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(next(rng));
+        }
+    }
+
+    // 写线程每写完一个block调用一次，index为本block最后写入的key索引。默认忽略
+    virtual void observe_write(size_t index) { (void)index; }
+};
+
+struct KeyDistributionParams {
+    double zipf_theta = 0.99;              // Zipfian指数θ，越大越偏斜
+    size_t hot_count = 0;                  // tiered：热点段[0, hot_count)
+    size_t medium_count = 0;               // tiered：中间段[hot_count, hot_count + medium_count)
+    double hotspot_fraction = 0.01;        // hotspot：热点窗口占keyspace的比例
+    double hotspot_probability = 0.9;      // hotspot：访问落在热点窗口内的概率
+    double hotspot_period_seconds = 60.0;  // hotspot：窗口每隔多少秒移动一个窗口宽度（0=不移动）
+};
+
+// 均匀分布
+class UniformKeyDistribution : public KeyDistribution {
+public:
+    explicit UniformKeyDistribution(size_t key_count) : key_count_(key_count) {}
+    size_t next(std::mt19937& rng) const override;
+    std::string name() const override { return "uniform"; }
+
+private:
+    size_t key_count_;
+};
+
+// 固定分段：80%落在热点段，10%中间段，10%尾部。fill保持原来每个block精确按比例生成再打乱的方式
+class TieredKeyDistribution : public KeyDistribution {
+public:
+    TieredKeyDistribution(size_t key_count, size_t hot_count, size_t medium_count);
+    size_t next(std::mt19937& rng) const override;
+    void fill(size_t count, std::mt19937& rng, std::vector<size_t>& out) const override;
+    std::string name() const override { return "tiered"; }
+
+private:
+    size_t key_count_;
+    size_t hot_count_;
+    size_t medium_count_;
+};
+
+// Zipfian分布，rejection-inversion采样（Hörmann & Derflinger 1996）：O(1)、无需预计算表，
+// 期望拒绝次数很小。rank 1（最热）对应索引0
+class ZipfianKeyDistribution : public KeyDistribution {
+public:
+    ZipfianKeyDistribution(size_t key_count, double theta);
+    size_t next(std::mt19937& rng) const override { return static_cast<size_t>(sample_rank(rng) - 1); }
+    std::string name() const override { return "zipfian"; }
+
+    // 返回[1, key_count]中的rank
+    uint64_t sample_rank(std::mt19937& rng) const;
+    size_t key_count() const { return key_count_; }
+
+private:
+    double h(double x) const;
+    double h_integral(double x) const;
+    double h_integral_inverse(double x) const;
+
+    size_t key_count_;
+    double theta_;
+    double h_integral_x1_;
+    double h_integral_n_;
+    double s_;
+};
+
+// 打散的Zipfian：热度仍服从Zipfian，但热点key通过hash散布在整个keyspace，而不是集中在低索引
+class ScrambledZipfianKeyDistribution : public KeyDistribution {
+public:
+    ScrambledZipfianKeyDistribution(size_t key_count, double theta) : zipf_(key_count, theta) {}
+    size_t next(std::mt19937& rng) const override;
+    std::string name() const override { return "scrambled_zipfian"; }
+
+private:
+    ZipfianKeyDistribution zipf_;
+};
+
+// 最近写入优先：以最新写入的key为rank 1向前按Zipfian衰减。initial load按索引顺序插入，
+// 默认最新位置为最后一个key；之后由写线程通过observe_write把最新位置移到最近写入的key
+class LatestKeyDistribution : public KeyDistribution {
+public:
+    LatestKeyDistribution(size_t key_count, double theta)
+        : zipf_(key_count, theta), latest_(key_count > 0 ? key_count - 1 : 0) {}
+    size_t next(std::mt19937& rng) const override;
+    std::string name() const override { return "latest"; }
+    void observe_write(size_t index) override { set_latest(index); }
+
+    void set_latest(size_t index) { latest_.store(index, std::memory_order_relaxed); }
+    size_t latest() const { return latest_.load(std::memory_order_relaxed); }
+
+private:
+    ZipfianKeyDistribution zipf_;
+    std::atomic<size_t> latest_;
+};
+
+// 移动热点：hotspot_probability的访问均匀落在宽度为hotspot_fraction的窗口内，其余均匀落在整个keyspace；
+// 窗口从构造时刻起每hotspot_period_seconds向后移动一个窗口宽度，模拟热点随时间漂移
+class MovingHotspotKeyDistribution : public KeyDistribution {
+public:
+    MovingHotspotKeyDistribution(size_t key_count, double fraction, double probability, double period_seconds);
+    size_t next(std::mt19937& rng) const override;
+    std::string name() const override { return "hotspot"; }
+
+    // 给定经过的秒数时热点窗口的起点
+    size_t window_start(double elapsed_seconds) const;
+    size_t window_size() const { return window_size_; }
+
+private:
+    size_t key_count_;
+    size_t window_size_;
+    double probability_;
+    double period_seconds_;
+    std::chrono::steady_clock::time_point origin_;
+};
+
+// 支持的分布名称：uniform, tiered, zipfian, scrambled_zipfian, latest, hotspot
+const std::vector<std::string>& key_distribution_names();
+bool is_key_distribution_name(const std::string& name);
+
+// 未知名称抛出std::invalid_argument
+std::unique_ptr<KeyDistribution> make_key_distribution(const std::string& name, size_t key_count,
+                                                       const KeyDistributionParams& params);
@@ -0,0 +1,203 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+// HDR风格的对数分桶延迟直方图（单位：纳秒）
+// 每个2的幂区间再线性分成128个子桶，相对误差<1%，内存固定（约58KB），record为O(1)
+// record()只允许一个线程（拥有者）调用，使用relaxed原子读写，其他线程可随时无锁地读取或合并；
+// merge_from()使用fetch_add，多个线程可以同时向同一个汇总直方图合并
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 7;
+    static constexpr uint64_t kSubBucketCount = 1ULL << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+    LatencyHistogram() : counts_(new std::atomic<uint64_t>[kBucketCount]) {
+        reset();
+    }
+
+    // 单个直方图的内存占用（对象本身+分桶数组）
+    static constexpr size_t memory_bytes() {
+        return sizeof(LatencyHistogram) + kBucketCount * sizeof(std::atomic<uint64_t>);
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t value_ns) {
+        auto& bucket = counts_[bucket_index(value_ns)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total_count_.store(total_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total_sum_.store(total_sum_.load(std::memory_order_relaxed) + value_ns, std::memory_order_relaxed);
+        if (value_ns < min_.load(std::memory_order_relaxed)) {
+            min_.store(value_ns, std::memory_order_relaxed);
+        }
+        if (value_ns > max_.load(std::memory_order_relaxed)) {
+            max_.store(value_ns, std::memory_order_relaxed);
+        }
+    }
+
+    void merge_from(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            uint64_t count = other.counts_[i].load(std::memory_order_relaxed);
+            if (count != 0) {
+                counts_[i].fetch_add(count, std::memory_order_relaxed);
+            }
+        }
+        total_count_.fetch_add(other.count(), std::memory_order_relaxed);
+        total_sum_.fetch_add(other.total_sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        update_min(other.min_.load(std::memory_order_relaxed));
+        update_max(other.max_.load(std::memory_order_relaxed));
+    }
+
+    // 从当前直方图中减去一个较早的快照，得到区间直方图；min/max按非空桶的边界重新估算
+    // 只能用于不再被record()的快照（例如采样线程自己持有的副本）
+    void subtract(const LatencyHistogram& earlier) {
+        uint64_t new_min = std::numeric_limits<uint64_t>::max();
+        uint64_t new_max = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            uint64_t current = counts_[i].load(std::memory_order_relaxed);
+            uint64_t previous = earlier.counts_[i].load(std::memory_order_relaxed);
+            uint64_t remaining = current > previous ? current - previous : 0;
+            counts_[i].store(remaining, std::memory_order_relaxed);
+            if (remaining != 0) {
+                new_min = std::min(new_min, bucket_lower_bound(i));
+                new_max = std::max(new_max, bucket_upper_bound(i));
+            }
+        }
+        uint64_t count_now = count();
+        uint64_t count_before = earlier.count();
+        total_count_.store(count_now > count_before ? count_now - count_before : 0, std::memory_order_relaxed);
+        uint64_t sum_now = total_sum_.load(std::memory_order_relaxed);
+        uint64_t sum_before = earlier.total_sum_.load(std::memory_order_relaxed);
+        total_sum_.store(sum_now > sum_before ? sum_now - sum_before : 0, std::memory_order_relaxed);
+        min_.store(std::max(new_min, min_.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        max_.store(std::min(new_max, max_.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    }
+
+    void copy_from(const LatencyHistogram& other) {
+        reset();
+        merge_from(other);
+    }
+
+    void reset() {
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+        total_count_.store(0, std::memory_order_relaxed);
+        total_sum_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    // 直接累加某个桶的计数，用于从导出的结果文件恢复直方图；之后用restore_summary设置sum/min/max
+    void add_to_bucket(size_t index, uint64_t count) {
+        if (index >= kBucketCount || count == 0) {
+            return;
+        }
+        counts_[index].fetch_add(count, std::memory_order_relaxed);
+        total_count_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void restore_summary(uint64_t sum, uint64_t min_value, uint64_t max_value) {
+        total_sum_.store(sum, std::memory_order_relaxed);
+        min_.store(min_value, std::memory_order_relaxed);
+        max_.store(max_value, std::memory_order_relaxed);
+    }
+
+    // 遍历非空桶：fn(index, count)
+    template <typename Fn>
+    void for_each_bucket(Fn&& fn) const {
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            uint64_t count = counts_[i].load(std::memory_order_relaxed);
+            if (count != 0) {
+                fn(i, count);
+            }
+        }
+    }
+
+    uint64_t count() const { return total_count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return total_sum_.load(std::memory_order_relaxed); }
+    uint64_t min() const { return count() == 0 ? 0 : min_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    double mean() const {
+        uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(total_sum_.load(std::memory_order_relaxed)) / n;
+    }
+
+    // 返回percentile（0-100）对应的值：所在桶的上界，并截断到记录过的最大值
+    uint64_t value_at_percentile(double percentile) const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            total += counts_[i].load(std::memory_order_relaxed);
+        }
+        if (total == 0) {
+            return 0;
+        }
+        percentile = std::clamp(percentile, 0.0, 100.0);
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+        target = std::clamp<uint64_t>(target, 1, total);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                return std::min(bucket_upper_bound(i), max());
+            }
+        }
+        return max();
+    }
+
+    double percentile_ms(double percentile) const {
+        return value_at_percentile(percentile) / 1e6;
+    }
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < kSubBucketCount) {
+            return static_cast<size_t>(value);
+        }
+        int msb = 63 - std::countl_zero(value);
+        int shift = msb - kSubBucketBits;
+        return (static_cast<size_t>(shift + 1) << kSubBucketBits) +
+               static_cast<size_t>((value >> shift) - kSubBucketCount);
+    }
+
+    static uint64_t bucket_lower_bound(size_t index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        int shift = static_cast<int>(index >> kSubBucketBits) - 1;
+        uint64_t sub = index & (kSubBucketCount - 1);
+        return (kSubBucketCount + sub) << shift;
+    }
+
+    static uint64_t bucket_upper_bound(size_t index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        int shift = static_cast<int>(index >> kSubBucketBits) - 1;
+        return bucket_lower_bound(index) + ((1ULL << shift) - 1);
+    }
+
+private:
+    void update_min(uint64_t value) {
+        uint64_t current = min_.load(std::memory_order_relaxed);
+        while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    void update_max(uint64_t value) {
+        uint64_t current = max_.load(std::memory_order_relaxed);
+        while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+    std::atomic<uint64_t> total_count_{0};
+    std::atomic<uint64_t> total_sum_{0};
+    std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_{0};
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 按秒聚合的延迟时间线 - 每秒一个槽位，记录次数、总延迟和最大延迟，
+// 用于把延迟尖峰与RocksDB的flush/compaction/写停顿事件按时间对齐。
+// record可并发调用；reset只能在没有记录线程时调用
+class LatencyTimeline {
+public:
+    struct Second {
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t max_ns = 0;
+
+        double avg_ms() const { return count > 0 ? sum_ns / 1e6 / count : 0.0; }
+        double max_ms() const { return max_ns / 1e6; }
+    };
+
+    // origin_ns为第0秒的起点，超出seconds范围的记录计入最后一个槽位
+    void reset(int64_t origin_ns, size_t seconds) {
+        origin_ns_ = origin_ns;
+        size_ = std::max<size_t>(1, seconds);
+        slots_ = std::make_unique<Slot[]>(size_);
+    }
+
+    void record(int64_t now_ns, uint64_t latency_ns) {
+        if (!slots_) {
+            return;
+        }
+        Slot& slot = slots_[index_of(now_ns)];
+        slot.count.fetch_add(1, std::memory_order_relaxed);
+        slot.sum_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+        uint64_t current = slot.max_ns.load(std::memory_order_relaxed);
+        while (latency_ns > current &&
+               !slot.max_ns.compare_exchange_weak(current, latency_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    size_t size() const { return slots_ ? size_ : 0; }
+    int64_t origin_ns() const { return origin_ns_; }
+    size_t memory_bytes() const { return sizeof(LatencyTimeline) + size() * sizeof(Slot); }
+
+    Second at(size_t second) const {
+        Second result;
+        if (second < size()) {
+            result.count = slots_[second].count.load(std::memory_order_relaxed);
+            result.sum_ns = slots_[second].sum_ns.load(std::memory_order_relaxed);
+            result.max_ns = slots_[second].max_ns.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // 与[from_ns, to_ns]重叠的所有整秒的合计
+    Second aggregate(int64_t from_ns, int64_t to_ns) const {
+        Second result;
+        if (size() == 0 || to_ns < from_ns) {
+            return result;
+        }
+        for (size_t i = index_of(from_ns), last = index_of(to_ns); i <= last; ++i) {
+            Second second = at(i);
+            result.count += second.count;
+            result.sum_ns += second.sum_ns;
+            result.max_ns = std::max(result.max_ns, second.max_ns);
+        }
+        return result;
+    }
+
+    // [first, last)秒内每window_seconds秒一个窗口的平均每秒次数（吞吐时间线），最后不足一个窗口的部分按实际秒数平均
+    std::vector<double> window_rates(size_t first, size_t last, size_t window_seconds) const {
+        std::vector<double> rates;
+        window_seconds = std::max<size_t>(1, window_seconds);
+        for (size_t start = first; start < last; start += window_seconds) {
+            size_t end = std::min(last, start + window_seconds);
+            uint64_t count = 0;
+            for (size_t i = start; i < end; ++i) {
+                count += at(i).count;
+            }
+            rates.push_back(static_cast<double>(count) / static_cast<double>(end - start));
+        }
+        return rates;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+    };
+
+    size_t index_of(int64_t ns) const {
+        if (ns <= origin_ns_) {
+            return 0;
+        }
+        return std::min<size_t>(static_cast<size_t>((ns - origin_ns_) / 1000000000), size_ - 1);
+    }
+
+    int64_t origin_ns_ = 0;
+    size_t size_ = 0;
+    std::unique_ptr<Slot[]> slots_;
+};
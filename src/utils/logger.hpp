@@ -97,6 +97,11 @@ void log_debug(fmt::format_string<Args...> fmt_str, Args&&... args) {
     spdlog::debug(fmt_str, std::forward<Args>(args)...);
 }
 
+// debug日志是否会输出：参数计算代价较高的debug日志先检查，避免在热路径上白算
+inline bool debug_enabled() {
+    return spdlog::should_log(spdlog::level::debug);
+}
+
 template<typename... Args>
 void log_warn(fmt::format_string<Args...> fmt_str, Args&&... args) {
     spdlog::warn(fmt_str, std::forward<Args>(args)...);
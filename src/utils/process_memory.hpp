@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace utils {
+
+// 进程内存（来自/proc/self/status）：当前RSS和峰值RSS，非Linux平台返回0
+struct ProcessMemory {
+    uint64_t rss_bytes = 0;
+    uint64_t peak_rss_bytes = 0;
+};
+
+inline ProcessMemory read_process_memory() {
+    ProcessMemory memory;
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    auto parse_kb = [](const std::string& text) {
+        uint64_t value = 0;
+        for (char c : text) {
+            if (c >= '0' && c <= '9') {
+                value = value * 10 + static_cast<uint64_t>(c - '0');
+            }
+        }
+        return value * 1024;
+    };
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            memory.rss_bytes = parse_kb(line.substr(6));
+        } else if (line.rfind("VmHWM:", 0) == 0) {
+            memory.peak_rss_bytes = parse_kb(line.substr(6));
+        }
+    }
+    return memory;
+}
+
+}  // namespace utils
@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// 低开销计时时钟 - x86上使用rdtsc，aarch64上使用虚拟计数器，其他平台退回steady_clock
+// 频率在首次使用时对照steady_clock校准一次（假设现代CPU的invariant TSC，各核心同步）
+class TscClock {
+public:
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    static double ticks_per_ns() {
+        static const double ratio = calibrate();
+        return ratio;
+    }
+
+    static uint64_t to_nanos(uint64_t ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) / ticks_per_ns());
+    }
+
+    static uint64_t elapsed_nanos(uint64_t start_ticks) {
+        uint64_t end_ticks = now();
+        return end_ticks > start_ticks ? to_nanos(end_ticks - start_ticks) : 0;
+    }
+
+private:
+    static double calibrate() {
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+        auto wall_start = std::chrono::steady_clock::now();
+        uint64_t tick_start = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        uint64_t tick_end = now();
+        auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - wall_start).count();
+        if (wall_ns <= 0 || tick_end <= tick_start) {
+            return 1.0;
+        }
+        return static_cast<double>(tick_end - tick_start) / static_cast<double>(wall_ns);
+#else
+        return 1.0;
+#endif
+    }
+};
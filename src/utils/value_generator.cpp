@@ -0,0 +1,244 @@
+#include "value_generator.hpp"
+#include "hash_utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using utils::fmix64;
+
+namespace {
+
+constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+
+// 长度和内容使用不同的hash，避免长度与内容相关
+uint64_t size_hash(uint64_t index) {
+    return fmix64(index ^ 0x5851F42D4C957F2DULL);
+}
+
+// 以id为种子填充n个随机字节，第一个8字节就是id本身
+void fill_random(char* out, size_t n, uint64_t id) {
+    for (size_t offset = 0, word = 0; offset < n; offset += 8, ++word) {
+        uint64_t bits = word == 0 ? id : fmix64(id + word * kGolden);
+        std::memcpy(out + offset, &bits, std::min<size_t>(8, n - offset));
+    }
+}
+
+std::string format_ratio(double ratio) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << ratio;
+    return oss.str();
+}
+
+}  // namespace
+
+std::string FixedValueSize::describe() const {
+    return "fixed " + std::to_string(size_) + " B";
+}
+
+size_t UniformValueSize::size_for(uint64_t hash) const {
+    return min_size_ + static_cast<size_t>(hash % (max_size_ - min_size_ + 1));
+}
+
+std::string UniformValueSize::describe() const {
+    return "uniform [" + std::to_string(min_size_) + ", " + std::to_string(max_size_) + "] B";
+}
+
+size_t LogNormalValueSize::size_for(uint64_t hash) const {
+    // Box-Muller：高32位和低32位各作一个均匀数，u1取(0, 1)避免log(0)
+    double u1 = (static_cast<double>(hash >> 32) + 0.5) / 4294967296.0;
+    double u2 = static_cast<double>(hash & 0xFFFFFFFFULL) / 4294967296.0;
+    double z = std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+    double size = std::round(median_ * std::exp(sigma_ * z));
+    return static_cast<size_t>(std::clamp(size, static_cast<double>(min_size_), static_cast<double>(max_size_)));
+}
+
+std::string LogNormalValueSize::describe() const {
+    return "lognormal median " + std::to_string(static_cast<size_t>(median_)) + " B, sigma " +
+           format_ratio(sigma_) + ", [" + std::to_string(min_size_) + ", " + std::to_string(max_size_) + "] B";
+}
+
+EmpiricalValueSize::EmpiricalValueSize(std::vector<std::pair<size_t, double>> buckets) {
+    double total = 0.0;
+    for (const auto& [size, weight] : buckets) {
+        if (weight < 0) {
+            throw std::invalid_argument("Value size histogram weights must not be negative");
+        }
+        total += weight;
+    }
+    if (buckets.empty() || total <= 0) {
+        throw std::invalid_argument("Value size histogram needs at least one bucket with positive weight");
+    }
+    double running = 0.0;
+    for (const auto& [size, weight] : buckets) {
+        if (weight == 0) {
+            continue;
+        }
+        running += weight;
+        sizes_.push_back(size);
+        cumulative_.push_back(running / total);
+    }
+    cumulative_.back() = 1.0;
+}
+
+size_t EmpiricalValueSize::size_for(uint64_t hash) const {
+    double u = static_cast<double>(hash >> 11) * 0x1p-53;
+    size_t bucket = std::upper_bound(cumulative_.begin(), cumulative_.end(), u) - cumulative_.begin();
+    return sizes_[std::min(bucket, sizes_.size() - 1)];
+}
+
+std::string EmpiricalValueSize::describe() const {
+    auto [min_it, max_it] = std::minmax_element(sizes_.begin(), sizes_.end());
+    return "empirical " + std::to_string(sizes_.size()) + " sizes in [" + std::to_string(*min_it) + ", " +
+           std::to_string(*max_it) + "] B";
+}
+
+std::vector<std::pair<size_t, double>> load_value_size_histogram(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open value size histogram: " + path);
+    }
+    std::vector<std::pair<size_t, double>> buckets;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+        std::replace(line.begin(), line.end(), ',', ' ');
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;   // 空行或注释
+        }
+        std::istringstream entry(line);
+        long long size = 0;
+        double weight = 0.0;
+        std::string extra;
+        if (!(entry >> size >> weight) || (entry >> extra) || size < 0) {
+            throw std::runtime_error("Malformed value size histogram line " + std::to_string(line_number) +
+                                     " in " + path + " (expected \"size weight\")");
+        }
+        buckets.emplace_back(static_cast<size_t>(size), weight);
+    }
+    return buckets;
+}
+
+ValueGenerator::ValueGenerator(std::unique_ptr<ValueSizeDistribution> sizes, ValueContent content, double zero_ratio)
+    : sizes_(std::move(sizes)), content_(content), zero_ratio_(zero_ratio) {}
+
+size_t ValueGenerator::size_for(uint64_t index) const {
+    return sizes_->size_for(size_hash(index));
+}
+
+void ValueGenerator::fill(uint64_t index, std::string& value) const {
+    size_t size = size_for(index);
+    value.resize(size);
+    char* out = value.data();
+    uint64_t id = fmix64(index + kGolden);
+
+    switch (content_) {
+    case ValueContent::kRandom:
+        fill_random(out, size, id);
+        break;
+    case ValueContent::kPattern: {
+        char unit[16];
+        fill_random(unit, sizeof(unit), id);
+        for (size_t offset = 0; offset < size; offset += sizeof(unit)) {
+            std::memcpy(out + offset, unit, std::min(sizeof(unit), size - offset));
+        }
+        break;
+    }
+    case ValueContent::kZeros: {
+        // 至少保留8个非零字节放id，保证value唯一
+        size_t tail = std::max(size - static_cast<size_t>(size * zero_ratio_), std::min<size_t>(8, size));
+        size_t zeros = size - tail;
+        std::memset(out, 0, zeros);
+        fill_random(out + zeros, tail, fmix64(id));
+        size_t id_bytes = std::min<size_t>(8, tail);
+        std::memcpy(out + size - id_bytes, &id, id_bytes);
+        break;
+    }
+    }
+}
+
+double ValueGenerator::estimated_mean_size(size_t samples) const {
+    if (samples == 0) {
+        return 0.0;
+    }
+    double total = 0.0;
+    for (size_t i = 0; i < samples; ++i) {
+        total += static_cast<double>(size_for(i));
+    }
+    return total / static_cast<double>(samples);
+}
+
+std::string ValueGenerator::describe() const {
+    std::string content;
+    switch (content_) {
+    case ValueContent::kRandom:
+        content = "random";
+        break;
+    case ValueContent::kPattern:
+        content = "repeated 16-byte pattern";
+        break;
+    case ValueContent::kZeros:
+        content = "zeros (" + std::to_string(static_cast<int>(std::round(zero_ratio_ * 100.0))) +
+                  "% leading zero bytes)";
+        break;
+    }
+    return sizes_->describe() + ", " + content;
+}
+
+const std::vector<std::string>& value_size_distribution_names() {
+    static const std::vector<std::string> names = {"fixed", "uniform", "lognormal", "empirical"};
+    return names;
+}
+
+const std::vector<std::string>& value_content_names() {
+    static const std::vector<std::string> names = {"random", "pattern", "zeros"};
+    return names;
+}
+
+std::unique_ptr<ValueGenerator> make_value_generator(const ValueGeneratorParams& params) {
+    ValueContent content;
+    if (params.content == "random") {
+        content = ValueContent::kRandom;
+    } else if (params.content == "pattern") {
+        content = ValueContent::kPattern;
+    } else if (params.content == "zeros") {
+        content = ValueContent::kZeros;
+    } else {
+        throw std::invalid_argument("Unknown value content: " + params.content);
+    }
+    if (params.zero_ratio < 0 || params.zero_ratio > 1) {
+        throw std::invalid_argument("Value zero ratio must be in [0, 1]");
+    }
+
+    std::unique_ptr<ValueSizeDistribution> sizes;
+    const std::string& name = params.size_distribution;
+    if (name == "fixed") {
+        sizes = std::make_unique<FixedValueSize>(params.size);
+    } else if (name == "uniform" || name == "lognormal") {
+        if (params.min_size > params.max_size) {
+            throw std::invalid_argument("Value min size must not exceed max size");
+        }
+        if (name == "uniform") {
+            sizes = std::make_unique<UniformValueSize>(params.min_size, params.max_size);
+        } else {
+            if (params.size == 0 || params.sigma <= 0) {
+                throw std::invalid_argument("Lognormal value sizes need a positive median and sigma");
+            }
+            sizes = std::make_unique<LogNormalValueSize>(static_cast<double>(params.size), params.sigma,
+                                                         params.min_size, params.max_size);
+        }
+    } else if (name == "empirical") {
+        if (params.histogram_file.empty()) {
+            throw std::invalid_argument("Empirical value sizes need a histogram file");
+        }
+        sizes = std::make_unique<EmpiricalValueSize>(load_value_size_histogram(params.histogram_file));
+    } else {
+        throw std::invalid_argument("Unknown value size distribution: " + name);
+    }
+    return std::make_unique<ValueGenerator>(std::move(sizes), content, params.zero_ratio);
+}
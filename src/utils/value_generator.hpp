@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// value长度分布 - 由value索引的64位hash确定长度，同一索引总是得到同一长度。实现只读，可被多个写线程共享
+class ValueSizeDistribution {
+public:
+    virtual ~ValueSizeDistribution() = default;
+    virtual size_t size_for(uint64_t hash) const = 0;
+    virtual std::string describe() const = 0;
+};
+
+// 固定长度（原有行为：32字节）
+class FixedValueSize : public ValueSizeDistribution {
+public:
+    explicit FixedValueSize(size_t size) : size_(size) {}
+    size_t size_for(uint64_t) const override { return size_; }
+    std::string describe() const override;
+
+private:
+    size_t size_;
+};
+
+// [min_size, max_size]均匀
+class UniformValueSize : public ValueSizeDistribution {
+public:
+    UniformValueSize(size_t min_size, size_t max_size) : min_size_(min_size), max_size_(max_size) {}
+    size_t size_for(uint64_t hash) const override;
+    std::string describe() const override;
+
+private:
+    size_t min_size_;
+    size_t max_size_;
+};
+
+// 对数正态：中位数median，ln(size)的标准差sigma，截断到[min_size, max_size]。大多数value很小、少数很大
+class LogNormalValueSize : public ValueSizeDistribution {
+public:
+    LogNormalValueSize(double median, double sigma, size_t min_size, size_t max_size)
+        : median_(median), sigma_(sigma), min_size_(min_size), max_size_(max_size) {}
+    size_t size_for(uint64_t hash) const override;
+    std::string describe() const override;
+
+private:
+    double median_;
+    double sigma_;
+    size_t min_size_;
+    size_t max_size_;
+};
+
+// 经验直方图：(长度, 权重)列表，按权重比例抽取长度
+class EmpiricalValueSize : public ValueSizeDistribution {
+public:
+    explicit EmpiricalValueSize(std::vector<std::pair<size_t, double>> buckets);
+    size_t size_for(uint64_t hash) const override;
+    std::string describe() const override;
+
+private:
+    std::vector<size_t> sizes_;
+    std::vector<double> cumulative_;   // 归一化的累积权重，最后一项为1
+};
+
+// 直方图文件：每行"长度 权重"（空白或逗号分隔），'#'开头为注释。无法读取或格式错误时抛出std::runtime_error
+std::vector<std::pair<size_t, double>> load_value_size_histogram(const std::string& path);
+
+// value内容的可压缩性
+enum class ValueContent {
+    kRandom,    // 全部随机字节，不可压缩（原有行为）
+    kPattern,   // 16字节随机单元重复填满，压缩率约为长度/16
+    kZeros,     // 前zero_ratio的字节为0、其余随机，类似左侧补零的存储字（小整数、地址）
+};
+
+struct ValueGeneratorParams {
+    std::string size_distribution = "fixed";   // fixed, uniform, lognormal, empirical
+    size_t size = 32;                          // fixed的长度，lognormal的中位数
+    size_t min_size = 8;                       // uniform的范围，lognormal的截断范围
+    size_t max_size = 128;
+    double sigma = 1.0;                        // lognormal：ln(size)的标准差
+    std::string histogram_file;                // empirical：直方图文件
+    std::string content = "random";            // random, pattern, zeros
+    double zero_ratio = 0.75;                  // zeros：前导零字节占比
+};
+
+// 按value的全局唯一索引确定性地生成value：长度和内容都只取决于索引，线程安全。
+// 长度>=8时value中包含索引的64位双射hash，不同索引的value必然不同
+class ValueGenerator {
+public:
+    ValueGenerator(std::unique_ptr<ValueSizeDistribution> sizes, ValueContent content, double zero_ratio);
+
+    void fill(uint64_t index, std::string& value) const;
+    size_t size_for(uint64_t index) const;
+
+    // 对前samples个索引取平均，用于日志
+    double estimated_mean_size(size_t samples = 65536) const;
+    std::string describe() const;
+
+private:
+    std::unique_ptr<ValueSizeDistribution> sizes_;
+    ValueContent content_;
+    double zero_ratio_;
+};
+
+const std::vector<std::string>& value_size_distribution_names();
+const std::vector<std::string>& value_content_names();
+
+// 参数非法时抛出std::invalid_argument，直方图文件无法读取时抛出std::runtime_error
+std::unique_ptr<ValueGenerator> make_value_generator(const ValueGeneratorParams& params);
@@ -0,0 +1,131 @@
+#include "version_distribution.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+uint64_t uniform_block(std::mt19937& rng, uint64_t first, uint64_t last) {
+    return std::uniform_int_distribution<uint64_t>(first, last)(rng);
+}
+
+std::unique_ptr<VersionDistribution> make_single(const std::string& name, const VersionDistributionParams& params) {
+    if (name == "uniform") {
+        return std::make_unique<UniformVersionDistribution>();
+    }
+    if (name == "uniform_all") {
+        return std::make_unique<UniformAllVersionDistribution>();
+    }
+    if (name == "recent") {
+        return std::make_unique<RecentVersionDistribution>(params.recent_window);
+    }
+    if (name == "exponential") {
+        if (params.decay_mean_blocks <= 0.0) {
+            throw std::invalid_argument("Version decay mean must be positive");
+        }
+        return std::make_unique<ExponentialVersionDistribution>(params.decay_mean_blocks);
+    }
+    throw std::invalid_argument("Unknown version distribution: " + name);
+}
+
+}  // namespace
+
+uint64_t UniformVersionDistribution::next(std::mt19937& rng, const VersionSpan& span) const {
+    // 写线程尚未发布任何新block时，退回到initial load的最后一个block
+    return uniform_block(rng, std::min(span.test_start, span.head), span.head);
+}
+
+uint64_t UniformAllVersionDistribution::next(std::mt19937& rng, const VersionSpan& span) const {
+    return uniform_block(rng, 0, span.head);
+}
+
+uint64_t RecentVersionDistribution::next(std::mt19937& rng, const VersionSpan& span) const {
+    uint64_t first = span.head >= window_ ? span.head - window_ + 1 : 0;
+    return uniform_block(rng, first, span.head);
+}
+
+uint64_t ExponentialVersionDistribution::next(std::mt19937& rng, const VersionSpan& span) const {
+    double age = std::exponential_distribution<double>(1.0 / mean_blocks_)(rng);
+    if (age >= static_cast<double>(span.head)) {
+        return 0;
+    }
+    return span.head - static_cast<uint64_t>(age);
+}
+
+void MixtureVersionDistribution::add(std::unique_ptr<VersionDistribution> component, double weight) {
+    components_.push_back(std::move(component));
+    weights_.push_back(weight);
+    cumulative_.push_back((cumulative_.empty() ? 0.0 : cumulative_.back()) + weight);
+}
+
+uint64_t MixtureVersionDistribution::next(std::mt19937& rng, const VersionSpan& span) const {
+    double pick = std::uniform_real_distribution<double>(0.0, cumulative_.back())(rng);
+    size_t i = std::upper_bound(cumulative_.begin(), cumulative_.end(), pick) - cumulative_.begin();
+    return components_[std::min(i, components_.size() - 1)]->next(rng, span);
+}
+
+std::string MixtureVersionDistribution::name() const {
+    std::ostringstream out;
+    for (size_t i = 0; i < components_.size(); ++i) {
+        out << (i > 0 ? "," : "") << components_[i]->name() << ":" << weights_[i];
+    }
+    return out.str();
+}
+
+std::unique_ptr<VersionDistribution> make_version_distribution(const std::string& spec,
+                                                               const VersionDistributionParams& params) {
+    if (spec.find(',') == std::string::npos && spec.find(':') == std::string::npos) {
+        return make_single(spec, params);
+    }
+
+    auto mixture = std::make_unique<MixtureVersionDistribution>();
+    size_t begin = 0;
+    while (begin <= spec.size()) {
+        size_t end = std::min(spec.find(',', begin), spec.size());
+        std::string item = spec.substr(begin, end - begin);
+        begin = end + 1;
+        auto colon = item.find(':');
+        std::string name = item.substr(0, colon);
+        double weight = 1.0;
+        if (colon != std::string::npos) {
+            try {
+                size_t parsed = 0;
+                weight = std::stod(item.substr(colon + 1), &parsed);
+                if (parsed != item.size() - colon - 1) {
+                    throw std::invalid_argument(item);
+                }
+            } catch (const std::exception&) {
+                throw std::invalid_argument("Invalid version distribution weight: " + item);
+            }
+        }
+        if (!(weight > 0.0)) {
+            throw std::invalid_argument("Version distribution weight must be positive: " + item);
+        }
+        mixture->add(make_single(name, params), weight);
+    }
+    return mixture;
+}
+
+size_t version_age_bucket(uint64_t age_blocks) {
+    if (age_blocks < 16) {
+        return 0;
+    }
+    if (age_blocks < 128) {
+        return 1;
+    }
+    if (age_blocks < 1024) {
+        return 2;
+    }
+    if (age_blocks < 16384) {
+        return 3;
+    }
+    return 4;
+}
+
+const std::array<std::string, kVersionAgeBucketCount>& version_age_bucket_labels() {
+    static const std::array<std::string, kVersionAgeBucketCount> labels = {
+        "0-15", "16-127", "128-1023", "1024-16383", "16384+",
+    };
+    return labels;
+}
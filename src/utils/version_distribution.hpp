@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// 查询目标版本的可选范围：head是当前已发布的最大block，test_start是initial load之后的第一个block
+struct VersionSpan {
+    uint64_t head = 0;
+    uint64_t test_start = 0;
+};
+
+// 查询目标版本分布 - 返回[0, head]中的block号。实现只读，可被多个读线程共享
+class VersionDistribution {
+public:
+    virtual ~VersionDistribution() = default;
+    virtual uint64_t next(std::mt19937& rng, const VersionSpan& span) const = 0;
+    virtual std::string name() const = 0;
+};
+
+struct VersionDistributionParams {
+    uint64_t recent_window = 128;        // recent：只查最近N个block
+    double decay_mean_blocks = 128.0;    // exponential：距head的block数服从该均值的指数分布
+};
+
+// uniform：[min(test_start, head), head]均匀（原有行为，只覆盖测试期间写入的版本）
+class UniformVersionDistribution : public VersionDistribution {
+public:
+    uint64_t next(std::mt19937& rng, const VersionSpan& span) const override;
+    std::string name() const override { return "uniform"; }
+};
+
+// uniform_all：[0, head]均匀，包括initial load的block
+class UniformAllVersionDistribution : public VersionDistribution {
+public:
+    uint64_t next(std::mt19937& rng, const VersionSpan& span) const override;
+    std::string name() const override { return "uniform_all"; }
+};
+
+// recent：[head - window + 1, head]均匀
+class RecentVersionDistribution : public VersionDistribution {
+public:
+    explicit RecentVersionDistribution(uint64_t window) : window_(window > 0 ? window : 1) {}
+    uint64_t next(std::mt19937& rng, const VersionSpan& span) const override;
+    std::string name() const override { return "recent"; }
+
+private:
+    uint64_t window_;
+};
+
+// exponential：距head的block数服从指数分布，超出历史时截断到block 0
+class ExponentialVersionDistribution : public VersionDistribution {
+public:
+    explicit ExponentialVersionDistribution(double mean_blocks) : mean_blocks_(mean_blocks) {}
+    uint64_t next(std::mt19937& rng, const VersionSpan& span) const override;
+    std::string name() const override { return "exponential"; }
+
+private:
+    double mean_blocks_;
+};
+
+// 按权重混合多个分布，例如"exponential:0.95,uniform_all:0.05"
+class MixtureVersionDistribution : public VersionDistribution {
+public:
+    void add(std::unique_ptr<VersionDistribution> component, double weight);
+    uint64_t next(std::mt19937& rng, const VersionSpan& span) const override;
+    std::string name() const override;
+
+private:
+    std::vector<std::unique_ptr<VersionDistribution>> components_;
+    std::vector<double> weights_;
+    std::vector<double> cumulative_;
+};
+
+// 单个分布名称（uniform, uniform_all, recent, exponential）或逗号分隔的"名称:权重"混合。
+// 格式错误或名称未知时抛出std::invalid_argument
+std::unique_ptr<VersionDistribution> make_version_distribution(const std::string& spec,
+                                                               const VersionDistributionParams& params);
+
+// 按版本年龄（head - target，单位block）分桶报告查询延迟
+constexpr size_t kVersionAgeBucketCount = 5;
+size_t version_age_bucket(uint64_t age_blocks);
+const std::array<std::string, kVersionAgeBucketCount>& version_age_bucket_labels();
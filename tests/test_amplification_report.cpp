@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "benchmark/amplification_report.hpp"
+
+namespace {
+
+StrategyDBManager::DBRuntimeSample db_sample(const std::string& name, uint64_t written, uint64_t sst) {
+    StrategyDBManager::DBRuntimeSample sample;
+    sample.name = name;
+    sample.bytes_written = written;
+    sample.live_sst_bytes = sst;
+    return sample;
+}
+
+}  // namespace
+
+TEST(AmplificationReportTest, WriteAndSpaceAmplificationPerDbAndTotal) {
+    auto range = db_sample("range_index", 1000, 500);
+    range.wal_bytes = 1000;
+    range.flush_write_bytes = 600;
+    range.compact_write_bytes = 400;
+    auto data = db_sample("data_storage", 4000, 3000);
+    data.wal_bytes = 4000;
+    data.flush_write_bytes = 3000;
+    data.compact_write_bytes = 9000;
+    data.live_blob_bytes = 1000;
+
+    AmplificationReport report({range, data}, {}, 4000, 0);
+    ASSERT_EQ(report.dbs().size(), 2u);
+    EXPECT_DOUBLE_EQ(report.dbs()[0].write_amplification(), 2.0);
+    EXPECT_DOUBLE_EQ(report.dbs()[0].space_amplification(), 0.5);
+    EXPECT_DOUBLE_EQ(report.dbs()[1].write_amplification(), 4.0);
+    EXPECT_DOUBLE_EQ(report.dbs()[1].space_amplification(), 1.0);
+
+    // 跨DB合计相对应用层逻辑字节：range index的写入也计入放大
+    EXPECT_DOUBLE_EQ(report.write_amplification(), 18000.0 / 4000.0);
+    EXPECT_DOUBLE_EQ(report.space_amplification(), 4500.0 / 4000.0);
+}
+
+TEST(AmplificationReportTest, UnusedDbIsSkipped) {
+    AmplificationReport report({db_sample("main", 0, 0), db_sample("data_storage", 100, 80)}, {}, 100, 0);
+    ASSERT_EQ(report.dbs().size(), 1u);
+    EXPECT_EQ(report.dbs()[0].name, "data_storage");
+}
+
+TEST(AmplificationReportTest, ReadBytesAreDeltasAgainstBaseline) {
+    auto before = db_sample("data_storage", 100, 80);
+    before.file_read_bytes = 5000;
+    before.logical_read_bytes = 700;
+    auto after = before;
+    after.file_read_bytes = 45000;
+    after.logical_read_bytes = 1700;
+
+    AmplificationReport report({after}, {before}, 100, 10);
+    EXPECT_EQ(report.dbs()[0].file_read_bytes, 40000u);
+    EXPECT_DOUBLE_EQ(report.file_read_bytes_per_query(), 4000.0);
+    EXPECT_DOUBLE_EQ(report.logical_read_bytes_per_query(), 100.0);
+
+    auto json = report.to_json();
+    EXPECT_EQ(json["queries"], 10);
+    EXPECT_FALSE(json.contains("sampled_io_bytes_per_query"));
+    report.set_sampled_io_bytes_per_query(4096.0);
+    EXPECT_DOUBLE_EQ(report.to_json()["sampled_io_bytes_per_query"].get<double>(), 4096.0);
+}
+
+TEST(AmplificationReportTest, ZeroDenominatorsReportZero) {
+    AmplificationReport report({}, {}, 0, 0);
+    EXPECT_DOUBLE_EQ(report.write_amplification(), 0.0);
+    EXPECT_DOUBLE_EQ(report.space_amplification(), 0.0);
+    EXPECT_DOUBLE_EQ(report.file_read_bytes_per_query(), 0.0);
+}
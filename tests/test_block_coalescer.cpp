@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../src/utils/block_coalescer.hpp"
+
+namespace {
+
+struct TestRecord {
+    uint64_t block_num;
+    std::string addr_slot;
+    std::string value;
+};
+
+}  // namespace
+
+// 测试重复key只保留最后一次写入，且保持首次出现的顺序
+TEST(BlockCoalescerTest, KeepsLastWritePerKey) {
+    BlockCoalescer coalescer;
+    std::vector<TestRecord> records = {
+        {1, "a", "a1"}, {1, "b", "b1"}, {1, "a", "a2"}, {1, "c", "c1"}, {1, "b", "b2"}, {1, "a", "a3"},
+    };
+
+    EXPECT_EQ(coalescer.coalesce(records), 3u);
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].addr_slot, "a");
+    EXPECT_EQ(records[0].value, "a3");
+    EXPECT_EQ(records[1].addr_slot, "b");
+    EXPECT_EQ(records[1].value, "b2");
+    EXPECT_EQ(records[2].addr_slot, "c");
+    EXPECT_EQ(records[2].value, "c1");
+}
+
+// 测试没有重复时不改变记录
+TEST(BlockCoalescerTest, NoDuplicatesIsNoop) {
+    BlockCoalescer coalescer;
+    std::vector<TestRecord> records;
+    for (int i = 0; i < 100; ++i) {
+        records.push_back({7, "key" + std::to_string(i), "v" + std::to_string(i)});
+    }
+    EXPECT_EQ(coalescer.coalesce(records), 0u);
+    ASSERT_EQ(records.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(records[i].addr_slot, "key" + std::to_string(i));
+    }
+}
+
+// 测试实例跨block复用：结果与参考实现一致，且不会保留上一个block的状态
+TEST(BlockCoalescerTest, ReuseAcrossBlocksMatchesReference) {
+    BlockCoalescer coalescer;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> key_dist(0, 499);
+
+    for (int block = 0; block < 20; ++block) {
+        std::vector<TestRecord> records;
+        std::unordered_map<std::string, std::string> expected;
+        for (int i = 0; i < 1000; ++i) {
+            std::string key = "k" + std::to_string(key_dist(rng));
+            std::string value = std::to_string(block) + ":" + std::to_string(i);
+            expected[key] = value;
+            records.push_back({static_cast<uint64_t>(block), key, value});
+        }
+
+        size_t duplicates = coalescer.coalesce(records);
+        EXPECT_EQ(records.size(), expected.size());
+        EXPECT_EQ(duplicates, 1000u - expected.size());
+        for (const auto& record : records) {
+            EXPECT_EQ(record.value, expected[record.addr_slot]);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../src/utils/bounded_queue.hpp"
+
+// 测试FIFO顺序
+TEST(BoundedQueueTest, PopsInPushOrder) {
+    BoundedQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    for (int i = 0; i < 4; ++i) {
+        auto item = queue.pop();
+        ASSERT_TRUE(item.has_value());
+        EXPECT_EQ(*item, i);
+    }
+}
+
+// 测试close后剩余元素仍可取出，取空后返回nullopt，push失败
+TEST(BoundedQueueTest, CloseDrainsRemainingItems) {
+    BoundedQueue<int> queue(2);
+    queue.push(7);
+    queue.close();
+    EXPECT_FALSE(queue.push(8));
+    auto item = queue.pop();
+    ASSERT_TRUE(item.has_value());
+    EXPECT_EQ(*item, 7);
+    EXPECT_FALSE(queue.pop().has_value());
+}
+
+// 测试多生产者单消费者：所有元素恰好被消费一次，队列长度不超过容量
+TEST(BoundedQueueTest, MultipleProducersSingleConsumer) {
+    constexpr int kProducers = 4;
+    constexpr int kItemsPerProducer = 1000;
+    BoundedQueue<int> queue(3);
+    std::atomic<int> remaining{kProducers};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kItemsPerProducer; ++i) {
+                queue.push(p * kItemsPerProducer + i);
+            }
+            if (--remaining == 0) {
+                queue.close();
+            }
+        });
+    }
+
+    std::vector<int> seen(kProducers * kItemsPerProducer, 0);
+    while (auto item = queue.pop()) {
+        EXPECT_LE(queue.size(), queue.capacity());
+        seen[*item]++;
+    }
+    for (auto& thread : producers) {
+        thread.join();
+    }
+    for (int count : seen) {
+        EXPECT_EQ(count, 1);
+    }
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "../src/strategies/commit_pipeline.hpp"
+
+namespace {
+
+struct TestBuffer {
+    std::vector<int> items;
+};
+
+}  // namespace
+
+// 测试提交顺序与提交内容
+TEST(CommitPipelineTest, CommitsBuffersInSubmitOrder) {
+    std::vector<int> committed;
+    CommitPipeline<TestBuffer> pipeline(
+        "test", 2,
+        [&committed](TestBuffer& buffer) {
+            committed.insert(committed.end(), buffer.items.begin(), buffer.items.end());
+            return true;
+        },
+        [](TestBuffer& buffer) { buffer.items.clear(); });
+
+    for (int i = 0; i < 100; ++i) {
+        pipeline.active().items.push_back(i);
+        if (i % 10 == 9) {
+            pipeline.submit();
+        }
+    }
+    pipeline.drain();
+
+    ASSERT_EQ(committed.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(committed[i], i);
+    }
+    auto stats = pipeline.get_stats();
+    EXPECT_EQ(stats.buffers_committed, 10u);
+    EXPECT_EQ(stats.commit_failures, 0u);
+    EXPECT_FALSE(pipeline.has_failed());
+}
+
+// 测试背压：提交线程慢时生产者被阻塞，且阻塞时间被统计
+TEST(CommitPipelineTest, ProducerBlocksWhenAllBuffersInFlight) {
+    std::atomic<int> in_flight{0};
+    std::atomic<int> max_in_flight{0};
+    CommitPipeline<TestBuffer> pipeline(
+        "test", 2,
+        [&](TestBuffer&) {
+            int now = ++in_flight;
+            int prev = max_in_flight.load();
+            while (now > prev && !max_in_flight.compare_exchange_weak(prev, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            --in_flight;
+            return true;
+        },
+        [](TestBuffer& buffer) { buffer.items.clear(); });
+
+    for (int i = 0; i < 5; ++i) {
+        pipeline.active().items.push_back(i);
+        pipeline.submit();
+    }
+    pipeline.drain();
+
+    auto stats = pipeline.get_stats();
+    EXPECT_EQ(stats.buffers_committed, 5u);
+    EXPECT_EQ(max_in_flight.load(), 1);  // 单提交线程
+    EXPECT_GT(stats.producer_blocked_ms, 0.0);
+    EXPECT_GT(stats.committer_busy_ms, 0.0);
+    EXPECT_LE(stats.committer_utilization(), 1.0 + 1e-6);
+}
+
+// 测试单buffer退化为同步写入
+TEST(CommitPipelineTest, SingleBufferIsSynchronous) {
+    int committed = 0;
+    CommitPipeline<TestBuffer> pipeline(
+        "test", 1,
+        [&committed](TestBuffer& buffer) {
+            committed += static_cast<int>(buffer.items.size());
+            return true;
+        },
+        [](TestBuffer& buffer) { buffer.items.clear(); });
+
+    pipeline.active().items = {1, 2, 3};
+    pipeline.submit();
+    // submit返回时唯一的buffer已经写完并被清空
+    EXPECT_EQ(committed, 3);
+    EXPECT_TRUE(pipeline.active().items.empty());
+}
+
+// 测试写入失败被记录
+TEST(CommitPipelineTest, ReportsCommitFailures) {
+    CommitPipeline<TestBuffer> pipeline(
+        "test", 2,
+        [](TestBuffer& buffer) { return buffer.items.empty(); },
+        [](TestBuffer& buffer) { buffer.items.clear(); });
+
+    pipeline.active().items.push_back(1);
+    pipeline.submit();
+    pipeline.drain();
+
+    EXPECT_TRUE(pipeline.has_failed());
+    EXPECT_EQ(pipeline.get_stats().commit_failures, 1u);
+}
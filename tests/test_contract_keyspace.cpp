@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "utils/contract_keyspace.hpp"
+#include "utils/data_generator.hpp"
+#include <regex>
+#include <unordered_set>
+
+namespace {
+
+ContractKeyspace::Config keyspace_config(size_t total_keys, double alpha, uint64_t seed = 0) {
+    ContractKeyspace::Config config;
+    config.total_keys = total_keys;
+    config.slot_alpha = alpha;
+    config.seed = seed;
+    return config;
+}
+
+}  // namespace
+
+TEST(ContractKeyspaceTest, ContractsPartitionTheKeyspace) {
+    ContractKeyspace keyspace(keyspace_config(100000, 1.0));
+    ASSERT_GT(keyspace.contract_count(), 1u);
+    size_t total = 0;
+    for (size_t c = 0; c < keyspace.contract_count(); ++c) {
+        EXPECT_EQ(keyspace.contract_start(c), total);
+        EXPECT_GE(keyspace.contract_slots(c), 1u);
+        EXPECT_LE(keyspace.contract_slots(c), 100000u / 20);
+        total += keyspace.contract_slots(c);
+    }
+    EXPECT_EQ(total, 100000u);
+
+    for (size_t c : {size_t{0}, keyspace.contract_count() / 2, keyspace.contract_count() - 1}) {
+        size_t start = keyspace.contract_start(c);
+        EXPECT_EQ(keyspace.contract_of(start), c);
+        EXPECT_EQ(keyspace.contract_of(start + keyspace.contract_slots(c) - 1), c);
+    }
+}
+
+TEST(ContractKeyspaceTest, SlotCountsFollowPowerLaw) {
+    ContractKeyspace keyspace(keyspace_config(1000000, 1.0));
+    size_t single = 0;
+    for (size_t c = 0; c < keyspace.contract_count(); ++c) {
+        single += keyspace.contract_slots(c) == 1 ? 1 : 0;
+    }
+    // Pareto(α=1)：P(slots=1) = 1/2，长尾中有远大于平均值的大合约
+    EXPECT_NEAR(static_cast<double>(single) / keyspace.contract_count(), 0.5, 0.02);
+    double mean = 1000000.0 / keyspace.contract_count();
+    EXPECT_GT(keyspace.largest_contract_slots(), mean * 100);
+
+    // α越大，大合约越少
+    ContractKeyspace steep(keyspace_config(1000000, 2.0));
+    EXPECT_GT(steep.contract_count(), keyspace.contract_count());
+}
+
+TEST(ContractKeyspaceTest, KeysShareAddressWithinContractAndAreUnique) {
+    ContractKeyspace keyspace(keyspace_config(50000, 1.0, 3));
+    const std::regex format("0x[0-9a-f]{40}#0x[0-9a-f]{64}");
+    std::unordered_set<std::string> keys;
+    std::unordered_set<std::string> addresses;
+    std::string key;
+    for (size_t i = 0; i < 50000; ++i) {
+        keyspace.fill_key(i, key);
+        ASSERT_TRUE(std::regex_match(key, format)) << key;
+        EXPECT_TRUE(keys.insert(key).second) << "duplicate key at index " << i;
+        addresses.insert(key.substr(0, 42));
+    }
+    EXPECT_EQ(addresses.size(), keyspace.contract_count());
+
+    // 同一合约的key地址前缀相同
+    size_t big = 0;
+    for (size_t c = 0; c < keyspace.contract_count(); ++c) {
+        if (keyspace.contract_slots(c) > keyspace.contract_slots(big)) {
+            big = c;
+        }
+    }
+    std::string first;
+    std::string last;
+    keyspace.fill_key(keyspace.contract_start(big), first);
+    keyspace.fill_key(keyspace.contract_start(big) + keyspace.contract_slots(big) - 1, last);
+    EXPECT_EQ(first.substr(0, 42), last.substr(0, 42));
+    EXPECT_NE(first, last);
+}
+
+TEST(ContractKeyspaceTest, DistributionPicksContractThenSlot) {
+    ContractKeyspace keyspace(keyspace_config(100000, 1.0));
+    // 所有访问都落在合约0（tiered的热点段只有合约0）
+    ContractKeyDistribution distribution(std::make_unique<TieredKeyDistribution>(keyspace.contract_count(), 1, 0),
+                                         keyspace);
+    std::mt19937 rng(1);
+    std::vector<size_t> indices;
+    distribution.fill(1000, rng, indices);
+    size_t in_first = 0;
+    for (size_t index : indices) {
+        ASSERT_LT(index, 100000u);
+        in_first += keyspace.contract_of(index) == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(in_first, 800u);
+    EXPECT_EQ(distribution.name(), "contract+tiered");
+}
+
+TEST(ContractKeyspaceTest, DataGeneratorContractMode) {
+    DataGenerator::Config config;
+    config.total_keys = 20000;
+    config.hotspot_count = 2000;
+    config.medium_count = 4000;
+    config.tail_count = 14000;
+    config.contract_keys = true;
+    DataGenerator generator(config);
+    ASSERT_NE(generator.contract_keyspace(), nullptr);
+    EXPECT_TRUE(generator.derived_keys());
+    EXPECT_TRUE(generator.get_all_keys().empty());
+    EXPECT_EQ(generator.key_count(), 20000u);
+    EXPECT_EQ(generator.key_table_bytes(), generator.contract_keyspace()->memory_bytes());
+
+    std::string expected;
+    generator.contract_keyspace()->fill_key(123, expected);
+    EXPECT_EQ(generator.key_at(123), expected);
+}
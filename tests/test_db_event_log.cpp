@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "core/db_event_log.hpp"
+#include "utils/latency_timeline.hpp"
+
+namespace {
+
+rocksdb::WriteStallInfo stall_info(rocksdb::WriteStallCondition prev, rocksdb::WriteStallCondition cur) {
+    rocksdb::WriteStallInfo info;
+    info.cf_name = "default";
+    info.condition.prev = prev;
+    info.condition.cur = cur;
+    return info;
+}
+
+}  // namespace
+
+TEST(DBEventLogTest, StallWindowOpensEscalatesAndCloses) {
+    auto log = std::make_shared<DBEventLog>();
+    DBEventListener listener("data_storage", log);
+
+    listener.OnStallConditionsChanged(stall_info(rocksdb::WriteStallCondition::kNormal,
+                                                 rocksdb::WriteStallCondition::kDelayed));
+    listener.OnStallConditionsChanged(stall_info(rocksdb::WriteStallCondition::kDelayed,
+                                                 rocksdb::WriteStallCondition::kStopped));
+
+    auto open_windows = log->stall_windows(DBEventLog::now_ns());
+    ASSERT_EQ(open_windows.size(), 1u);
+    EXPECT_TRUE(open_windows[0].open);
+    EXPECT_EQ(open_windows[0].condition, "stopped");
+    EXPECT_EQ(open_windows[0].db_name, "data_storage");
+
+    listener.OnStallConditionsChanged(stall_info(rocksdb::WriteStallCondition::kStopped,
+                                                 rocksdb::WriteStallCondition::kNormal));
+    auto windows = log->stall_windows(DBEventLog::now_ns());
+    ASSERT_EQ(windows.size(), 1u);
+    EXPECT_FALSE(windows[0].open);
+    EXPECT_GE(windows[0].end_ns, windows[0].start_ns);
+    EXPECT_EQ(log->events().size(), 3u);
+}
+
+TEST(DBEventLogTest, CompactionUsesReportedElapsedTime) {
+    auto log = std::make_shared<DBEventLog>();
+    DBEventListener listener("main", log);
+
+    rocksdb::CompactionJobInfo info;
+    info.job_id = 7;
+    info.base_input_level = 1;
+    info.output_level = 2;
+    info.stats.elapsed_micros = 250000;
+    info.stats.total_input_bytes = 4096;
+    info.stats.total_output_bytes = 2048;
+    listener.OnCompactionCompleted(nullptr, info);
+
+    auto events = log->events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, DBEvent::Type::kCompaction);
+    EXPECT_NEAR(events[0].duration_ms(), 250.0, 1e-6);
+    EXPECT_EQ(events[0].input_level, 1);
+    EXPECT_EQ(events[0].output_level, 2);
+
+    auto totals = log->totals();
+    EXPECT_EQ(totals.compactions, 1u);
+    EXPECT_EQ(totals.compaction_micros, 250000u);
+    EXPECT_EQ(totals.compaction_bytes_read, 4096u);
+}
+
+TEST(DBEventLogTest, FlushDurationFromBeginToCompleted) {
+    auto log = std::make_shared<DBEventLog>();
+    DBEventListener listener("range_index", log);
+
+    rocksdb::FlushJobInfo info;
+    info.job_id = 3;
+    info.table_properties.data_size = 1000;
+    listener.OnFlushBegin(nullptr, info);
+    listener.OnFlushCompleted(nullptr, info);
+
+    auto events = log->events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, DBEvent::Type::kFlush);
+    EXPECT_GE(events[0].end_ns, events[0].start_ns);
+    EXPECT_EQ(events[0].bytes_written, 1000u);
+    EXPECT_EQ(log->events_between(events[0].start_ns, events[0].end_ns).size(), 1u);
+    EXPECT_TRUE(log->events_between(events[0].end_ns + 1, events[0].end_ns + 1000).empty());
+}
+
+TEST(LatencyTimelineTest, AggregatesPerSecond) {
+    LatencyTimeline timeline;
+    const int64_t origin = 1000000000000;
+    timeline.reset(origin, 10);
+
+    timeline.record(origin + 100, 1000000);                  // 第0秒 1ms
+    timeline.record(origin + 500000000, 3000000);            // 第0秒 3ms
+    timeline.record(origin + 2500000000, 50000000);          // 第2秒 50ms
+    timeline.record(origin + 99000000000, 7000000);          // 超出范围，计入最后一秒
+
+    EXPECT_EQ(timeline.at(0).count, 2u);
+    EXPECT_DOUBLE_EQ(timeline.at(0).avg_ms(), 2.0);
+    EXPECT_DOUBLE_EQ(timeline.at(0).max_ms(), 3.0);
+    EXPECT_EQ(timeline.at(1).count, 0u);
+    EXPECT_EQ(timeline.at(9).count, 1u);
+
+    auto window = timeline.aggregate(origin + 1500000000, origin + 2100000000);
+    EXPECT_EQ(window.count, 1u);
+    EXPECT_DOUBLE_EQ(window.max_ms(), 50.0);
+}
+
+TEST(LatencyTimelineTest, WindowRates) {
+    LatencyTimeline timeline;
+    const int64_t origin = 1000000000000;
+    timeline.reset(origin, 10);
+    for (int64_t second = 0; second < 10; ++second) {
+        for (int64_t i = 0; i < second; ++i) {
+            timeline.record(origin + second * 1000000000 + i, 1000);
+        }
+    }
+
+    // 第2-4秒、5-7秒、8秒（不足一个窗口）
+    auto rates = timeline.window_rates(2, 9, 3);
+    ASSERT_EQ(rates.size(), 3u);
+    EXPECT_DOUBLE_EQ(rates[0], 3.0);
+    EXPECT_DOUBLE_EQ(rates[1], 6.0);
+    EXPECT_DOUBLE_EQ(rates[2], 8.0);
+    EXPECT_TRUE(timeline.window_rates(5, 5, 3).empty());
+}
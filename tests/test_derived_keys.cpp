@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "utils/data_generator.hpp"
+#include <regex>
+#include <unordered_set>
+
+namespace {
+
+DataGenerator::Config derived_config(size_t total_keys, uint64_t seed) {
+    DataGenerator::Config config;
+    config.total_keys = total_keys;
+    config.hotspot_count = total_keys / 10;
+    config.medium_count = total_keys / 5;
+    config.tail_count = total_keys - config.hotspot_count - config.medium_count;
+    config.derived_keys = true;
+    config.key_seed = seed;
+    return config;
+}
+
+}  // namespace
+
+TEST(DerivedKeysTest, NoKeyTableIsBuilt) {
+    // 10亿个key：派生模式下构造是瞬时的，也不占内存
+    DataGenerator generator(derived_config(1000000000, 0));
+    EXPECT_TRUE(generator.derived_keys());
+    EXPECT_EQ(generator.key_count(), 1000000000u);
+    EXPECT_TRUE(generator.get_all_keys().empty());
+    EXPECT_EQ(generator.key_table_bytes(), 0u);
+    EXPECT_FALSE(generator.key_at(999999999).empty());
+}
+
+TEST(DerivedKeysTest, SameFormatAsRandomKeys) {
+    const std::regex format("0x[0-9a-f]{40}#slot[0-9]{1,6}");
+    DataGenerator generator(derived_config(1000, 7));
+    for (size_t i = 0; i < 1000; ++i) {
+        std::string key = generator.key_at(i);
+        EXPECT_TRUE(std::regex_match(key, format)) << key;
+    }
+}
+
+TEST(DerivedKeysTest, DeterministicPerSeedAndUnique) {
+    DataGenerator a(derived_config(200000, 1));
+    DataGenerator b(derived_config(200000, 1));
+    DataGenerator c(derived_config(200000, 2));
+    EXPECT_EQ(a.key_at(12345), b.key_at(12345));
+    EXPECT_NE(a.key_at(12345), c.key_at(12345));
+
+    std::unordered_set<std::string> seen;
+    std::string key;
+    for (size_t i = 0; i < 200000; ++i) {
+        a.fill_key(i, key);
+        EXPECT_TRUE(seen.insert(key).second) << "duplicate key at index " << i;
+    }
+}
+
+TEST(DerivedKeysTest, FillKeyReusesBufferAndMatchesTableMode) {
+    DataGenerator::Config config;
+    config.total_keys = 2;
+    DataGenerator table(std::vector<std::string>{"0xaa#slot1", "0xbb#slot2"}, config);
+    EXPECT_FALSE(table.derived_keys());
+    EXPECT_EQ(table.key_count(), 2u);
+
+    std::string key;
+    table.fill_key(1, key);
+    EXPECT_EQ(key, "0xbb#slot2");
+    DataGenerator::format_derived_key(0, 0, key);
+    DataGenerator derived(derived_config(10, 0));
+    EXPECT_EQ(key, derived.key_at(0));
+}
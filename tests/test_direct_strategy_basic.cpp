@@ -1,3 +1,4 @@
+#include "../src/core/strategy_db_manager.hpp"
 #include "../src/strategies/direct_version_strategy.hpp"
 #include "../src/utils/logger.hpp"
 #include <iostream>
@@ -85,11 +86,57 @@ int main() {
             }
         }
         
+        // 测试scan_version_history：[1, 8]内应返回block 5和8，limit截断
+        std::cout << "\nTesting scan_version_history..." << std::endl;
+        auto history = strategy->scan_version_history(db, test_key, 1, 8, 10);
+        for (const auto& [block, value] : history) {
+            std::cout << "  Block " << block << ": " << value << std::endl;
+        }
+        if (history.size() != 2 || history[0].first != 5 || history[1].first != 8 ||
+            strategy->scan_version_history(db, test_key, 0, 10, 1).size() != 1) {
+            std::cerr << "Unexpected version history" << std::endl;
+            strategy->cleanup(db);
+            delete db;
+            std::filesystem::remove_all(test_db_path);
+            return 1;
+        }
+        
+        // 测试query_latest_values：每个key返回最新版本，不存在的key返回空
+        std::cout << "\nTesting query_latest_values..." << std::endl;
+        std::string other_key = "0xabcdefabcdefabcdefabcdefabcdefabcdefabcd";
+        std::string missing_key = "0x0000000000000000000000000000000000000000";
+        std::vector<DataRecord> other_records = {{3, other_key, "other_at_block_3"}, {12, other_key, "other_at_block_12"}};
+        write_success = strategy->write_batch(db, other_records);
+        auto latest_values = strategy->query_latest_values(db, {test_key, other_key, missing_key});
+        for (size_t i = 0; i < latest_values.size(); ++i) {
+            std::cout << "  Key " << i << ": " << latest_values[i].value_or("NOT FOUND") << std::endl;
+        }
+        if (!write_success || latest_values.size() != 3 || latest_values[0] != "value_at_block_8" ||
+            latest_values[1] != "other_at_block_12" || latest_values[2].has_value()) {
+            std::cerr << "Unexpected latest values" << std::endl;
+            strategy->cleanup(db);
+            delete db;
+            std::filesystem::remove_all(test_db_path);
+            return 1;
+        }
+        
         // 清理
         strategy->cleanup(db);
         delete db;
         std::filesystem::remove_all(test_db_path);
         
+        // 测试StrategyDBManager在数据库关闭时的查询入口：都返回空结果，不把空db交给strategy
+        std::cout << "\nTesting queries on a closed database..." << std::endl;
+        StrategyDBManager closed_manager(test_db_path + "_closed", std::make_unique<DirectVersionStrategy>(config));
+        auto closed_values = closed_manager.query_latest_values({test_key, missing_key});
+        if (closed_manager.query_latest_value(test_key).has_value() ||
+            closed_values.size() != 2 || closed_values[0].has_value() || closed_values[1].has_value() ||
+            closed_manager.query_historical_version(test_key, 8).has_value() ||
+            !closed_manager.scan_version_history(test_key, 0, 10, 10).empty()) {
+            std::cerr << "Queries on a closed database should return empty results" << std::endl;
+            return 1;
+        }
+        
         std::cout << "\nTest completed successfully!" << std::endl;
         return 0;
         
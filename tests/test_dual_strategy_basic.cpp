@@ -87,6 +87,29 @@ int main() {
             }
         }
         
+        // 测试query_latest_values（range index的MultiGet路径）：跨多个range的key返回最新range中的值，
+        // 不存在的key返回空
+        std::cout << "\nTesting query_latest_values..." << std::endl;
+        std::string multi_range_key = "0xabcdefabcdefabcdefabcdefabcdefabcdefabcd";
+        std::string missing_key = "0x0000000000000000000000000000000000000000";
+        for (BlockNum block : {BlockNum{100}, BlockNum{6000}, BlockNum{12000}}) {
+            std::vector<DataRecord> records = {{block, multi_range_key, "value_at_block_" + std::to_string(block)}};
+            write_success = write_success && strategy->write_batch(db, records);
+        }
+        auto latest_values = strategy->query_latest_values(db, {test_key, multi_range_key, missing_key});
+        for (size_t i = 0; i < latest_values.size(); ++i) {
+            std::cout << "  Key " << i << ": " << latest_values[i].value_or("NOT FOUND") << std::endl;
+        }
+        if (!write_success || latest_values.size() != 3 || latest_values[0] != "value_at_block_8" ||
+            latest_values[1] != "value_at_block_12000" || latest_values[2].has_value() ||
+            strategy->query_latest_value(db, multi_range_key) != "value_at_block_12000") {
+            std::cerr << "Unexpected latest values" << std::endl;
+            strategy->cleanup(db);
+            delete db;
+            std::filesystem::remove_all(test_db_path);
+            return 1;
+        }
+        
         // 清理
         strategy->cleanup(db);
         delete db;
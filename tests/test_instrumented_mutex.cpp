@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "utils/instrumented_mutex.hpp"
+#include <chrono>
+#include <thread>
+
+namespace {
+
+const LockStatsRegistry::Snapshot* find(const std::vector<LockStatsRegistry::Snapshot>& rows, const std::string& name) {
+    for (const auto& row : rows) {
+        if (row.name == name) {
+            return &row;
+        }
+    }
+    return nullptr;
+}
+
+class InstrumentedMutexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        LockStatsRegistry::set_enabled(true);
+        LockStatsRegistry::instance().reset();
+    }
+    void TearDown() override {
+        LockStatsRegistry::set_enabled(false);
+    }
+};
+
+}  // namespace
+
+TEST_F(InstrumentedMutexTest, CountsUncontendedAcquisitionsAndHoldTime) {
+    InstrumentedMutex mutex("test.uncontended");
+    for (int i = 0; i < 10; ++i) {
+        std::lock_guard<InstrumentedMutex> lock(mutex);
+    }
+    auto rows = LockStatsRegistry::instance().snapshot();
+    const auto* row = find(rows, "test.uncontended");
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(row->acquisitions, 10u);
+    EXPECT_EQ(row->contended, 0u);
+    EXPECT_EQ(row->wait_total_ns, 0u);
+}
+
+TEST_F(InstrumentedMutexTest, RecordsWaitWhenContended) {
+    InstrumentedMutex mutex("test.contended");
+    std::unique_lock<InstrumentedMutex> holder(mutex);
+    std::thread waiter([&] {
+        std::lock_guard<InstrumentedMutex> lock(mutex);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    holder.unlock();
+    waiter.join();
+
+    auto rows = LockStatsRegistry::instance().snapshot();
+    const auto* row = find(rows, "test.contended");
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(row->acquisitions, 2u);
+    EXPECT_EQ(row->contended, 1u);
+    EXPECT_GE(row->wait_max_us, 10000.0);
+    EXPECT_GE(row->hold_max_us, 10000.0);
+    EXPECT_EQ(rows.front().name, "test.contended");   // 按等待时间排序
+}
+
+TEST_F(InstrumentedMutexTest, SameNameSharesStats) {
+    InstrumentedMutex a("test.segment");
+    InstrumentedMutex b("test.segment");
+    a.lock();
+    a.unlock();
+    ASSERT_TRUE(b.try_lock());
+    b.unlock();
+    auto rows = LockStatsRegistry::instance().snapshot();
+    ASSERT_NE(find(rows, "test.segment"), nullptr);
+    EXPECT_EQ(find(rows, "test.segment")->acquisitions, 2u);
+}
+
+TEST_F(InstrumentedMutexTest, SharedModeIsReportedSeparately) {
+    InstrumentedSharedMutex mutex("test.shared");
+    {
+        std::shared_lock<InstrumentedSharedMutex> r1(mutex);
+        std::shared_lock<InstrumentedSharedMutex> r2(mutex);
+    }
+    {
+        std::unique_lock<InstrumentedSharedMutex> w(mutex);
+    }
+    auto rows = LockStatsRegistry::instance().snapshot();
+    ASSERT_NE(find(rows, "test.shared"), nullptr);
+    ASSERT_NE(find(rows, "test.shared:shared"), nullptr);
+    EXPECT_EQ(find(rows, "test.shared")->acquisitions, 1u);
+    EXPECT_EQ(find(rows, "test.shared:shared")->acquisitions, 2u);
+    EXPECT_EQ(find(rows, "test.shared:shared")->contended, 0u);
+}
+
+TEST_F(InstrumentedMutexTest, DisabledRecordsNothing) {
+    LockStatsRegistry::set_enabled(false);
+    InstrumentedMutex mutex("test.disabled");
+    {
+        std::lock_guard<InstrumentedMutex> lock(mutex);
+    }
+    // 持有期间打开统计：释放时不应记录没有起点的持有时间
+    mutex.lock();
+    LockStatsRegistry::set_enabled(true);
+    mutex.unlock();
+    EXPECT_EQ(find(LockStatsRegistry::instance().snapshot(), "test.disabled"), nullptr);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "utils/key_distribution.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+std::vector<size_t> histogram(const KeyDistribution& distribution, size_t key_count, size_t samples, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<size_t> counts(key_count, 0);
+    for (size_t i = 0; i < samples; ++i) {
+        size_t index = distribution.next(rng);
+        EXPECT_LT(index, key_count);
+        if (index < key_count) {
+            counts[index]++;
+        }
+    }
+    return counts;
+}
+
+double zipf_pmf(size_t rank, size_t key_count, double theta) {
+    double normalizer = 0.0;
+    for (size_t k = 1; k <= key_count; ++k) {
+        normalizer += std::pow(static_cast<double>(k), -theta);
+    }
+    return std::pow(static_cast<double>(rank), -theta) / normalizer;
+}
+
+}  // namespace
+
+TEST(KeyDistributionTest, ZipfianMatchesExactPmf) {
+    const size_t n = 1000;
+    const size_t samples = 400000;
+    for (double theta : {0.5, 0.99, 1.0, 1.2}) {
+        ZipfianKeyDistribution zipf(n, theta);
+        auto counts = histogram(zipf, n, samples, 7);
+        for (size_t rank : {1, 2, 3, 10, 100}) {
+            double expected = zipf_pmf(rank, n, theta);
+            double observed = static_cast<double>(counts[rank - 1]) / samples;
+            EXPECT_NEAR(observed, expected, expected * 0.1 + 0.0005) << "theta=" << theta << " rank=" << rank;
+        }
+    }
+}
+
+TEST(KeyDistributionTest, ScrambledZipfianSpreadsHotKeys) {
+    const size_t n = 10000;
+    ScrambledZipfianKeyDistribution scrambled(n, 0.99);
+    auto counts = histogram(scrambled, n, 200000, 11);
+    auto hottest = std::max_element(counts.begin(), counts.end()) - counts.begin();
+    // 热度与zipfian相同，但最热key不在索引0
+    EXPECT_NE(hottest, 0);
+    EXPECT_GT(static_cast<double>(counts[hottest]) / 200000, zipf_pmf(1, n, 0.99) * 0.8);
+}
+
+TEST(KeyDistributionTest, LatestFavorsNewestKeyAndFollowsSetLatest) {
+    const size_t n = 500;
+    LatestKeyDistribution latest(n, 0.99);
+    auto counts = histogram(latest, n, 100000, 3);
+    EXPECT_EQ(std::max_element(counts.begin(), counts.end()) - counts.begin(), static_cast<long>(n - 1));
+    EXPECT_GT(counts[n - 2], counts[0]);
+
+    latest.set_latest(10);
+    counts = histogram(latest, n, 100000, 4);
+    EXPECT_EQ(std::max_element(counts.begin(), counts.end()) - counts.begin(), 10);
+    EXPECT_GT(counts[9], counts[11]);   // 向前衰减，11是回绕后最旧的key
+
+    // 写线程通过基类接口更新最新位置
+    auto from_factory = make_key_distribution("latest", n, KeyDistributionParams{});
+    from_factory->observe_write(200);
+    counts = histogram(*from_factory, n, 100000, 6);
+    EXPECT_EQ(std::max_element(counts.begin(), counts.end()) - counts.begin(), 200);
+}
+
+TEST(KeyDistributionTest, MovingHotspotWindow) {
+    const size_t n = 10000;
+    MovingHotspotKeyDistribution hotspot(n, 0.01, 0.9, 10.0);
+    EXPECT_EQ(hotspot.window_size(), 100u);
+    EXPECT_EQ(hotspot.window_start(0.0), 0u);
+    EXPECT_EQ(hotspot.window_start(9.9), 0u);
+    EXPECT_EQ(hotspot.window_start(25.0), 200u);
+    EXPECT_EQ(hotspot.window_start(10.0 * 100), 0u);   // 移动一整圈后回到起点
+
+    auto counts = histogram(hotspot, n, 100000, 5);
+    size_t in_window = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        in_window += counts[i];
+    }
+    EXPECT_NEAR(static_cast<double>(in_window) / 100000, 0.9 + 0.1 * 0.01, 0.01);
+}
+
+TEST(KeyDistributionTest, TieredFillKeepsExactBlockProportions) {
+    const size_t n = 1000;
+    TieredKeyDistribution tiered(n, 100, 200);
+    std::mt19937 rng(9);
+    std::vector<size_t> indices;
+    tiered.fill(1000, rng, indices);
+    ASSERT_EQ(indices.size(), 1000u);
+    size_t hot = std::count_if(indices.begin(), indices.end(), [](size_t i) { return i < 100; });
+    size_t medium = std::count_if(indices.begin(), indices.end(), [](size_t i) { return i >= 100 && i < 300; });
+    EXPECT_EQ(hot, 800u);
+    EXPECT_EQ(medium, 100u);
+
+    auto counts = histogram(tiered, n, 100000, 10);
+    size_t sampled_hot = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        sampled_hot += counts[i];
+    }
+    EXPECT_NEAR(static_cast<double>(sampled_hot) / 100000, 0.8, 0.01);
+}
+
+TEST(KeyDistributionTest, FactoryKnowsAllNames) {
+    KeyDistributionParams params;
+    params.hot_count = 10;
+    params.medium_count = 20;
+    for (const auto& name : key_distribution_names()) {
+        auto distribution = make_key_distribution(name, 100, params);
+        ASSERT_NE(distribution, nullptr);
+        EXPECT_EQ(distribution->name(), name);
+    }
+    EXPECT_THROW(make_key_distribution("pareto", 100, params), std::invalid_argument);
+    EXPECT_FALSE(is_key_distribution_name("pareto"));
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "../src/utils/latency_histogram.hpp"
+#include "../src/utils/tsc_clock.hpp"
+
+// 测试桶边界：桶号单调且每个值落在所属桶的上界之内，相对误差<1%
+TEST(LatencyHistogramTest, BucketBoundsAreTight) {
+    size_t previous_index = 0;
+    for (uint64_t value = 1; value < (1ULL << 40); value = value * 3 / 2 + 1) {
+        size_t index = LatencyHistogram::bucket_index(value);
+        ASSERT_LT(index, LatencyHistogram::kBucketCount);
+        EXPECT_GE(index, previous_index);
+        uint64_t upper = LatencyHistogram::bucket_upper_bound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value), value / 128.0 + 1.0);
+        previous_index = index;
+    }
+    EXPECT_LT(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::kBucketCount);
+}
+
+// 测试均匀分布下的百分位
+TEST(LatencyHistogramTest, PercentilesOfUniformValues) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value * 1000);  // 1us .. 100ms
+    }
+
+    EXPECT_EQ(histogram.count(), 100000u);
+    EXPECT_EQ(histogram.min(), 1000u);
+    EXPECT_EQ(histogram.max(), 100000000u);
+    EXPECT_NEAR(histogram.mean(), 50000500.0, 1.0);
+
+    auto within = [](uint64_t actual, double expected) {
+        return std::abs(static_cast<double>(actual) - expected) <= expected * 0.01;
+    };
+    EXPECT_TRUE(within(histogram.value_at_percentile(50.0), 50e6));
+    EXPECT_TRUE(within(histogram.value_at_percentile(90.0), 90e6));
+    EXPECT_TRUE(within(histogram.value_at_percentile(99.0), 99e6));
+    EXPECT_TRUE(within(histogram.value_at_percentile(99.9), 99.9e6));
+    EXPECT_EQ(histogram.value_at_percentile(100.0), histogram.max());
+}
+
+// 测试多个线程的直方图合并
+TEST(LatencyHistogramTest, MergeCombinesThreadHistograms) {
+    constexpr int kThreads = 4;
+    std::vector<LatencyHistogram> histograms(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&histograms, t] {
+            for (int i = 0; i < 10000; ++i) {
+                histograms[t].record(static_cast<uint64_t>(t + 1) * 1000000);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    LatencyHistogram merged;
+    for (const auto& histogram : histograms) {
+        merged.merge_from(histogram);
+    }
+    EXPECT_EQ(merged.count(), 40000u);
+    EXPECT_EQ(merged.min(), 1000000u);
+    EXPECT_EQ(merged.max(), 4000000u);
+    EXPECT_LE(merged.value_at_percentile(25.0), 1000000u + 1000000u / 128);
+    EXPECT_EQ(merged.value_at_percentile(99.99), 4000000u);
+
+    merged.reset();
+    EXPECT_EQ(merged.count(), 0u);
+    EXPECT_EQ(merged.value_at_percentile(99.0), 0u);
+}
+
+// 测试区间直方图：累计快照相减只剩区间内的记录
+TEST(LatencyHistogramTest, SubtractYieldsIntervalHistogram) {
+    LatencyHistogram live;
+    for (int i = 0; i < 1000; ++i) {
+        live.record(1000);
+    }
+    LatencyHistogram previous;
+    previous.copy_from(live);
+    for (int i = 0; i < 100; ++i) {
+        live.record(5000000);
+    }
+
+    LatencyHistogram interval;
+    interval.copy_from(live);
+    interval.subtract(previous);
+    EXPECT_EQ(interval.count(), 100u);
+    EXPECT_NEAR(interval.mean(), 5000000.0, 1.0);
+    EXPECT_GE(interval.min(), 5000000u - 5000000u / 128);
+    EXPECT_EQ(interval.max(), 5000000u);
+    EXPECT_EQ(interval.value_at_percentile(50.0), 5000000u);
+}
+
+// 测试TSC时钟与steady_clock一致（允许较大误差，避免CI抖动）
+TEST(TscClockTest, MatchesSteadyClock) {
+    ASSERT_GT(TscClock::ticks_per_ns(), 0.0);  // 先完成校准
+    uint64_t start = TscClock::now();
+    auto wall_start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    uint64_t elapsed_ns = TscClock::elapsed_nanos(start);
+    auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - wall_start).count();
+    EXPECT_NEAR(static_cast<double>(elapsed_ns), static_cast<double>(wall_ns), wall_ns * 0.2);
+}
@@ -295,7 +295,7 @@ int main() {
         std::cout << "Write ops/sec: " << std::fixed << std::setprecision(2) << stats.write_ops_per_sec << std::endl;
         std::cout << "Query ops/sec: " << std::fixed << std::setprecision(2) << stats.query_ops_per_sec << std::endl;
 
-        if (!stats.query_latencies_ms.empty()) {
+        if (stats.total_query_ops > 0) {
             std::cout << "Query latency stats:" << std::endl;
             std::cout << "  Avg: " << std::fixed << std::setprecision(3) << stats.query_avg_ms << " ms" << std::endl;
             std::cout << "  P50: " << std::fixed << std::setprecision(3) << stats.query_p50_ms << " ms" << std::endl;
@@ -362,6 +362,58 @@ int main() {
         std::cout << "✓ Test 5 passed: Memory safety and data consistency verified" << std::endl;
     }
 
+    // Test 6: the latest read distribution follows the writers
+    {
+        std::cout << "\nTest 6: Latest distribution follows writes..." << std::endl;
+
+        // 写入全部落在固定的热点窗口[0, 10)，latest的最新位置应从最后一个key移到窗口内
+        BenchmarkConfig config;
+        config.db_path = "/tmp/lock_optimization_test4";
+        config.storage_strategy = "dual_rocksdb";
+        config.total_keys = 1000;
+        config.batch_size_blocks = 1000;
+        config.write_distribution = "hotspot";
+        config.read_distribution = "latest";
+        config.hotspot_fraction = 0.01;
+        config.hotspot_probability = 1.0;
+        config.hotspot_period_seconds = 0;
+
+        std::system("rm -rf /tmp/lock_optimization_test4");
+
+        DualRocksDBStrategy::Config strategy_config;
+        strategy_config.range_size = 10000;
+        strategy_config.max_cache_memory = 64 * 1024 * 1024;
+
+        std::unique_ptr<IStorageStrategy> strategy = std::make_unique<DualRocksDBStrategy>(strategy_config);
+        auto db_manager = std::make_shared<StrategyDBManager>(config.db_path, std::move(strategy));
+        if (!db_manager->open(true)) {
+            throw std::runtime_error("Failed to open database");
+        }
+
+        auto metrics = std::make_shared<MetricsCollector>();
+        auto runner = std::make_unique<StrategyScenarioRunner>(db_manager, metrics, config);
+
+        StrategyScenarioRunner::ConcurrentTestConfig test_config;
+        test_config.reader_thread_count = 2;
+        test_config.test_duration_seconds = 2;
+        test_config.block_size = 100;
+        test_config.write_sleep_seconds = 0;
+        test_config.write_result_file = false;
+        runner->run_concurrent_read_write_test(test_config);
+
+        auto stats = runner->get_performance_stats();
+        auto* latest = dynamic_cast<const LatestKeyDistribution*>(runner->get_read_distribution());
+        assert(stats.total_write_ops > 0);
+        assert(latest != nullptr);
+        std::cout << "Latest head after writes: " << latest->latest() << std::endl;
+        assert(latest->latest() < 10);
+
+        std::cout << "✓ Test 6 passed: Latest distribution head moved to the written keys" << std::endl;
+
+        runner.reset();
+        db_manager.reset();
+    }
+
     // Cleanup test databases
     std::system("rm -rf /tmp/lock_optimization_test*");
 
@@ -371,6 +423,7 @@ int main() {
     std::cout << "✓ Performance optimization: Read operations faster than write operations" << std::endl;
     std::cout << "✓ Concurrent scenario: Full integration test successful" << std::endl;
     std::cout << "✓ Memory safety: No crashes or data corruption detected" << std::endl;
+    std::cout << "✓ Latest distribution: Head follows the most recent writes" << std::endl;
 
     return 0;
 }
\ No newline at end of file
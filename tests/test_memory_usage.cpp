@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "utils/data_generator.hpp"
+#include "utils/latency_histogram.hpp"
+#include "utils/latency_timeline.hpp"
+#include "utils/process_memory.hpp"
+
+TEST(MemoryUsageTest, ProcessMemoryReportsRssAndPeak) {
+    auto memory = utils::read_process_memory();
+#ifdef __linux__
+    EXPECT_GT(memory.rss_bytes, 0u);
+    EXPECT_GE(memory.peak_rss_bytes, memory.rss_bytes);
+#else
+    EXPECT_EQ(memory.rss_bytes, 0u);
+#endif
+}
+
+TEST(MemoryUsageTest, KeyTableBytesCoversVectorAndHeapStrings) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(std::string(72, 'a' + i % 26));   // 地址+slot长度，超出SSO
+    }
+    DataGenerator::Config config;
+    config.total_keys = keys.size();
+    DataGenerator generator(std::move(keys), config);
+
+    uint64_t bytes = generator.key_table_bytes();
+    EXPECT_GE(bytes, 1000 * (sizeof(std::string) + 73));
+    EXPECT_LT(bytes, 1000 * (sizeof(std::string) + 256));
+}
+
+TEST(MemoryUsageTest, ShortKeysStayInline) {
+    DataGenerator::Config config;
+    config.total_keys = 3;
+    DataGenerator generator(std::vector<std::string>{"a", "b", "c"}, config);
+    EXPECT_EQ(generator.key_table_bytes(), generator.get_all_keys().capacity() * sizeof(std::string));
+}
+
+TEST(MemoryUsageTest, TimelineAndHistogramFootprint) {
+    LatencyTimeline timeline;
+    size_t empty = timeline.memory_bytes();
+    timeline.reset(0, 600);
+    EXPECT_GE(timeline.memory_bytes(), empty + 600 * 3 * sizeof(uint64_t));
+
+    EXPECT_GT(LatencyHistogram::memory_bytes(), LatencyHistogram::kBucketCount * sizeof(uint64_t));
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "benchmark/query_perf_report.hpp"
+
+namespace {
+
+query_perf::Sample make_sample(uint64_t latency_ns, uint64_t block_reads) {
+    query_perf::Sample sample;
+    sample.latency_ns = latency_ns;
+    sample.total.block_reads = block_reads;
+    sample.total.block_cache_hits = 2;
+    query_perf::StageCounters stage;
+    stage.name = "data_seek";
+    stage.calls = 1;
+    stage.counters.block_reads = block_reads;
+    sample.stages.push_back(stage);
+    return sample;
+}
+
+}  // namespace
+
+TEST(QueryPerfContextTest, StagesAccumulateOnlyWhileSampling) {
+    {
+        query_perf::StageScope outside("ignored");
+    }
+
+    query_perf::begin_sample();
+    EXPECT_TRUE(query_perf::active());
+    for (int i = 0; i < 3; ++i) {
+        query_perf::StageScope stage("data_seek");
+    }
+    {
+        query_perf::StageScope stage("range_index_get");
+    }
+    auto sample = query_perf::end_sample();
+    EXPECT_FALSE(query_perf::active());
+
+    ASSERT_EQ(sample.stages.size(), 2u);
+    EXPECT_EQ(sample.stages[0].name, "data_seek");
+    EXPECT_EQ(sample.stages[0].calls, 3u);
+    EXPECT_EQ(sample.stages[1].name, "range_index_get");
+    EXPECT_EQ(sample.stages[1].calls, 1u);
+}
+
+TEST(QueryPerfReportTest, SamplesLandInLatencyBands) {
+    // 1..1000微秒均匀分布：p50约0.5ms，p99约0.99ms
+    LatencyHistogram latency;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        latency.record(i * 1000);
+    }
+
+    std::vector<query_perf::Sample> samples;
+    samples.push_back(make_sample(100000, 1));      // <p50
+    samples.push_back(make_sample(200000, 1));      // <p50
+    samples.push_back(make_sample(950000, 4));      // p90-p99
+    samples.push_back(make_sample(5000000, 20));    // 超过最大值，>=p99.9
+
+    QueryPerfReport report(latency, samples);
+    const auto& bands = report.bands();
+    ASSERT_EQ(bands.size(), 5u);
+    EXPECT_EQ(report.sample_count(), 4u);
+
+    EXPECT_EQ(bands[0].label, "<p50");
+    EXPECT_EQ(bands[0].samples, 2u);
+    EXPECT_EQ(bands[0].total.block_reads, 2u);
+    EXPECT_EQ(bands[2].label, "p90-p99");
+    EXPECT_EQ(bands[2].samples, 1u);
+    EXPECT_EQ(bands[4].samples, 1u);
+    EXPECT_EQ(bands[4].total.block_reads, 20u);
+    ASSERT_EQ(bands[4].stages.size(), 1u);
+    EXPECT_EQ(bands[4].stages[0].counters.block_reads, 20u);
+
+    auto json = report.to_json();
+    EXPECT_EQ(json["sampled_queries"], 4);
+    EXPECT_DOUBLE_EQ(json["bands"][0]["per_query"]["block_reads"].get<double>(), 1.0);
+    EXPECT_DOUBLE_EQ(json["bands"][4]["stages"]["data_seek"]["calls"].get<double>(), 1.0);
+}
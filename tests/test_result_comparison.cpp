@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "benchmark/result_comparison.hpp"
+#include "benchmark/result_document.hpp"
+#include <random>
+
+namespace {
+
+// 构造一个最小的结果文档：直方图 + 区间吞吐
+nlohmann::json make_document(double latency_scale, double throughput, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::lognormal_distribution<double> latency(std::log(200000.0 * latency_scale), 0.5);
+    LatencyHistogram histogram;
+    for (int i = 0; i < 20000; ++i) {
+        histogram.record(static_cast<uint64_t>(latency(rng)));
+    }
+
+    std::normal_distribution<double> noise(throughput, throughput * 0.02);
+    nlohmann::json intervals = nlohmann::json::array();
+    double sum = 0.0;
+    for (int i = 0; i < 30; ++i) {
+        double value = noise(rng);
+        sum += value;
+        intervals.push_back({{"query_ops_per_sec", value}, {"write_kv_per_sec", value / 10}});
+    }
+
+    nlohmann::json document;
+    document["schema_version"] = result_document::kSchemaVersion;
+    document["histograms"]["query_latency"] = result_document::histogram_to_json(histogram);
+    document["summary"] = {{"query_ops_per_sec", sum / 30}, {"write_kv_per_sec", sum / 300}};
+    document["intervals"] = intervals;
+    return document;
+}
+
+const ResultComparator::MetricComparison* find_metric(
+    const std::vector<ResultComparator::MetricComparison>& metrics, const std::string& name) {
+    for (const auto& metric : metrics) {
+        if (metric.name == name) {
+            return &metric;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST(ResultDocumentTest, HistogramRoundTrip) {
+    LatencyHistogram original;
+    for (uint64_t value : {1000ULL, 25000ULL, 25100ULL, 3000000ULL, 900000000ULL}) {
+        original.record(value);
+    }
+
+    LatencyHistogram restored;
+    ASSERT_TRUE(result_document::histogram_from_json(result_document::histogram_to_json(original), restored));
+    EXPECT_EQ(restored.count(), original.count());
+    EXPECT_EQ(restored.sum(), original.sum());
+    EXPECT_EQ(restored.min(), original.min());
+    EXPECT_EQ(restored.max(), original.max());
+    for (double p : {10.0, 50.0, 90.0, 99.0}) {
+        EXPECT_EQ(restored.value_at_percentile(p), original.value_at_percentile(p));
+    }
+}
+
+TEST(ResultComparatorTest, BootstrapPercentileCentersOnPointEstimate) {
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        histogram.record(i * 1000);
+    }
+    ResultComparator comparator(ResultComparator::Options{});
+    auto samples = comparator.bootstrap_percentile(histogram, 99.0);
+    ASSERT_EQ(samples.size(), 1000u);
+    double mean = 0.0;
+    for (double s : samples) {
+        mean += s;
+    }
+    mean /= samples.size();
+    EXPECT_NEAR(mean, histogram.percentile_ms(99.0), histogram.percentile_ms(99.0) * 0.02);
+}
+
+TEST(ResultComparatorTest, SameDistributionIsNotRegression) {
+    auto baseline = make_document(1.0, 50000.0, 1);
+    auto candidate = make_document(1.0, 50000.0, 2);
+
+    ResultComparator comparator(ResultComparator::Options{});
+    auto metrics = comparator.compare(baseline, candidate);
+    ASSERT_FALSE(metrics.empty());
+    for (const auto& metric : metrics) {
+        EXPECT_FALSE(metric.regression) << metric.name;
+    }
+}
+
+TEST(ResultComparatorTest, FlagsLatencyAndThroughputRegression) {
+    auto baseline = make_document(1.0, 50000.0, 1);
+    auto candidate = make_document(1.3, 40000.0, 2);
+
+    ResultComparator comparator(ResultComparator::Options{});
+    auto metrics = comparator.compare(baseline, candidate);
+
+    const auto* p99 = find_metric(metrics, "query_latency_p99_ms");
+    ASSERT_NE(p99, nullptr);
+    EXPECT_TRUE(p99->significant);
+    EXPECT_TRUE(p99->regression);
+    EXPECT_GT(p99->ci_low_pct, 0.0);
+
+    const auto* throughput = find_metric(metrics, "query_ops_per_sec");
+    ASSERT_NE(throughput, nullptr);
+    EXPECT_TRUE(throughput->regression);
+    EXPECT_LT(throughput->delta_pct, -10.0);
+}
+
+TEST(ResultComparatorTest, ImprovementIsNotRegression) {
+    auto baseline = make_document(1.3, 40000.0, 1);
+    auto candidate = make_document(1.0, 50000.0, 2);
+
+    ResultComparator comparator(ResultComparator::Options{});
+    auto metrics = comparator.compare(baseline, candidate);
+    const auto* p50 = find_metric(metrics, "query_latency_p50_ms");
+    ASSERT_NE(p50, nullptr);
+    EXPECT_TRUE(p50->improvement);
+    EXPECT_FALSE(p50->regression);
+}
+
+TEST(ResultComparatorTest, CpuEfficiencyIsPointEstimateOnly) {
+    auto baseline = make_document(1.0, 50000.0, 1);
+    auto candidate = make_document(1.0, 50000.0, 2);
+    baseline["cpu"] = {{"cpu_us_per_query", 40.0}, {"cpu_us_per_write_record", 8.0}};
+    candidate["cpu"] = {{"cpu_us_per_query", 80.0}, {"cpu_us_per_write_record", 8.0}};
+
+    ResultComparator comparator(ResultComparator::Options{});
+    auto metrics = comparator.compare(baseline, candidate);
+    const auto* cpu = find_metric(metrics, "cpu_us_per_query");
+    ASSERT_NE(cpu, nullptr);
+    EXPECT_DOUBLE_EQ(cpu->delta_pct, 100.0);
+    EXPECT_FALSE(cpu->has_ci);
+    EXPECT_FALSE(cpu->regression);
+
+    // 旧结果文件没有cpu段时不输出CPU指标
+    baseline.erase("cpu");
+    metrics = comparator.compare(baseline, candidate);
+    EXPECT_EQ(find_metric(metrics, "cpu_us_per_query"), nullptr);
+}
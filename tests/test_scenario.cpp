@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "benchmark/scenario.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+nlohmann::json scenario_with_phases(nlohmann::json phases) {
+    return {{"name", "test"}, {"phases", std::move(phases)}};
+}
+
+}  // namespace
+
+TEST(ScenarioTest, ExampleScenarioParses) {
+    Scenario scenario = parse_scenario(nlohmann::json::parse(example_scenario_json().dump()));
+    EXPECT_EQ(scenario.name, "node-lifecycle");
+    ASSERT_EQ(scenario.phases.size(), 8u);
+    EXPECT_TRUE(scenario.has_load_phase());
+
+    std::vector<std::string> names;
+    for (const auto& phase : scenario.phases) {
+        names.push_back(phase.name);
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"load", "warm_up", "steady", "burst", "catch_up", "prune", "reopen",
+                                               "steady_cold"}));
+
+    // defaults作用于所有读写阶段，阶段自己的参数优先
+    const ScenarioPhase& burst = scenario.phases[3];
+    EXPECT_EQ(burst.type, ScenarioPhaseType::kBurst);
+    EXPECT_EQ(burst.reader_threads, 40u);
+    EXPECT_EQ(burst.writer_threads, 1u);
+    EXPECT_EQ(burst.read_distribution, "scrambled_zipfian");
+    EXPECT_DOUBLE_EQ(burst.query_rate.value_or(0.0), 50000.0);
+    EXPECT_EQ(burst.sample_interval_seconds, 10u);
+
+    EXPECT_FALSE(scenario.phases[1].write_result);   // warm_up默认不写结果文件
+    EXPECT_EQ(scenario.phases[1].duration_seconds, 60u);
+    EXPECT_EQ(scenario.phases[4].catch_up_baseline_seconds, 10u);
+    EXPECT_FALSE(scenario.phases[5].is_read_write());
+}
+
+TEST(ScenarioTest, DefaultNamesAreUnique) {
+    Scenario scenario = parse_scenario(scenario_with_phases({
+        {{"type", "steady"}, {"duration_seconds", 10}},
+        {{"type", "reopen"}},
+        {{"type", "steady"}, {"duration_seconds", 10}},
+        {{"type", "steady"}, {"name", "steady_3"}},
+        {{"type", "steady"}},
+    }));
+    ASSERT_EQ(scenario.phases.size(), 5u);
+    EXPECT_FALSE(scenario.has_load_phase());
+    EXPECT_EQ(scenario.phases[0].name, "steady");
+    EXPECT_EQ(scenario.phases[2].name, "steady_2");
+    EXPECT_EQ(scenario.phases[3].name, "steady_3");
+    EXPECT_EQ(scenario.phases[4].name, "steady_4");
+    EXPECT_EQ(scenario.phases[4].duration_seconds, 300u);
+}
+
+TEST(ScenarioTest, WorkloadPresetSitsBetweenDefaultsAndPhase) {
+    Scenario scenario = parse_scenario({
+        {"defaults", {{"read_distribution", "latest"}, {"block_size", 5}}},
+        {"phases", {{{"type", "steady"}, {"workload", "W-C"}, {"version_distribution", "recent"}}}},
+    });
+    const ScenarioPhase& phase = scenario.phases[0];
+    EXPECT_EQ(phase.workload, "W-C");
+    EXPECT_EQ(phase.block_size, 1000u);                       // 预设覆盖defaults
+    EXPECT_EQ(phase.read_distribution, "uniform");
+    EXPECT_EQ(phase.version_distribution, "recent");          // 阶段参数覆盖预设
+}
+
+TEST(ScenarioTest, RejectsInvalidScenarios) {
+    EXPECT_THROW(parse_scenario(nlohmann::json::array()), std::invalid_argument);
+    EXPECT_THROW(parse_scenario({{"phases", nlohmann::json::array()}}), std::invalid_argument);
+    EXPECT_THROW(parse_scenario({{"phases", {{{"type", "steady"}}}}, {"extra", 1}}), std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "idle"}}})), std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"reader_thread", 4}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"duration_seconds", -1}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"duration_seconds", 0}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"writer_threads", 0}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"read_distribution", "gauss"}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"workload", "W-Z"}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"block_rate", 10}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "prune"}, {"duration_seconds", 10}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"name", "a/b"}}})),
+                 std::invalid_argument);
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}, {"name", "x"}},
+                                                      {{"type", "burst"}, {"name", "x"}}})),
+                 std::invalid_argument);
+    // load只能是第一个阶段
+    EXPECT_THROW(parse_scenario(scenario_with_phases({{{"type", "steady"}}, {{"type", "load"}}})),
+                 std::invalid_argument);
+}
+
+TEST(ScenarioTest, LoadsFileWithComments) {
+    std::string path = testing::TempDir() + "scenario.json";
+    {
+        std::ofstream file(path);
+        file << "{\n  // restart test\n  \"phases\": [{\"type\": \"load\"}, {\"type\": \"reopen\"}]\n}\n";
+    }
+    Scenario scenario = load_scenario(path);
+    EXPECT_EQ(scenario.name, "scenario");
+    EXPECT_EQ(scenario.phases.size(), 2u);
+
+    {
+        std::ofstream file(path);
+        file << "{\"phases\": [";
+    }
+    EXPECT_THROW(load_scenario(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(load_scenario(path), std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../src/benchmark/time_series_writer.hpp"
+
+namespace {
+
+std::vector<std::string> read_lines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::string temp_path(const std::string& name) {
+    auto path = std::filesystem::temp_directory_path() / ("rocksdb_bench_" + name);
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+}  // namespace
+
+// 测试CSV：表头只写一次，重新打开后追加而不重复写表头
+TEST(TimeSeriesWriterTest, CsvAppendsRowsUnderSingleHeader) {
+    std::string path = temp_path("ts_test.csv");
+    {
+        TimeSeriesWriter writer(path);
+        ASSERT_TRUE(writer.is_open());
+        EXPECT_FALSE(writer.is_jsonl());
+        writer.append({{"elapsed_s", 10.0}, {"l0_files", uint64_t{3}}});
+        writer.append({{"elapsed_s", 20.0}, {"l0_files", uint64_t{5}}});
+    }
+    {
+        TimeSeriesWriter writer(path);
+        writer.append({{"elapsed_s", 30.0}, {"l0_files", uint64_t{7}}});
+    }
+
+    auto lines = read_lines(path);
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0], "elapsed_s,l0_files");
+    EXPECT_EQ(lines[1], "10.000000,3");
+    EXPECT_EQ(lines[3], "30.000000,7");
+    std::filesystem::remove(path);
+}
+
+// 测试JSONL：每行一个独立的JSON对象
+TEST(TimeSeriesWriterTest, JsonlWritesOneObjectPerLine) {
+    std::string path = temp_path("ts_test.jsonl");
+    {
+        TimeSeriesWriter writer(path);
+        ASSERT_TRUE(writer.is_jsonl());
+        writer.append({{"elapsed_s", 10.0}, {"db", std::string("main")}, {"l0_files", uint64_t{2}}});
+        writer.append({{"elapsed_s", 20.0}, {"db", std::string("main")}, {"l0_files", uint64_t{4}}});
+    }
+
+    auto lines = read_lines(path);
+    ASSERT_EQ(lines.size(), 2u);
+    auto second = nlohmann::json::parse(lines[1]);
+    EXPECT_DOUBLE_EQ(second["elapsed_s"].get<double>(), 20.0);
+    EXPECT_EQ(second["db"].get<std::string>(), "main");
+    EXPECT_EQ(second["l0_files"].get<uint64_t>(), 4u);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "utils/value_generator.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+TEST(ValueGeneratorTest, DefaultIsFixed32RandomAndUnique) {
+    auto generator = make_value_generator({});
+    std::set<std::string> seen;
+    std::string value;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        generator->fill(i, value);
+        ASSERT_EQ(value.size(), 32u);
+        seen.insert(value);
+    }
+    EXPECT_EQ(seen.size(), 10000u);
+
+    // 同一索引得到同一value
+    std::string again;
+    generator->fill(1234, value);
+    generator->fill(1234, again);
+    EXPECT_EQ(value, again);
+}
+
+TEST(ValueGeneratorTest, UniformAndLogNormalStayInRange) {
+    ValueGeneratorParams params;
+    params.size_distribution = "uniform";
+    params.min_size = 10;
+    params.max_size = 20;
+    auto uniform = make_value_generator(params);
+    std::set<size_t> sizes;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        size_t size = uniform->size_for(i);
+        EXPECT_GE(size, 10u);
+        EXPECT_LE(size, 20u);
+        sizes.insert(size);
+    }
+    EXPECT_EQ(sizes.size(), 11u);
+    EXPECT_NEAR(uniform->estimated_mean_size(), 15.0, 0.2);
+
+    params.size_distribution = "lognormal";
+    params.size = 100;
+    params.sigma = 1.0;
+    params.min_size = 1;
+    params.max_size = 100000;
+    auto lognormal = make_value_generator(params);
+    size_t below_median = 0;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        size_t size = lognormal->size_for(i);
+        EXPECT_GE(size, 1u);
+        EXPECT_LE(size, 100000u);
+        below_median += size < 100 ? 1 : 0;
+    }
+    EXPECT_NEAR(below_median / 20000.0, 0.5, 0.02);
+    // 均值约为median * exp(sigma^2 / 2)
+    EXPECT_NEAR(lognormal->estimated_mean_size(), 100.0 * std::exp(0.5), 8.0);
+}
+
+TEST(ValueGeneratorTest, EmpiricalHistogramFollowsWeights) {
+    std::string path = testing::TempDir() + "value_sizes.txt";
+    {
+        std::ofstream file(path);
+        file << "# size weight\n32 3\n\n1024, 1   # large values\n";
+    }
+    ValueGeneratorParams params;
+    params.size_distribution = "empirical";
+    params.histogram_file = path;
+    auto generator = make_value_generator(params);
+    size_t small = 0;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        size_t size = generator->size_for(i);
+        ASSERT_TRUE(size == 32 || size == 1024);
+        small += size == 32 ? 1 : 0;
+    }
+    EXPECT_NEAR(small / 20000.0, 0.75, 0.02);
+
+    {
+        std::ofstream file(path);
+        file << "32 1\nnot-a-size 2\n";
+    }
+    EXPECT_THROW(make_value_generator(params), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(make_value_generator(params), std::runtime_error);
+}
+
+TEST(ValueGeneratorTest, ContentControlsCompressibility) {
+    ValueGeneratorParams params;
+    params.size = 64;
+    params.content = "zeros";
+    params.zero_ratio = 0.75;
+    auto zeros = make_value_generator(params);
+    std::string value;
+    zeros->fill(7, value);
+    ASSERT_EQ(value.size(), 64u);
+    EXPECT_EQ(value.substr(0, 48), std::string(48, '\0'));
+
+    // 全部置零时仍保留8个非零字节，value保持唯一
+    params.zero_ratio = 1.0;
+    auto all_zeros = make_value_generator(params);
+    std::set<std::string> seen;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        all_zeros->fill(i, value);
+        EXPECT_EQ(value.substr(0, 56), std::string(56, '\0'));
+        seen.insert(value);
+    }
+    EXPECT_EQ(seen.size(), 1000u);
+
+    params.content = "pattern";
+    auto pattern = make_value_generator(params);
+    pattern->fill(7, value);
+    for (size_t i = 16; i < value.size(); ++i) {
+        EXPECT_EQ(value[i], value[i % 16]);
+    }
+}
+
+TEST(ValueGeneratorTest, RejectsInvalidParameters) {
+    ValueGeneratorParams params;
+    params.size_distribution = "bimodal";
+    EXPECT_THROW(make_value_generator(params), std::invalid_argument);
+
+    params = {};
+    params.content = "text";
+    EXPECT_THROW(make_value_generator(params), std::invalid_argument);
+
+    params = {};
+    params.size_distribution = "uniform";
+    params.min_size = 200;
+    params.max_size = 100;
+    EXPECT_THROW(make_value_generator(params), std::invalid_argument);
+
+    params = {};
+    params.zero_ratio = 1.5;
+    EXPECT_THROW(make_value_generator(params), std::invalid_argument);
+
+    params = {};
+    params.size_distribution = "empirical";
+    EXPECT_THROW(make_value_generator(params), std::invalid_argument);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "utils/version_distribution.hpp"
+#include <stdexcept>
+
+namespace {
+
+const VersionSpan kSpan{100000, 90000};   // initial load写到block 90000，测试期间写到100000
+
+}  // namespace
+
+TEST(VersionDistributionTest, UniformStaysWithinTestBlocks) {
+    auto distribution = make_version_distribution("uniform", {});
+    std::mt19937 rng(1);
+    for (int i = 0; i < 10000; ++i) {
+        uint64_t block = distribution->next(rng, kSpan);
+        EXPECT_GE(block, kSpan.test_start);
+        EXPECT_LE(block, kSpan.head);
+    }
+    // 尚未写入新block时退回到head
+    EXPECT_EQ(distribution->next(rng, VersionSpan{500, 1000}), 500u);
+}
+
+TEST(VersionDistributionTest, UniformAllCoversInitialLoad) {
+    auto distribution = make_version_distribution("uniform_all", {});
+    std::mt19937 rng(2);
+    size_t initial_load = 0;
+    for (int i = 0; i < 10000; ++i) {
+        initial_load += distribution->next(rng, kSpan) < kSpan.test_start ? 1 : 0;
+    }
+    EXPECT_NEAR(initial_load / 10000.0, 0.9, 0.02);
+}
+
+TEST(VersionDistributionTest, RecentWindowAndExponentialDecay) {
+    VersionDistributionParams params;
+    params.recent_window = 64;
+    params.decay_mean_blocks = 100.0;
+    std::mt19937 rng(3);
+
+    auto recent = make_version_distribution("recent", params);
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_GT(recent->next(rng, kSpan), kSpan.head - 64);
+    }
+    EXPECT_LE(recent->next(rng, VersionSpan{10, 0}), 10u);
+
+    auto exponential = make_version_distribution("exponential", params);
+    double age_sum = 0.0;
+    for (int i = 0; i < 100000; ++i) {
+        age_sum += static_cast<double>(kSpan.head - exponential->next(rng, kSpan));
+    }
+    // 截断取整后均值约为mean - 0.5
+    EXPECT_NEAR(age_sum / 100000, 99.5, 2.0);
+    EXPECT_LE(exponential->next(rng, VersionSpan{3, 0}), 3u);
+}
+
+TEST(VersionDistributionTest, MixtureRespectsWeights) {
+    VersionDistributionParams params;
+    params.recent_window = 16;
+    auto mixture = make_version_distribution("recent:0.75,uniform_all:0.25", params);
+    EXPECT_EQ(mixture->name(), "recent:0.75,uniform_all:0.25");
+    std::mt19937 rng(4);
+    size_t deep = 0;
+    for (int i = 0; i < 40000; ++i) {
+        deep += kSpan.head - mixture->next(rng, kSpan) >= 16 ? 1 : 0;
+    }
+    EXPECT_NEAR(deep / 40000.0, 0.25, 0.02);
+}
+
+TEST(VersionDistributionTest, InvalidSpecsThrow) {
+    EXPECT_THROW(make_version_distribution("archive", {}), std::invalid_argument);
+    EXPECT_THROW(make_version_distribution("recent:abc", {}), std::invalid_argument);
+    EXPECT_THROW(make_version_distribution("recent:0,uniform:1", {}), std::invalid_argument);
+    EXPECT_THROW(make_version_distribution("recent:0.5,", {}), std::invalid_argument);
+}
+
+TEST(VersionDistributionTest, AgeBuckets) {
+    EXPECT_EQ(version_age_bucket(0), 0u);
+    EXPECT_EQ(version_age_bucket(15), 0u);
+    EXPECT_EQ(version_age_bucket(16), 1u);
+    EXPECT_EQ(version_age_bucket(127), 1u);
+    EXPECT_EQ(version_age_bucket(128), 2u);
+    EXPECT_EQ(version_age_bucket(16383), 3u);
+    EXPECT_EQ(version_age_bucket(1ULL << 40), 4u);
+    EXPECT_EQ(version_age_bucket_labels()[2], "128-1023");
+}
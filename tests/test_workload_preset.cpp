@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "benchmark/workload_preset.hpp"
+#include "utils/key_distribution.hpp"
+#include "utils/version_distribution.hpp"
+#include <stdexcept>
+
+TEST(WorkloadPresetTest, PresetsUseKnownDistributions) {
+    const auto& presets = workload_presets();
+    ASSERT_EQ(presets.size(), 6u);
+    for (const auto& preset : presets) {
+        EXPECT_TRUE(is_key_distribution_name(preset.write_distribution)) << preset.name;
+        EXPECT_TRUE(is_key_distribution_name(preset.read_distribution)) << preset.name;
+        EXPECT_NO_THROW(make_version_distribution(preset.version_distribution, {})) << preset.name;
+        EXPECT_EQ(find_workload_preset(preset.name), &preset);
+        EXPECT_GT(preset.block_size, 0u);
+        EXPECT_FALSE(preset.mix.describe().empty());
+    }
+    EXPECT_EQ(find_workload_preset("W-Z"), nullptr);
+}
+
+TEST(WorkloadPresetTest, MixFollowsWeights) {
+    ReadOperationMix mix;
+    mix.weights = {0.0, 0.9, 0.0, 0.1};
+    std::mt19937 rng(1);
+    size_t latest = 0;
+    for (int i = 0; i < 20000; ++i) {
+        ReadOperation op = mix.pick(rng);
+        ASSERT_TRUE(op == ReadOperation::kLatest || op == ReadOperation::kAbsent);
+        latest += op == ReadOperation::kLatest ? 1 : 0;
+    }
+    EXPECT_NEAR(latest / 20000.0, 0.9, 0.01);
+    EXPECT_DOUBLE_EQ(mix.share(ReadOperation::kAbsent), 0.1);
+    EXPECT_EQ(mix.describe(), "latest 90%, absent 10%");
+
+    // 默认只有历史版本点查
+    ReadOperationMix historical;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(historical.pick(rng), ReadOperation::kHistorical);
+    }
+}
+
+TEST(WorkloadPresetTest, ParseSuite) {
+    EXPECT_EQ(parse_workload_suite("all").size(), workload_presets().size());
+    auto names = parse_workload_suite("W-E,W-A");
+    ASSERT_EQ(names.size(), 2u);
+    EXPECT_EQ(names[0], "W-E");
+    EXPECT_EQ(names[1], "W-A");
+    EXPECT_THROW(parse_workload_suite(""), std::invalid_argument);
+    EXPECT_THROW(parse_workload_suite("W-A,"), std::invalid_argument);
+    EXPECT_THROW(parse_workload_suite("ycsb-a"), std::invalid_argument);
+}
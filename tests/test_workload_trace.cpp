@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "benchmark/workload_trace.hpp"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+std::string temp_trace_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<DataRecord> make_block(BlockNum block_num, size_t count) {
+    std::vector<DataRecord> records;
+    for (size_t i = 0; i < count; ++i) {
+        records.push_back({block_num, "0xaddr" + std::to_string(i) + "#slot" + std::to_string(i),
+                           std::string(32, static_cast<char>('a' + i % 26))});
+    }
+    return records;
+}
+
+}  // namespace
+
+TEST(WorkloadTraceTest, RoundTripPreservesEventsInOrder) {
+    auto path = temp_trace_path("test_workload_trace_roundtrip.trace");
+    auto origin = std::chrono::steady_clock::now();
+    {
+        TraceWriter writer(path);
+        ASSERT_TRUE(writer.is_open());
+        writer.record_block(TraceEventType::kInitialLoadBlock, 0, make_block(0, 3), origin);
+        writer.record_block(TraceEventType::kWriteBlock, 7, make_block(7, 2), origin + std::chrono::milliseconds(5));
+        writer.record_query("0xaddr1#slot1", 6, origin + std::chrono::milliseconds(6));
+        EXPECT_EQ(writer.events_written(), 3u);
+    }
+
+    TraceReader reader(path);
+    ASSERT_TRUE(reader.is_open());
+    TraceEvent event;
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.type, TraceEventType::kInitialLoadBlock);
+    EXPECT_EQ(event.block_num, 0u);
+    ASSERT_EQ(event.records.size(), 3u);
+    EXPECT_EQ(event.records[2].addr_slot, "0xaddr2#slot2");
+    EXPECT_EQ(event.records[2].value, std::string(32, 'c'));
+
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.type, TraceEventType::kWriteBlock);
+    EXPECT_EQ(event.block_num, 7u);
+    ASSERT_EQ(event.records.size(), 2u);
+    EXPECT_EQ(event.records[1].block_num, 7u);
+
+    int64_t write_ns = event.timestamp_ns;
+    ASSERT_TRUE(reader.next(event));
+    EXPECT_EQ(event.type, TraceEventType::kQuery);
+    EXPECT_EQ(event.key, "0xaddr1#slot1");
+    EXPECT_EQ(event.block_num, 6u);
+    EXPECT_TRUE(event.records.empty());
+    EXPECT_NEAR(static_cast<double>(event.timestamp_ns - write_ns), 1e6, 1e3);
+
+    EXPECT_FALSE(reader.next(event));
+    EXPECT_FALSE(reader.truncated());
+    EXPECT_EQ(reader.events_read(), 3u);
+    std::filesystem::remove(path);
+}
+
+TEST(WorkloadTraceTest, TruncatedTraceIsReported) {
+    auto path = temp_trace_path("test_workload_trace_truncated.trace");
+    {
+        TraceWriter writer(path);
+        writer.record_block(TraceEventType::kWriteBlock, 1, make_block(1, 10), std::chrono::steady_clock::now());
+        writer.record_query("key", 1, std::chrono::steady_clock::now());
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+
+    TraceReader reader(path);
+    ASSERT_TRUE(reader.is_open());
+    TraceEvent event;
+    EXPECT_TRUE(reader.next(event));
+    EXPECT_FALSE(reader.next(event));
+    EXPECT_TRUE(reader.truncated());
+    std::filesystem::remove(path);
+}
+
+TEST(WorkloadTraceTest, RejectsFilesWithoutHeader) {
+    auto path = temp_trace_path("test_workload_trace_bad_magic.trace");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a trace file";
+    }
+    TraceReader reader(path);
+    EXPECT_FALSE(reader.is_open());
+    TraceEvent event;
+    EXPECT_FALSE(reader.next(event));
+    std::filesystem::remove(path);
+
+    TraceReader missing(temp_trace_path("test_workload_trace_missing.trace"));
+    EXPECT_FALSE(missing.is_open());
+}